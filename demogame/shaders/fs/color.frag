@@ -1,4 +1,7 @@
-uniform vec4 mainColor;
+uniform MaterialBlock
+{
+	vec4 mainColor;
+};
 
 out vec4 color;
 
@@ -1,7 +1,12 @@
 
 uniform sampler2DArray diffuseTexture;
 
-uniform uint animDelay;
+// has to be identical in every stage of the program
+uniform MaterialBlock
+{
+	float scale;
+	uint animDelay;
+};
 
 in vec2 UV;
 flat in int textureIndexOffset;
@@ -1,11 +1,14 @@
 uniform sampler2D diffuseTexture;
 
-uniform vec2 radialSize;    // texel size
+uniform MaterialBlock
+{
+	vec2 radialSize;    // texel size
 
-uniform float radialBlur;   // blur factor
-uniform float radialBright; // bright factor
+	float radialBlur;   // blur factor
+	float radialBright; // bright factor
 
-uniform vec2 radialOrigin;  // blur origin
+	vec2 radialOrigin;  // blur origin
+};
 
 in vec2 UV;
 
@@ -1,4 +1,22 @@
+#if defined( ANIMATED )
+uniform sampler2DArray diffuseTexture;
+
+uniform MaterialBlock
+{
+	uint animDelay;
+};
+#elif defined( ATLAS )
+uniform sampler2DArray diffuseTexture;
+
+uniform MaterialBlock
+{
+	// xy scales and zw offsets the UVs into the rectangle of the entry
+	vec4 atlasTransform;
+	uint atlasLayer;
+};
+#else
 uniform sampler2D diffuseTexture;
+#endif
 
 in vec2 UV;
 
@@ -6,5 +24,13 @@ out vec4 color;
 
 void main()
 {
+#if defined( ANIMATED )
+	int layerCount = textureSize( diffuseTexture, 0 ).z;
+
+	color = texture( diffuseTexture, vec3( UV.x, UV.y, int( Timer.time / animDelay ) % layerCount ) ).rgba;
+#elif defined( ATLAS )
+	color = texture( diffuseTexture, vec3( UV * atlasTransform.xy + atlasTransform.zw, atlasLayer ) );
+#else
 	color = texture( diffuseTexture, UV );
+#endif
 }
@@ -1,6 +1,9 @@
-uniform float bgRadsPerSecond;
+uniform MaterialBlock
+{
+	float bgRadsPerSecond;
 
-uniform vec2 bgScale;
+	vec2 bgScale;
+};
 
 out vec2 UV;
 
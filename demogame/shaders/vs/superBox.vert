@@ -1,7 +1,10 @@
-uniform float bgRadsPerSecond;
-uniform float fgRadsPerSecond;
+uniform MaterialBlock
+{
+	float bgRadsPerSecond;
+	float fgRadsPerSecond;
 
-uniform vec2 bgScale;
+	vec2 bgScale;
+};
 
 out vec3 Normal;
 out vec3 Position;
@@ -1,4 +1,7 @@
-uniform float waitRadsPerSecond;
+uniform MaterialBlock
+{
+	float waitRadsPerSecond;
+};
 
 out vec2 UVskull;
 out vec2 UVwait;
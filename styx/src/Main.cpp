@@ -1,4 +1,5 @@
 #include <iostream>
+#include <algorithm>
 
 // explicitly include SDL2.h so it can do its thing with SDL_main
 #ifdef __linux__
@@ -17,7 +18,15 @@
 
 #include "src/system/ComputerInfo.hpp"
 #include "src/system/CEngine.hpp"
+#include "src/system/CGameInfo.hpp"
+#include "src/system/CFileSystem.hpp"
+#include "src/system/AssetCooker.hpp"
 
+#include "src/renderer/texture/TextureDecodeBenchmark.hpp"
+
+#include "src/helper/image/ImageKernelsBenchmark.hpp"
+
+#include "src/core/FileExtension.hpp"
 #include "src/core/StyxException.hpp"
 
 int main( int argc, char *argv[] )
@@ -41,6 +50,12 @@ int main( int argc, char *argv[] )
 
 	const auto showVersionOption = app.add_flag( "-v", "produce version string" );
 
+	const auto benchmarkTexturesOption = app.add_flag( "-b", "benchmark the decoding of the cubemaps and array textures of the game and exit" );
+
+	const auto benchmarkImageKernelsOption = app.add_flag( "-k", "benchmark the image kernels against the stb paths and exit" );
+
+	const auto cookAssetsOption = app.add_flag( "-c", "cook the assets of the game into a pack in the directory of the game and exit" );
+
 	try
 	{
 		app.parse( argc, argv );
@@ -80,9 +95,40 @@ int main( int argc, char *argv[] )
 
 	try
 	{
-		CEngine engine( argv[ 0 ], gameDirectoryString, settingsFile );
-
-		engine.Run();
+		if( benchmarkTexturesOption->count() > 0 )
+		{
+			const CGameInfo gameInfo( gameDirectoryString );
+
+			const CFileSystem filesystem( argv[ 0 ], gameInfo.GetOrganisation(), gameInfo.GetShortName(), gameInfo.GetPath(), gameInfo.GetAssets() );
+
+			TextureDecodeBenchmark::Run( filesystem, "textures", static_cast<u8>( std::clamp( ComputerInfo::ProcessorCount(), 1, 255 ) ) );
+		}
+		else if( benchmarkImageKernelsOption->count() > 0 )
+		{
+			ImageKernelsBenchmark::Run();
+		}
+		else if( cookAssetsOption->count() > 0 )
+		{
+			const CGameInfo gameInfo( gameDirectoryString );
+
+			// an already cooked pack would hide the files it was cooked from
+			std::vector<std::string> assets;
+
+			std::copy_if( std::cbegin( gameInfo.GetAssets() ), std::cend( gameInfo.GetAssets() ), std::back_inserter( assets ), []( const std::string &asset ) { return( fs::path( asset ).extension() != FileExtension::AssetPack::pack ); } );
+
+			const CFileSystem filesystem( argv[ 0 ], gameInfo.GetOrganisation(), gameInfo.GetShortName(), gameInfo.GetPath(), assets );
+
+			if( !AssetCooker::Cook( filesystem, gameInfo.GetPath() / ( gameInfo.GetShortName() + FileExtension::AssetPack::pack ) ) )
+			{
+				return( EXIT_FAILURE );
+			}
+		}
+		else
+		{
+			CEngine engine( argv[ 0 ], gameDirectoryString, settingsFile );
+
+			engine.Run();
+		}
 	}
 	catch( const styx_internal::StyxException &e )
 	{
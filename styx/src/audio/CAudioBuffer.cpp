@@ -18,6 +18,16 @@ f16 CAudioBuffer::Duration() const
 	return( m_duration );
 }
 
+u64 CAudioBuffer::Size() const
+{
+	return( m_size );
+}
+
+SMemoryUsage CAudioBuffer::MemoryUsage() const
+{
+	return( SMemoryUsage { sizeof( CAudioBuffer ), m_size } );
+}
+
 void CAudioBuffer::Reset()
 {
 	if( alIsBuffer( m_bufferID ) )
@@ -26,4 +36,6 @@ void CAudioBuffer::Reset()
 	}
 
 	m_bufferID = 0;
+	m_duration = 0.0f;
+	m_size = 0;
 }
@@ -4,6 +4,7 @@
 #include <AL/alc.h>
 
 #include "src/core/Types.hpp"
+#include "src/core/SMemoryUsage.hpp"
 
 class CAudioBuffer final
 {
@@ -27,11 +28,18 @@ public:
 	format Format() const;
 	f16 Duration() const;
 
+	// of the samples in the OpenAL buffer
+	u64 Size() const;
+
+	// the samples live in the memory of the audio device
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 	void Reset();
 
 private:
-	ALuint m_bufferID;
+	ALuint m_bufferID { 0 };
 
-	format	m_format;
+	format	m_format { format::MONO };
 	f16		m_duration = 0.0f;
+	u64		m_size = 0;
 };
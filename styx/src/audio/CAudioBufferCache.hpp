@@ -19,5 +19,17 @@ public:
 		m_audioBufferLoader.FromFile( resource, id );
 	};
 
+	void LoadPlaceholder( const std::shared_ptr<CAudioBuffer> &resource, [[maybe_unused]] const std::string &id ) const override
+	{
+		m_audioBufferLoader.FromPlaceholder( resource );
+	}
+
+	TFinisher Decode( const std::string &id ) const override
+	{
+		const std::shared_ptr<const CAudioBufferLoader::SDecodedAudio> decodedAudio = m_audioBufferLoader.Decode( id );
+
+		return( [ this, id, decodedAudio ]( const std::shared_ptr<CAudioBuffer> &resource ) { m_audioBufferLoader.FromDecoded( resource, id, decodedAudio.get() ); } );
+	}
+
 	const CAudioBufferLoader m_audioBufferLoader;
 };
@@ -26,6 +26,32 @@ CAudioBufferLoader::~CAudioBufferLoader()
 }
 
 void CAudioBufferLoader::FromFile( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path ) const
+{
+	FromDecoded( audioBuffer, path, Decode( path ).get() );
+}
+
+std::unique_ptr<const CAudioBufferLoader::SDecodedAudio> CAudioBufferLoader::Decode( const fs::path &path ) const
+{
+	if( !path.has_filename() || !m_filesystem.Exists( path ) )
+	{
+		return( nullptr );
+	}
+
+	const std::string fileExtensionString = path.extension().generic_string();
+
+	if( fileExtensionString == FileExtension::Audio::ogg )
+	{
+		return( DecodeOggFile( path ) );
+	}
+	else if( fileExtensionString == FileExtension::Audio::wav )
+	{
+		return( DecodeWavFile( path ) );
+	}
+
+	return( nullptr );
+}
+
+void CAudioBufferLoader::FromDecoded( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path, const SDecodedAudio *decodedAudio ) const
 {
 	if( !path.has_filename() )
 	{
@@ -48,97 +74,118 @@ void CAudioBufferLoader::FromFile( const std::shared_ptr<CAudioBuffer> &audioBuf
 		logWARNING( "audio file '{0}' does not exist", path.generic_string() );
 		FromDummy( audioBuffer );
 	}
+	else if( nullptr == decodedAudio )
+	{
+		FromDummy( audioBuffer );
+	}
 	else
 	{
-		if( fileExtensionString == FileExtension::Audio::ogg )
-		{
-			if( !FromOggFile( audioBuffer, path ) )
-			{
-				FromDummy( audioBuffer );
-			}
-		}
-		else if( fileExtensionString == FileExtension::Audio::wav )
-		{
-			if( !FromWavFile( audioBuffer, path ) )
-			{
-				FromDummy( audioBuffer );
-			}
-		}
+		FromPCM16( audioBuffer, decodedAudio->format, decodedAudio->sampleRate, decodedAudio->duration, decodedAudio->samples, decodedAudio->byteCount );
 	}
 }
 
-bool CAudioBufferLoader::FromOggFile( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path ) const
+std::unique_ptr<const CAudioBufferLoader::SDecodedAudio> CAudioBufferLoader::DecodeOggFile( const fs::path &path ) const
 {
-	auto const fileBuffer = m_filesystem.LoadFileToBuffer( path );
+	const CFileView file = m_filesystem.MapFile( path );
 
-	if( !fileBuffer.empty() )
+	if( !file.Empty() )
 	{
 		s32 errorCode;
 
-		stb_vorbis *stream = stb_vorbis_open_memory( reinterpret_cast<const unsigned char*>( fileBuffer.data() ), fileBuffer.size(), &errorCode, nullptr );
+		stb_vorbis *stream = stb_vorbis_open_memory( reinterpret_cast<const unsigned char*>( file.Data() ), static_cast<int>( file.Size() ), &errorCode, nullptr );
 
 		if( nullptr == stream )
 		{
 			logWARNING( "not possible to open stream for ogg file '{0}': error code {1}", path.generic_string(), errorCode );
-			return( false );
+			return( nullptr );
 		}
 		else
 		{
 			const stb_vorbis_info info = stb_vorbis_get_info( stream );
 
-			const u32 lengthSamples = stb_vorbis_stream_length_in_samples( stream ) * info.channels * sizeof( s16 );
+			// one short per sample and channel
+			const u32 sampleCount = stb_vorbis_stream_length_in_samples( stream ) * info.channels;
 
-			TAudioData bufferDecoded;
-			bufferDecoded.buffer.resize( lengthSamples );
+			auto decodedAudio = std::make_unique<SDecodedAudio>();
+			decodedAudio->buffer.resize( sampleCount );
 
-			if( 0 == stb_vorbis_get_samples_short_interleaved( stream, info.channels, &bufferDecoded.buffer[ 0 ], lengthSamples ) )
+			if( 0 == stb_vorbis_get_samples_short_interleaved( stream, info.channels, decodedAudio->buffer.data(), sampleCount ) )
 			{
 				logWARNING( "not possible to read samples from ogg file '{0}'", path.generic_string() );
-				return( false );
+				stb_vorbis_close( stream );
+				return( nullptr );
 			}
 
-			bufferDecoded.duration = stb_vorbis_stream_length_in_seconds( stream );
+			decodedAudio->duration = stb_vorbis_stream_length_in_seconds( stream );
 
 			stb_vorbis_close( stream );
 
-			bufferDecoded.format = ( 1 == info.channels ) ? CAudioBuffer::format::MONO : CAudioBuffer::format::STEREO;
-			bufferDecoded.sample_rate = info.sample_rate;
+			decodedAudio->format = ( 1 == info.channels ) ? CAudioBuffer::format::MONO : CAudioBuffer::format::STEREO;
+			decodedAudio->sampleRate = info.sample_rate;
 
-			logDEBUG( "{0} / duration: {1:.0f}s / channels: {2} / sample rate: {3}", path.generic_string(), bufferDecoded.duration, info.channels, bufferDecoded.sample_rate );
+			decodedAudio->samples = decodedAudio->buffer.data();
+			decodedAudio->byteCount = decodedAudio->buffer.size() * sizeof( s16 );
 
-			FromTAudioData( audioBuffer, bufferDecoded );
+			logDEBUG( "{0} / duration: {1:.0f}s / channels: {2} / sample rate: {3}", path.generic_string(), decodedAudio->duration, info.channels, decodedAudio->sampleRate );
 
-			return( true );
+			return( decodedAudio );
 		}
 	}
 	else
 	{
 		logWARNING( "failed to load ogg file '{0}'", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 }
 
-bool CAudioBufferLoader::FromWavFile( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path ) const
+std::unique_ptr<const CAudioBufferLoader::SDecodedAudio> CAudioBufferLoader::DecodeWavFile( const fs::path &path ) const
 {
-	auto const fileBuffer = m_filesystem.LoadFileToBuffer( path );
+	CFileView file = m_filesystem.MapFile( path );
 
-	if( !fileBuffer.empty() )
+	if( !file.Empty() )
 	{
 		drwav wav;
-		if( !drwav_init_memory( &wav, fileBuffer.data(), fileBuffer.size() ) )
+		if( !drwav_init_memory( &wav, file.Data(), file.Size() ) )
 		{
 			logWARNING( "error opening wav file: {0}", path.generic_string() );
-			return( false );
+			return( nullptr );
 		}
 
-		TAudioData bufferDecoded;
-		bufferDecoded.buffer.resize( static_cast<size_t>( wav.totalPCMFrameCount * sizeof( s16 ) ) );
+		auto decodedAudio = std::make_unique<SDecodedAudio>();
+
+		decodedAudio->duration = static_cast<f16>( wav.totalPCMFrameCount ) / static_cast<f16>( wav.sampleRate );
+		decodedAudio->format = ( 1 == wav.channels ) ? CAudioBuffer::format::MONO : CAudioBuffer::format::STEREO;
+		decodedAudio->sampleRate = wav.sampleRate;
+
+		// one short per sample and channel
+		const size_t sampleCount = static_cast<size_t>( wav.totalPCMFrameCount * wav.channels );
+		const size_t byteCount = sampleCount * sizeof( s16 );
+
+		logDEBUG( "{0} / duration: {1:.0f}s / channels: {2} / sample rate: {3}", path.generic_string(), decodedAudio->duration, wav.channels, wav.sampleRate );
+
+		if(	( DR_WAVE_FORMAT_PCM == wav.translatedFormatTag )
+			&&
+			( 16 == wav.bitsPerSample )
+			&&
+			( byteCount <= wav.dataChunkDataSize )
+			&&
+			( wav.dataChunkDataPos + byteCount <= file.Size() ) )
+		{
+			// this is already the format OpenAL takes, so the samples go straight from the file into the buffer
+			decodedAudio->samples = file.Data() + wav.dataChunkDataPos;
+			decodedAudio->byteCount = byteCount;
+
+			drwav_uninit( &wav );
+
+			// the mapping moves along with the view, so the samples stay where they are
+			decodedAudio->file = std::move( file );
+
+			return( decodedAudio );
+		}
 
-		bufferDecoded.duration = static_cast<f16>( wav.totalPCMFrameCount ) / static_cast<f16>( wav.sampleRate );
-		bufferDecoded.format = ( 1 == wav.channels ) ? CAudioBuffer::format::MONO : CAudioBuffer::format::STEREO;
-		bufferDecoded.sample_rate = wav.sampleRate;
+		decodedAudio->buffer.resize( sampleCount );
 
-		const auto numberOfPCMFramesActuallyDecoded = drwav_read_pcm_frames_s16( &wav, wav.totalPCMFrameCount, &bufferDecoded.buffer[ 0 ] );
+		const auto numberOfPCMFramesActuallyDecoded = drwav_read_pcm_frames_s16( &wav, wav.totalPCMFrameCount, decodedAudio->buffer.data() );
 
 		if( numberOfPCMFramesActuallyDecoded < wav.totalPCMFrameCount )
 		{
@@ -147,27 +194,33 @@ bool CAudioBufferLoader::FromWavFile( const std::shared_ptr<CAudioBuffer> &audio
 
 		drwav_uninit( &wav );
 
-		logDEBUG( "{0} / duration: {1:.0f}s / channels: {2} / sample rate: {3}", path.generic_string(), bufferDecoded.duration, wav.channels, bufferDecoded.sample_rate );
+		decodedAudio->samples = decodedAudio->buffer.data();
+		decodedAudio->byteCount = decodedAudio->buffer.size() * sizeof( s16 );
 
-		FromTAudioData( audioBuffer, bufferDecoded );
-
-		return( true );
+		return( decodedAudio );
 	}
 	else
 	{
 		logWARNING( "failed to load wav file '{0}'", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 }
 
-void CAudioBufferLoader::FromTAudioData( const std::shared_ptr<CAudioBuffer> &audioBuffer, const TAudioData &audioData ) const
+void CAudioBufferLoader::FromPCM16( const std::shared_ptr<CAudioBuffer> &audioBuffer, const CAudioBuffer::format format, const u32 sampleRate, const f16 duration, const void *samples, const size_t byteCount ) const
 {
-	audioBuffer->m_duration = audioData.duration;
-	audioBuffer->m_format = audioData.format;
+	audioBuffer->m_duration = duration;
+	audioBuffer->m_format = format;
+	audioBuffer->m_size = byteCount;
 
 	alGenBuffers( 1, &audioBuffer->m_bufferID );
 
-	alBufferData( audioBuffer->m_bufferID, ( audioData.format == CAudioBuffer::format::MONO ) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16, audioData.buffer.data(), static_cast<ALsizei>( audioData.buffer.size() ), audioData.sample_rate );
+	// OpenAL copies the samples, so they don't have to outlive this call
+	alBufferData( audioBuffer->m_bufferID, ( format == CAudioBuffer::format::MONO ) ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16, samples, static_cast<ALsizei>( byteCount ), sampleRate );
+}
+
+void CAudioBufferLoader::FromPlaceholder( const std::shared_ptr<CAudioBuffer> &audioBuffer ) const
+{
+	audioBuffer->Reset();
 }
 
 void CAudioBufferLoader::FromDummy( const std::shared_ptr<CAudioBuffer> &audioBuffer ) const
@@ -175,21 +228,19 @@ void CAudioBufferLoader::FromDummy( const std::shared_ptr<CAudioBuffer> &audioBu
 	audioBuffer->Reset();
 	
 	// create 10 sec sine wave of random frequency
-		
-	TAudioData data;
-	data.duration = 10.0f;
-	data.format = CAudioBuffer::format::MONO;
-	data.sample_rate = 22050;
+	const f16 duration = 10.0f;
+	const u32 sampleRate = 22050;
 	
-	data.buffer.resize( data.duration * data.sample_rate * 2 );
+	// one short per sample
+	std::vector<s16> buffer( static_cast<size_t>( duration * sampleRate ) );
 
 	// Fill buffer with random sine wave
 	const double freq = effolkronium::random_static::get<f16>( 300.0f, 600.0f );
 	
-    for( size_t i = 0; i < data.buffer.size(); ++i )
+    for( size_t i = 0; i < buffer.size(); ++i )
 	{
-		data.buffer[ i ] = 32767 * sin( ( glm::two_pi<f16>() * freq ) / data.sample_rate * i  );
+		buffer[ i ] = 32767 * sin( ( glm::two_pi<f16>() * freq ) / sampleRate * i  );
     }
 	
-	FromTAudioData( audioBuffer, data );
+	FromPCM16( audioBuffer, CAudioBuffer::format::MONO, sampleRate, duration, buffer.data(), buffer.size() * sizeof( s16 ) );
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "src/core/Types.hpp"
 
@@ -16,22 +17,37 @@ public:
 
 	void FromFile( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path ) const;
 
-private:
-	using TAudioData = struct
+	// interleaved signed 16 bit samples, which either point into the mapped file or into the decoded buffer
+	struct SDecodedAudio final
 	{
-		std::vector<s16>		buffer;
 		CAudioBuffer::format	format;
-		u32						sample_rate = 0;
+		u32						sampleRate = 0;
 		f16						duration = 0.0f;
+
+		CFileView			file;
+		std::vector<s16>	buffer;
+
+		const void	*samples = nullptr;
+		size_t		byteCount = 0;
 	};
 
+	// the thread safe part of FromFile, nullptr if the file couldn't be decoded
+	[[nodiscard]] std::unique_ptr<const SDecodedAudio> Decode( const fs::path &path ) const;
+
+	// hands the samples which were decoded by Decode over to OpenAL
+	void FromDecoded( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path, const SDecodedAudio *decodedAudio ) const;
+
+	// a buffer without any samples, so nothing is heard until the file is loaded
+	void FromPlaceholder( const std::shared_ptr<CAudioBuffer> &audioBuffer ) const;
+
 private:
 	const CFileSystem &m_filesystem;
 
-	bool FromOggFile( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path ) const;
-	bool FromWavFile( const std::shared_ptr<CAudioBuffer> &audioBuffer, const fs::path &path ) const;
+	std::unique_ptr<const SDecodedAudio> DecodeOggFile( const fs::path &path ) const;
+	std::unique_ptr<const SDecodedAudio> DecodeWavFile( const fs::path &path ) const;
 
 	void FromDummy( const std::shared_ptr<CAudioBuffer> &audioBuffer ) const;
 
-	void FromTAudioData( const std::shared_ptr<CAudioBuffer> &audioBuffer, const TAudioData &audioData ) const;
+	// interleaved signed 16 bit samples
+	void FromPCM16( const std::shared_ptr<CAudioBuffer> &audioBuffer, const CAudioBuffer::format format, const u32 sampleRate, const f16 duration, const void *samples, const size_t byteCount ) const;
 };
@@ -20,7 +20,9 @@ void CAudioSource::SetAudioBuffer( const std::shared_ptr<const CAudioBuffer> &au
 {
 	m_audioBuffer = audioBuffer;
 
-	alSourcei( m_sourceID, AL_BUFFER, audioBuffer->m_bufferID );
+	m_attachedBufferID = audioBuffer->m_bufferID;
+
+	alSourcei( m_sourceID, AL_BUFFER, m_attachedBufferID );
 }
 
 const std::shared_ptr<const CAudioBuffer> CAudioSource::Buffer() const
@@ -45,6 +47,16 @@ void CAudioSource::SetRelativePositioning( const bool value ) const
 
 void CAudioSource::Play() const
 {
+	if( m_attachedBufferID != m_audioBuffer->m_bufferID )
+	{
+		// the buffer of a source can only be changed while it is stopped
+		alSourceStop( m_sourceID );
+
+		m_attachedBufferID = m_audioBuffer->m_bufferID;
+
+		alSourcei( m_sourceID, AL_BUFFER, m_attachedBufferID );
+	}
+
 	alSourcePlay( m_sourceID );
 }
 
@@ -34,5 +34,8 @@ public:
 private:
 	std::shared_ptr<const CAudioBuffer> m_audioBuffer;
 
+	// the buffer gets a new name when it is loaded asynchronously or reloaded, so it is attached again before playing
+	mutable ALuint m_attachedBufferID { 0 };
+
 	ALuint m_sourceID;
 };
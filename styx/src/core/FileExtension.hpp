@@ -31,4 +31,9 @@ namespace FileExtension
 	{
 		static const std::string ttf = ".ttf";
 	}
+
+	namespace AssetPack
+	{
+		static const std::string pack = ".styxpack";
+	}
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "src/core/Types.hpp"
+
+/**
+ * What something occupies in bytes, in main memory and in the memory of the GPU or the audio device.
+ * The sizes are estimated from what was handed to the driver, it may need more.
+ */
+struct SMemoryUsage final
+{
+	u64 cpu { 0 };
+	u64 gpu { 0 };
+
+	[[nodiscard]] u64 Total() const
+	{
+		return( cpu + gpu );
+	}
+
+	SMemoryUsage &operator += ( const SMemoryUsage &rhs )
+	{
+		cpu += rhs.cpu;
+		gpu += rhs.gpu;
+
+		return( *this );
+	}
+};
\ No newline at end of file
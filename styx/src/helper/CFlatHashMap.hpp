@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "src/core/Types.hpp"
+
+/**
+ * Open addressing hash map for keys which already are well distributed hashes, like resource ids.
+ * Linear probing keeps a lookup within a few neighbouring slots and erasing shifts the following entries back, so no tombstones pile up.
+ * Pointers to values are invalidated by every insertion and erasure.
+ */
+template<typename T>
+class CFlatHashMap final
+{
+public:
+	[[nodiscard]] T *Find( const u64 key )
+	{
+		const size_t index = FindSlot( key );
+
+		return( ( index < m_slots.size() ) ? &m_slots[ index ].value : nullptr );
+	}
+
+	[[nodiscard]] const T *Find( const u64 key ) const
+	{
+		const size_t index = FindSlot( key );
+
+		return( ( index < m_slots.size() ) ? &m_slots[ index ].value : nullptr );
+	}
+
+	// inserts a default constructed value if there is none for the key
+	T &operator[]( const u64 key )
+	{
+		if( const size_t index = FindSlot( key ); index < m_slots.size() )
+		{
+			return( m_slots[ index ].value );
+		}
+
+		// the load factor is kept below 3/4, so the probe sequences stay short
+		if( ( m_size + 1 ) * 4 > m_slots.size() * 3 )
+		{
+			Grow();
+		}
+
+		SSlot &slot = m_slots[ FreeSlot( key ) ];
+
+		slot.key	= key;
+		slot.used	= true;
+
+		m_size++;
+
+		return( slot.value );
+	}
+
+	bool Erase( const u64 key )
+	{
+		const size_t index = FindSlot( key );
+
+		if( index >= m_slots.size() )
+		{
+			return( false );
+		}
+
+		EraseSlot( index );
+
+		return( true );
+	}
+
+	// the predicate gets the key and the value, it may be called more than once for a value it keeps
+	template<typename Predicate>
+	void EraseIf( Predicate predicate )
+	{
+		for( size_t index = 0; index < m_slots.size(); )
+		{
+			// a following entry may have been shifted into the erased slot, so the slot is looked at again
+			if( m_slots[ index ].used && predicate( m_slots[ index ].key, m_slots[ index ].value ) )
+			{
+				EraseSlot( index );
+			}
+			else
+			{
+				++index;
+			}
+		}
+	}
+
+	template<typename Function>
+	void ForEach( Function function )
+	{
+		for( auto &slot : m_slots )
+		{
+			if( slot.used )
+			{
+				function( slot.key, slot.value );
+			}
+		}
+	}
+
+	template<typename Function>
+	void ForEach( Function function ) const
+	{
+		for( const auto &slot : m_slots )
+		{
+			if( slot.used )
+			{
+				function( slot.key, slot.value );
+			}
+		}
+	}
+
+	/**	Visits the entries in at most count slots beginning with the first one and returns the slot to continue with, 0 after the last one.
+		Walking the slots in slices spreads a pass over the map across calls, entries which got moved in between may be visited twice or not at all.
+	*/
+	template<typename Function>
+	size_t ForEachInSlots( const size_t first, const size_t count, Function function )
+	{
+		const size_t last = std::min( first + count, m_slots.size() );
+
+		for( size_t index = first; index < last; ++index )
+		{
+			if( m_slots[ index ].used )
+			{
+				function( m_slots[ index ].key, m_slots[ index ].value );
+			}
+		}
+
+		return( ( last < m_slots.size() ) ? last : 0 );
+	}
+
+	[[nodiscard]] size_t Size() const
+	{
+		return( m_size );
+	}
+
+	[[nodiscard]] bool Empty() const
+	{
+		return( 0 == m_size );
+	}
+
+	void Clear()
+	{
+		m_slots.clear();
+		m_size = 0;
+	}
+
+private:
+	struct SSlot final
+	{
+		u64		key		{ 0 };
+		bool	used	{ false };
+		T		value	{};
+	};
+
+	std::vector<SSlot>	m_slots;
+	size_t				m_size { 0 };
+
+	// the capacity is always a power of two, so the low bits of the mixed key select the home slot
+	size_t Mask() const
+	{
+		return( m_slots.size() - 1 );
+	}
+
+	// the finalizer of MurmurHash3, the low bits of FNV-1a hardly differ for paths which only differ in their last characters
+	static u64 Mix( u64 key )
+	{
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		key *= 0xc4ceb9fe1a85ec53ULL;
+		key ^= key >> 33;
+
+		return( key );
+	}
+
+	size_t HomeSlot( const u64 key ) const
+	{
+		return( Mix( key ) & Mask() );
+	}
+
+	size_t FindSlot( const u64 key ) const
+	{
+		if( m_slots.empty() )
+		{
+			return( m_slots.size() );
+		}
+
+		for( size_t index = HomeSlot( key ); m_slots[ index ].used; index = ( index + 1 ) & Mask() )
+		{
+			if( m_slots[ index ].key == key )
+			{
+				return( index );
+			}
+		}
+
+		return( m_slots.size() );
+	}
+
+	size_t FreeSlot( const u64 key ) const
+	{
+		size_t index = HomeSlot( key );
+
+		while( m_slots[ index ].used )
+		{
+			index = ( index + 1 ) & Mask();
+		}
+
+		return( index );
+	}
+
+	void EraseSlot( size_t hole )
+	{
+		// every following entry which could not be stored closer to its home slot because of the erased one is moved back
+		for( size_t next = ( hole + 1 ) & Mask(); m_slots[ next ].used; next = ( next + 1 ) & Mask() )
+		{
+			const size_t home = HomeSlot( m_slots[ next ].key );
+
+			if( ( ( next - home ) & Mask() ) >= ( ( next - hole ) & Mask() ) )
+			{
+				m_slots[ hole ] = std::move( m_slots[ next ] );
+
+				hole = next;
+			}
+		}
+
+		// the value is released right away and not when the slot gets used again
+		m_slots[ hole ] = SSlot {};
+
+		m_size--;
+	}
+
+	void Grow()
+	{
+		static const size_t minimumCapacity = 16;
+
+		std::vector<SSlot> slots( std::max( minimumCapacity, m_slots.size() * 2 ) );
+
+		std::swap( slots, m_slots );
+
+		for( auto &slot : slots )
+		{
+			if( slot.used )
+			{
+				m_slots[ FreeSlot( slot.key ) ] = std::move( slot );
+			}
+		}
+	}
+};
\ No newline at end of file
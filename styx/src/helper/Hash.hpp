@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string_view>
+
+#include "src/core/Types.hpp"
+
+namespace Hash
+{
+	constexpr u64 FNV1aOffsetBasis	{ 0xcbf29ce484222325 };
+	constexpr u64 FNV1aPrime		{ 0x100000001b3 };
+
+	// 64 bit FNV-1a, stable across runs and platforms so it can be used for anything persisted to disk
+	constexpr u64 FNV1a( const std::string_view data, const u64 seed = FNV1aOffsetBasis )
+	{
+		u64 hash = seed;
+
+		for( const char c : data )
+		{
+			hash ^= static_cast<u8>( c );
+			hash *= FNV1aPrime;
+		}
+
+		return( hash );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "Json.hpp"
+
+namespace Json
+{
+	nlohmann::json Load( const CFileSystem &filesystem, const fs::path &path )
+	{
+		const CFileView file = filesystem.MapFile( path );
+
+		const auto begin	= reinterpret_cast<const u8*>( file.Data() );
+		const auto end		= begin + file.Size();
+
+		if( AssetPack::EEntryKind::JSON == filesystem.EntryKind( path ) )
+		{
+			return( nlohmann::json::from_cbor( begin, end ) );
+		}
+
+		return( nlohmann::json::parse( begin, end ) );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "external/json/json.hpp"
+
+#include "src/system/CFileSystem.hpp"
+
+namespace Json
+{
+	// parses the text or reads the CBOR of a cooked file, throws nlohmann::json::parse_error in both cases
+	nlohmann::json Load( const CFileSystem &filesystem, const fs::path &path );
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "src/logger/CLogger.hpp"
+
+namespace BlockCompression
+{
+	using TPixels = std::array<std::array<u8, 4>, 16>;
+
+	// BC1 and the color part of BC3 store one byte of 2 bit indices per row
+	static void FlipColorBlock( u8 *block, const u8 rows )
+	{
+		std::reverse( block + 4, block + 4 + rows );
+	}
+
+	// BC4 and the alpha part of BC3 store 48 bits of 3 bit indices, so 12 bits per row
+	static void FlipAlphaBlock( u8 *block, const u8 rows )
+	{
+		u64 bits { 0 };
+		for( u8 i = 0; i < 6; i++ )
+		{
+			bits |= static_cast<u64>( block[ 2 + i ] ) << ( 8 * i );
+		}
+
+		std::array<u64, 4> lines;
+		for( u8 row = 0; row < 4; row++ )
+		{
+			lines[ row ] = ( bits >> ( 12 * row ) ) & 0xFFF;
+		}
+
+		std::reverse( std::begin( lines ), std::begin( lines ) + rows );
+
+		bits = 0;
+		for( u8 row = 0; row < 4; row++ )
+		{
+			bits |= lines[ row ] << ( 12 * row );
+		}
+
+		for( u8 i = 0; i < 6; i++ )
+		{
+			block[ 2 + i ] = static_cast<u8>( bits >> ( 8 * i ) );
+		}
+	}
+
+	static std::array<u8, 4> ExpandRGB565( const u16 color )
+	{
+		const u16 r = ( color >> 11 ) & 0x1F;
+		const u16 g = ( color >> 5 ) & 0x3F;
+		const u16 b = color & 0x1F;
+
+		return( std::array<u8, 4> { { static_cast<u8>( ( r * 255 + 15 ) / 31 ), static_cast<u8>( ( g * 255 + 31 ) / 63 ), static_cast<u8>( ( b * 255 + 15 ) / 31 ), 255 } } );
+	}
+
+	// the color part of BC3 always uses four colors, only BC1 has the mode with punch through alpha
+	static void DecodeColorBlock( const u8 *block, const bool allowPunchThrough, TPixels &pixels )
+	{
+		const u16 color0 = static_cast<u16>( block[ 0 ] | ( block[ 1 ] << 8 ) );
+		const u16 color1 = static_cast<u16>( block[ 2 ] | ( block[ 3 ] << 8 ) );
+
+		std::array<std::array<u8, 4>, 4> palette;
+		palette[ 0 ] = ExpandRGB565( color0 );
+		palette[ 1 ] = ExpandRGB565( color1 );
+
+		for( u8 channel = 0; channel < 3; channel++ )
+		{
+			const u16 value0 = palette[ 0 ][ channel ];
+			const u16 value1 = palette[ 1 ][ channel ];
+
+			if( ( color0 > color1 ) || !allowPunchThrough )
+			{
+				palette[ 2 ][ channel ] = static_cast<u8>( ( 2 * value0 + value1 ) / 3 );
+				palette[ 3 ][ channel ] = static_cast<u8>( ( value0 + 2 * value1 ) / 3 );
+			}
+			else
+			{
+				palette[ 2 ][ channel ] = static_cast<u8>( ( value0 + value1 ) / 2 );
+				palette[ 3 ][ channel ] = 0;
+			}
+		}
+
+		palette[ 2 ][ 3 ] = 255;
+		palette[ 3 ][ 3 ] = ( ( color0 > color1 ) || !allowPunchThrough ) ? 255 : 0;
+
+		for( u8 row = 0; row < 4; row++ )
+		{
+			for( u8 column = 0; column < 4; column++ )
+			{
+				pixels[ row * 4 + column ] = palette[ ( block[ 4 + row ] >> ( 2 * column ) ) & 0x3 ];
+			}
+		}
+	}
+
+	static void DecodeAlphaBlock( const u8 *block, TPixels &pixels, const u8 channel )
+	{
+		const u16 alpha0 = block[ 0 ];
+		const u16 alpha1 = block[ 1 ];
+
+		std::array<u8, 8> values;
+		values[ 0 ] = static_cast<u8>( alpha0 );
+		values[ 1 ] = static_cast<u8>( alpha1 );
+
+		if( alpha0 > alpha1 )
+		{
+			for( u8 i = 2; i < 8; i++ )
+			{
+				values[ i ] = static_cast<u8>( ( ( 8 - i ) * alpha0 + ( i - 1 ) * alpha1 ) / 7 );
+			}
+		}
+		else
+		{
+			for( u8 i = 2; i < 6; i++ )
+			{
+				values[ i ] = static_cast<u8>( ( ( 6 - i ) * alpha0 + ( i - 1 ) * alpha1 ) / 5 );
+			}
+
+			values[ 6 ] = 0;
+			values[ 7 ] = 255;
+		}
+
+		u64 bits { 0 };
+		for( u8 i = 0; i < 6; i++ )
+		{
+			bits |= static_cast<u64>( block[ 2 + i ] ) << ( 8 * i );
+		}
+
+		for( u8 i = 0; i < 16; i++ )
+		{
+			pixels[ i ][ channel ] = values[ ( bits >> ( 3 * i ) ) & 0x7 ];
+		}
+	}
+
+	bool FlipVertically( const CCompressedImage::ECompression compression, const CSize &size, std::vector<std::byte> &data )
+	{
+		if( CCompressedImage::ECompression::BC7 == compression )
+		{
+			return( false );
+		}
+
+		const u8 blockBytes = CCompressedImage::BlockBytes( compression );
+
+		const u32 blocksX = std::max( static_cast<u32>( 1 ), ( size.width + 3 ) / 4 );
+		const u32 blocksY = std::max( static_cast<u32>( 1 ), ( size.height + 3 ) / 4 );
+
+		const u32 rowBytes = blocksX * blockBytes;
+
+		auto *bytes = reinterpret_cast<u8 *>( data.data() );
+
+		for( u32 y = 0; y < blocksY / 2; y++ )
+		{
+			std::swap_ranges( bytes + y * rowBytes, bytes + ( y + 1 ) * rowBytes, bytes + ( blocksY - 1 - y ) * rowBytes );
+		}
+
+		// only the smallest levels have blocks which aren't filled completely
+		const u8 rows = static_cast<u8>( std::min( static_cast<u32>( 4 ), size.height ) );
+
+		for( u32 i = 0; i < blocksX * blocksY; i++ )
+		{
+			u8 *block = bytes + i * blockBytes;
+
+			switch( compression )
+			{
+				case CCompressedImage::ECompression::BC1:
+					FlipColorBlock( block, rows );
+					break;
+
+				case CCompressedImage::ECompression::BC3:
+					FlipAlphaBlock( block, rows );
+					FlipColorBlock( block + 8, rows );
+					break;
+
+				case CCompressedImage::ECompression::BC4:
+					FlipAlphaBlock( block, rows );
+					break;
+
+				case CCompressedImage::ECompression::BC5:
+					FlipAlphaBlock( block, rows );
+					FlipAlphaBlock( block + 8, rows );
+					break;
+
+				default:
+					return( false );
+			}
+		}
+
+		return( true );
+	}
+
+	std::shared_ptr<CImage> Decompress( const CCompressedImage &image )
+	{
+		const auto compression = image.Compression();
+
+		u8 channels;
+
+		switch( compression )
+		{
+			case CCompressedImage::ECompression::BC1:
+			case CCompressedImage::ECompression::BC3:
+				channels = 4;
+				break;
+
+			case CCompressedImage::ECompression::BC4:
+				channels = 1;
+				break;
+
+			case CCompressedImage::ECompression::BC5:
+				channels = 2;
+				break;
+
+			default:
+				logWARNING( "{0} can't be decompressed", CCompressedImage::CompressionName( compression ) );
+				return( nullptr );
+		}
+
+		const auto &level = image.Levels().front();
+
+		const CSize &size = level.size;
+
+		const u8 blockBytes = CCompressedImage::BlockBytes( compression );
+
+		const u32 blocksX = std::max( static_cast<u32>( 1 ), ( size.width + 3 ) / 4 );
+		const u32 blocksY = std::max( static_cast<u32>( 1 ), ( size.height + 3 ) / 4 );
+
+		const u32 pitch = size.width * channels;
+
+		auto imageData = std::make_unique<CImage::PixelBuffer>( pitch * size.height );
+
+		auto *target = reinterpret_cast<u8 *>( imageData->data() );
+
+		const auto *source = reinterpret_cast<const u8 *>( level.data.data() );
+
+		TPixels pixels;
+
+		for( u32 blockY = 0; blockY < blocksY; blockY++ )
+		{
+			for( u32 blockX = 0; blockX < blocksX; blockX++ )
+			{
+				const u8 *block = source + ( blockY * blocksX + blockX ) * blockBytes;
+
+				switch( compression )
+				{
+					case CCompressedImage::ECompression::BC1:
+						DecodeColorBlock( block, true, pixels );
+						break;
+
+					case CCompressedImage::ECompression::BC3:
+						DecodeColorBlock( block + 8, false, pixels );
+						DecodeAlphaBlock( block, pixels, 3 );
+						break;
+
+					case CCompressedImage::ECompression::BC4:
+						DecodeAlphaBlock( block, pixels, 0 );
+						break;
+
+					case CCompressedImage::ECompression::BC5:
+						DecodeAlphaBlock( block, pixels, 0 );
+						DecodeAlphaBlock( block + 8, pixels, 1 );
+						break;
+
+					default:
+						return( nullptr );
+				}
+
+				for( u32 row = 0; row < 4; row++ )
+				{
+					const u32 y = blockY * 4 + row;
+
+					for( u32 column = 0; column < 4; column++ )
+					{
+						const u32 x = blockX * 4 + column;
+
+						if( ( x < size.width ) && ( y < size.height ) )
+						{
+							std::copy( std::begin( pixels[ row * 4 + column ] ), std::begin( pixels[ row * 4 + column ] ) + channels, target + y * pitch + x * channels );
+						}
+					}
+				}
+			}
+		}
+
+		return( std::make_shared<CImage>( size, static_cast<u8>( channels * 8 ), pitch, std::move( imageData ) ) );
+	}
+}
\ No newline at end of file
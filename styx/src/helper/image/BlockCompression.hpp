@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "src/helper/image/CImage.hpp"
+#include "src/helper/image/CCompressedImage.hpp"
+
+namespace BlockCompression
+{
+	// mirrors the rows of a level in place, not possible for BC7 where the pixels of a block can't be moved around
+	bool FlipVertically( const CCompressedImage::ECompression compression, const CSize &size, std::vector<std::byte> &data );
+
+	/**	Decodes the first level of the image on the CPU, for drivers which can't sample it compressed.
+		The image gets 32bpp for BC1 and BC3, 8bpp for BC4 and 16bpp for BC5. BC7 isn't supported.
+	*/
+	[[nodiscard]] std::shared_ptr<CImage> Decompress( const CCompressedImage &image );
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "CCompressedImage.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+CCompressedImage::CCompressedImage( const ECompression compression, std::vector<SLevel> levels ) :
+	m_compression { compression },
+	m_levels { std::move( levels ) }
+{
+	assert( !m_levels.empty() );
+}
+
+CCompressedImage::ECompression CCompressedImage::Compression() const
+{
+	return( m_compression );
+}
+
+const CSize &CCompressedImage::Size() const
+{
+	return( m_levels.front().size );
+}
+
+const std::vector<CCompressedImage::SLevel> &CCompressedImage::Levels() const
+{
+	return( m_levels );
+}
+
+u8 CCompressedImage::BlockBytes( const ECompression compression )
+{
+	switch( compression )
+	{
+		case ECompression::BC1:
+		case ECompression::BC4:
+			return( 8 );
+
+		case ECompression::BC3:
+		case ECompression::BC5:
+		case ECompression::BC7:
+		default:
+			return( 16 );
+	}
+}
+
+u64 CCompressedImage::LevelSize( const ECompression compression, const CSize &size )
+{
+	const u64 blocksX = std::max( static_cast<u32>( 1 ), ( size.width + 3 ) / 4 );
+	const u64 blocksY = std::max( static_cast<u32>( 1 ), ( size.height + 3 ) / 4 );
+
+	return( blocksX * blocksY * BlockBytes( compression ) );
+}
+
+std::string CCompressedImage::CompressionName( const ECompression compression )
+{
+	switch( compression )
+	{
+		case ECompression::BC1:
+			return( "BC1" );
+
+		case ECompression::BC3:
+			return( "BC3" );
+
+		case ECompression::BC4:
+			return( "BC4" );
+
+		case ECompression::BC5:
+			return( "BC5" );
+
+		case ECompression::BC7:
+			return( "BC7" );
+
+		default:
+			return( "UNKNOWN" );
+	}
+}
\ No newline at end of file
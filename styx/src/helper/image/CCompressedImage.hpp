@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "src/core/Types.hpp"
+
+#include "src/helper/CSize.hpp"
+
+/**
+ * Block compressed image with its whole chain of mip levels, the first level is the biggest one.
+ */
+class CCompressedImage final
+{
+public:
+	enum class ECompression : u8
+	{
+		BC1,
+		BC3,
+		BC4,
+		BC5,
+		BC7
+	};
+
+	struct SLevel final
+	{
+		CSize					size;
+		std::vector<std::byte>	data;
+	};
+
+	CCompressedImage( const ECompression compression, std::vector<SLevel> levels );
+
+	ECompression Compression() const;
+
+	// of the first level
+	const CSize &Size() const;
+
+	const std::vector<SLevel> &Levels() const;
+
+	// every block covers 4x4 pixels
+	static u8 BlockBytes( const ECompression compression );
+
+	// in bytes, for a level with the given size
+	static u64 LevelSize( const ECompression compression, const CSize &size );
+
+	static std::string CompressionName( const ECompression compression );
+
+private:
+	const ECompression m_compression;
+
+	const std::vector<SLevel> m_levels;
+};
\ No newline at end of file
@@ -6,11 +6,22 @@ CImage::CImage( const CSize &size, u8 bpp, u32 pitch, std::unique_ptr<PixelBuffe
 	m_size { size },
 	m_bpp { bpp },
 	m_pitch { pitch },
-	m_imageData { std::move( imageData ) }
+	m_imageData { std::move( imageData ) },
+	m_pixels { m_imageData ? m_imageData->data() : nullptr }
 {
 	assert( m_imageData );
 }
 
+CImage::CImage( const CSize &size, u8 bpp, u32 pitch, AdoptedPixels adoptedPixels ) :
+	m_size { size },
+	m_bpp { bpp },
+	m_pitch { pitch },
+	m_adoptedPixels { std::move( adoptedPixels ) },
+	m_pixels { m_adoptedPixels.get() }
+{
+	assert( m_adoptedPixels );
+}
+
 const CSize &CImage::Size() const
 {
 	return( m_size );
@@ -28,5 +39,5 @@ u32 CImage::Pitch() const
 
 const std::byte *CImage::RawPixelData() const
 {
-	return( m_imageData->data() );
+	return( m_pixels );
 }
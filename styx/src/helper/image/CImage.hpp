@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -12,9 +13,15 @@ class CImage final
 public:
 	using PixelBuffer = std::vector<std::byte>;
 
+	// pixels allocated by a decoder, which are handed back to it for freeing
+	using AdoptedPixels = std::unique_ptr<std::byte[], std::function<void( std::byte* )>>;
+
 public:
 	CImage( const CSize &size, u8 bpp, u32 pitch, std::unique_ptr<PixelBuffer> imageData );
 
+	// takes over the memory of a decoder, so its output doesn't have to be copied
+	CImage( const CSize &size, u8 bpp, u32 pitch, AdoptedPixels adoptedPixels );
+
 	const CSize &Size() const;
 
 	u8 BPP() const;
@@ -28,5 +35,9 @@ private:
 	const u8	m_bpp;
 	const u32	m_pitch;
 
-	const std::unique_ptr<PixelBuffer> m_imageData;
+	// only one of them holds the pixels
+	const std::unique_ptr<PixelBuffer>	m_imageData;
+	const AdoptedPixels					m_adoptedPixels;
+
+	const std::byte *const m_pixels;
 };
@@ -3,17 +3,339 @@
 #include <memory>
 #include <algorithm>
 #include <array>
+#include <cstring>
 
 #include "external/stb/stb_image.h"
-#include "external/stb/stb_image_resize.h"
 #include "external/stb/stb_image_write.h"
 
 #include "src/logger/CLogger.hpp"
 
 #include "src/math/Math.hpp"
 
+#include "src/helper/image/BlockCompression.hpp"
+#include "src/helper/image/ImageKernels.hpp"
+
 namespace ImageHandler
 {
+	// all values in DDS and KTX2 files are little endian, like on every platform we run on
+	template<typename T>
+	static T Read( const CFileView &file, const size_t offset )
+	{
+		T value;
+		std::memcpy( &value, file.Data() + offset, sizeof( T ) );
+		return( value );
+	}
+
+	static constexpr u32 FourCC( const char a, const char b, const char c, const char d )
+	{
+		return( static_cast<u32>( a ) | ( static_cast<u32>( b ) << 8 ) | ( static_cast<u32>( c ) << 16 ) | ( static_cast<u32>( d ) << 24 ) );
+	}
+
+	static CSize LevelSize( const CSize &size, const u32 level )
+	{
+		return( CSize( std::max( static_cast<u32>( 1 ), size.width >> level ), std::max( static_cast<u32>( 1 ), size.height >> level ) ) );
+	}
+
+	// of a complete mip chain, a file must not claim more levels since they would be shifted beyond the width of the size
+	static u32 MaxLevelCount( const CSize &size )
+	{
+		u32 levelCount = 1;
+
+		for( u32 extent = std::max( size.width, size.height ); extent > 1; extent >>= 1 )
+		{
+			levelCount++;
+		}
+
+		return( levelCount );
+	}
+
+	static bool ParseDDS( const CFileView &file, const fs::path &path, CCompressedImage::ECompression &compression, std::vector<CCompressedImage::SLevel> &levels )
+	{
+		static const size_t headerSize		= 128;
+		static const size_t headerDX10Size	= 20;
+
+		static const u32 flagMipMapCount	= 0x20000;
+		static const u32 pixelFormatFourCC	= 0x4;
+		static const u32 caps2Cubemap		= 0x200;
+
+		if( ( file.Size() < headerSize ) || ( Read<u32>( file, 0 ) != FourCC( 'D', 'D', 'S', ' ' ) ) )
+		{
+			logWARNING( "'{0}' is not a DDS file", path.generic_string() );
+			return( false );
+		}
+
+		const CSize size { Read<u32>( file, 16 ), Read<u32>( file, 12 ) };
+
+		const u32 levelCount = ( Read<u32>( file, 8 ) & flagMipMapCount ) ? std::max( Read<u32>( file, 28 ), static_cast<u32>( 1 ) ) : 1;
+
+		if( levelCount > MaxLevelCount( size ) )
+		{
+			logWARNING( "'{0}' claims {1} levels, which are too many for its size", path.generic_string(), levelCount );
+			return( false );
+		}
+
+		if( Read<u32>( file, 112 ) & caps2Cubemap )
+		{
+			logWARNING( "'{0}' is a cubemap, which is not supported for DDS files", path.generic_string() );
+			return( false );
+		}
+
+		if( !( Read<u32>( file, 80 ) & pixelFormatFourCC ) )
+		{
+			logWARNING( "'{0}' is not block compressed", path.generic_string() );
+			return( false );
+		}
+
+		size_t offset = headerSize;
+
+		switch( Read<u32>( file, 84 ) )
+		{
+			case FourCC( 'D', 'X', 'T', '1' ):
+				compression = CCompressedImage::ECompression::BC1;
+				break;
+
+			case FourCC( 'D', 'X', 'T', '5' ):
+				compression = CCompressedImage::ECompression::BC3;
+				break;
+
+			case FourCC( 'A', 'T', 'I', '1' ):
+			case FourCC( 'B', 'C', '4', 'U' ):
+				compression = CCompressedImage::ECompression::BC4;
+				break;
+
+			case FourCC( 'A', 'T', 'I', '2' ):
+			case FourCC( 'B', 'C', '5', 'U' ):
+				compression = CCompressedImage::ECompression::BC5;
+				break;
+
+			case FourCC( 'D', 'X', '1', '0' ):
+			{
+				if( file.Size() < headerSize + headerDX10Size )
+				{
+					logWARNING( "'{0}' is truncated", path.generic_string() );
+					return( false );
+				}
+
+				static const u32 resourceDimensionTexture2D	= 3;
+				static const u32 miscFlagTextureCube		= 0x4;
+
+				if( ( Read<u32>( file, 132 ) != resourceDimensionTexture2D ) || ( Read<u32>( file, 136 ) & miscFlagTextureCube ) || ( Read<u32>( file, 140 ) > 1 ) )
+				{
+					logWARNING( "'{0}' is not a single 2D texture", path.generic_string() );
+					return( false );
+				}
+
+				// the sRGB variants are treated like the linear ones, since no other texture is sRGB either
+				switch( const u32 dxgiFormat = Read<u32>( file, 128 ); dxgiFormat )
+				{
+					case 71:	// DXGI_FORMAT_BC1_UNORM
+					case 72:	// DXGI_FORMAT_BC1_UNORM_SRGB
+						compression = CCompressedImage::ECompression::BC1;
+						break;
+
+					case 77:	// DXGI_FORMAT_BC3_UNORM
+					case 78:	// DXGI_FORMAT_BC3_UNORM_SRGB
+						compression = CCompressedImage::ECompression::BC3;
+						break;
+
+					case 80:	// DXGI_FORMAT_BC4_UNORM
+						compression = CCompressedImage::ECompression::BC4;
+						break;
+
+					case 83:	// DXGI_FORMAT_BC5_UNORM
+						compression = CCompressedImage::ECompression::BC5;
+						break;
+
+					case 98:	// DXGI_FORMAT_BC7_UNORM
+					case 99:	// DXGI_FORMAT_BC7_UNORM_SRGB
+						compression = CCompressedImage::ECompression::BC7;
+						break;
+
+					default:
+						logWARNING( "DXGI format '{0}' of '{1}' is not supported", dxgiFormat, path.generic_string() );
+						return( false );
+				}
+
+				offset += headerDX10Size;
+				break;
+			}
+
+			default:
+				logWARNING( "the compression of '{0}' is not supported", path.generic_string() );
+				return( false );
+		}
+
+		// the levels are stored one after another, starting with the biggest
+		for( u32 level = 0; level < levelCount; level++ )
+		{
+			const CSize levelSize = LevelSize( size, level );
+			const u64 byteCount = CCompressedImage::LevelSize( compression, levelSize );
+
+			if( ( offset > file.Size() ) || ( byteCount > file.Size() - offset ) )
+			{
+				logWARNING( "level {0} of '{1}' is truncated", level, path.generic_string() );
+				return( false );
+			}
+
+			levels.push_back( { levelSize, std::vector<std::byte>( file.Data() + offset, file.Data() + offset + byteCount ) } );
+
+			offset += byteCount;
+		}
+
+		return( true );
+	}
+
+	static bool ParseKTX2( const CFileView &file, const fs::path &path, CCompressedImage::ECompression &compression, std::vector<CCompressedImage::SLevel> &levels )
+	{
+		static const std::array<u8, 12> identifier { { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A } };
+
+		static const size_t headerSize		= 80;
+		static const size_t levelIndexSize	= 24;
+
+		if( ( file.Size() < headerSize ) || !std::equal( std::cbegin( identifier ), std::cend( identifier ), reinterpret_cast<const u8 *>( file.Data() ) ) )
+		{
+			logWARNING( "'{0}' is not a KTX2 file", path.generic_string() );
+			return( false );
+		}
+
+		// the sRGB variants are treated like the linear ones, since no other texture is sRGB either
+		switch( const u32 vkFormat = Read<u32>( file, 12 ); vkFormat )
+		{
+			case 131:	// VK_FORMAT_BC1_RGB_UNORM_BLOCK
+			case 132:	// VK_FORMAT_BC1_RGB_SRGB_BLOCK
+			case 133:	// VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+			case 134:	// VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+				compression = CCompressedImage::ECompression::BC1;
+				break;
+
+			case 137:	// VK_FORMAT_BC3_UNORM_BLOCK
+			case 138:	// VK_FORMAT_BC3_SRGB_BLOCK
+				compression = CCompressedImage::ECompression::BC3;
+				break;
+
+			case 139:	// VK_FORMAT_BC4_UNORM_BLOCK
+				compression = CCompressedImage::ECompression::BC4;
+				break;
+
+			case 141:	// VK_FORMAT_BC5_UNORM_BLOCK
+				compression = CCompressedImage::ECompression::BC5;
+				break;
+
+			case 145:	// VK_FORMAT_BC7_UNORM_BLOCK
+			case 146:	// VK_FORMAT_BC7_SRGB_BLOCK
+				compression = CCompressedImage::ECompression::BC7;
+				break;
+
+			default:
+				logWARNING( "Vulkan format '{0}' of '{1}' is not supported", vkFormat, path.generic_string() );
+				return( false );
+		}
+
+		const CSize size { Read<u32>( file, 20 ), Read<u32>( file, 24 ) };
+
+		if( ( 0 == size.height ) || ( Read<u32>( file, 28 ) > 1 ) || ( Read<u32>( file, 32 ) > 1 ) || ( Read<u32>( file, 36 ) != 1 ) )
+		{
+			logWARNING( "'{0}' is not a single 2D texture", path.generic_string() );
+			return( false );
+		}
+
+		if( 0 != Read<u32>( file, 44 ) )
+		{
+			logWARNING( "the supercompression of '{0}' is not supported", path.generic_string() );
+			return( false );
+		}
+
+		const u32 levelCount = std::max( Read<u32>( file, 40 ), static_cast<u32>( 1 ) );
+
+		if( levelCount > MaxLevelCount( size ) )
+		{
+			logWARNING( "'{0}' claims {1} levels, which are too many for its size", path.generic_string(), levelCount );
+			return( false );
+		}
+
+		if( file.Size() < headerSize + levelCount * levelIndexSize )
+		{
+			logWARNING( "'{0}' is truncated", path.generic_string() );
+			return( false );
+		}
+
+		// the level index starts with the biggest level, even though the data is stored the other way around
+		for( u32 level = 0; level < levelCount; level++ )
+		{
+			const u64 offset	= Read<u64>( file, headerSize + level * levelIndexSize );
+			const u64 length	= Read<u64>( file, headerSize + level * levelIndexSize + 8 );
+
+			const CSize levelSize = LevelSize( size, level );
+			const u64 byteCount = CCompressedImage::LevelSize( compression, levelSize );
+
+			if( ( length < byteCount ) || ( offset > file.Size() ) || ( byteCount > file.Size() - offset ) )
+			{
+				logWARNING( "level {0} of '{1}' is truncated", level, path.generic_string() );
+				return( false );
+			}
+
+			levels.push_back( { levelSize, std::vector<std::byte>( file.Data() + offset, file.Data() + offset + byteCount ) } );
+		}
+
+		return( true );
+	}
+
+	// the levels of a cooked texture are used straight from the mapping, which is kept alive by every level
+	static bool ReadCookedTexture( const CFileSystem &p_filesystem, const fs::path &path, const u32 maxSize, std::vector<std::shared_ptr<CImage>> &levels )
+	{
+		const auto file = std::make_shared<const CFileView>( p_filesystem.MapFile( path ) );
+
+		if( file->Size() < sizeof( AssetPack::STextureHeader ) )
+		{
+			logWARNING( "cooked texture '{0}' is truncated", path.generic_string() );
+			return( false );
+		}
+
+		const auto header = Read<AssetPack::STextureHeader>( *file, 0 );
+
+		if(	( 0 == header.levelCount ) || ( header.levelCount > AssetPack::MaxTextureLevels )
+			||
+			( ( header.bpp != 8 ) && ( header.bpp != 16 ) && ( header.bpp != 24 ) && ( header.bpp != 32 ) ) )
+		{
+			logWARNING( "cooked texture '{0}' has an invalid header", path.generic_string() );
+			return( false );
+		}
+
+		const CSize size { header.width, header.height };
+
+		for( u8 level = 0; level < header.levelCount; level++ )
+		{
+			const CSize levelSize = LevelSize( size, level );
+
+			// instead of scaling the image down, the levels which are too big get skipped
+			if( ( levelSize.width > maxSize ) || ( levelSize.height > maxSize ) )
+			{
+				continue;
+			}
+
+			const u32 pitch = levelSize.width * ( header.bpp / 8 );
+
+			if( header.levelOffsets[ level ] + static_cast<u64>( pitch ) * levelSize.height > file->Size() )
+			{
+				logWARNING( "level {0} of cooked texture '{1}' is truncated", level, path.generic_string() );
+				return( false );
+			}
+
+			// the pixels are never written to, the cast is only needed to share the type with the decoders
+			CImage::AdoptedPixels pixels( const_cast<std::byte*>( file->Data() + header.levelOffsets[ level ] ), [ file ]( std::byte* ) {} );
+
+			levels.push_back( std::make_shared<CImage>( levelSize, header.bpp, pitch, std::move( pixels ) ) );
+		}
+
+		if( levels.empty() )
+		{
+			logWARNING( "cooked texture '{0}' has no level which is small enough", path.generic_string() );
+			return( false );
+		}
+
+		return( true );
+	}
+
 	/**	Loads an bitmap using stb_image into a CImage.
 		If necessary it gets rescaled to maxSize
 	*/
@@ -31,15 +353,37 @@ namespace ImageHandler
 			return( nullptr );
 		}
 
-		auto const buffer = p_filesystem.LoadFileToBuffer( path );
-
-		if( !buffer.empty() )
+		if( AssetPack::EEntryKind::TEXTURE == p_filesystem.EntryKind( path ) )
 		{
-			stbi_set_flip_vertically_on_load( !flipVertically );
+			std::vector<std::shared_ptr<CImage>> levels;
+
+			if( !ReadCookedTexture( p_filesystem, path, maxSize, levels ) )
+			{
+				return( nullptr );
+			}
+
+			// cooked textures are stored like the images which are loaded without flipping
+			if( flipVertically )
+			{
+				const auto &level = levels.front();
+
+				auto pixels = std::make_unique<CImage::PixelBuffer>( level->RawPixelData(), level->RawPixelData() + level->Pitch() * level->Size().height );
+
+				ImageKernels::FlipVertically( pixels->data(), level->Pitch(), level->Size().height );
+
+				return( std::make_shared<CImage>( level->Size(), level->BPP(), level->Pitch(), std::move( pixels ) ) );
+			}
 
+			return( levels.front() );
+		}
+
+		const CFileView file = p_filesystem.MapFile( path );
+
+		if( !file.Empty() )
+		{
 			int width, height, components;
 
-			std::unique_ptr<stbi_uc[], decltype( &stbi_image_free )> image( stbi_load_from_memory( reinterpret_cast<stbi_uc*>( const_cast<std::byte*>( buffer.data() ) ), buffer.size(), &width, &height, &components, STBI_default ), stbi_image_free );
+			CImage::AdoptedPixels image( reinterpret_cast<std::byte*>( stbi_load_from_memory( reinterpret_cast<const stbi_uc*>( file.Data() ), static_cast<int>( file.Size() ), &width, &height, &components, STBI_default ) ), []( std::byte *pixels ) { stbi_image_free( pixels ); } );
 
 			if( !image )
 			{
@@ -47,7 +391,7 @@ namespace ImageHandler
 				return( nullptr );
 			}
 
-			CSize size { static_cast<u32>( width ), static_cast<u32>( height ) };
+			const CSize size { static_cast<u32>( width ), static_cast<u32>( height ) };
 
 			if(	!Math::IsPowerOfTwo( size.width )
 				||
@@ -58,55 +402,129 @@ namespace ImageHandler
 				return( nullptr );
 			}
 
+			const u32 pitch = components * size.width;
+			const u32 bpp = components * 8;
+
+			// the flip is done here instead of by stb_image, because its flag is global and images get loaded on multiple threads
+			if( !flipVertically )
+			{
+				ImageKernels::FlipVertically( image.get(), pitch, size.height );
+			}
+
+			// the decoded pixels are taken over instead of being copied
+			auto loadedImage = std::make_shared<CImage>( size, bpp, pitch, std::move( image ) );
+
 			if(	( size.width > maxSize )
 				||
 				( size.height > maxSize ) )
 			{
-				const auto original_size = size;
-
 				logWARNING( "image '{0}' has to be scaled down because it's bigger than the allowed max size of '{1}' pixels", path.generic_string(), maxSize );
-										
-				// scale both axis down equally
-				while(	( size.width > maxSize )
+
+				// both axis are halved equally, the sizes are powers of two so every 2x2 block is complete
+				while(	( loadedImage->Size().width > maxSize )
 						||
-						( size.height > maxSize ) )
+						( loadedImage->Size().height > maxSize ) )
 				{
-					size.width	>>= 1;
-					size.height	>>= 1;
+					loadedImage = ImageKernels::Downsample2x( *loadedImage, false );
 				}
-					
-				// if width or height are below 1 we can't rescale so clamp it to 1
-				size.width	= (std::max)( static_cast<u32>( 1 ), size.width );
-				size.height	= (std::max)( static_cast<u32>( 1 ), size.height );
+			}
+
+			return( loadedImage );
+		}
+		else
+		{
+			logWARNING( "failed to open '{0}'", path.generic_string() );
+			return( nullptr );
+		}
+	}
 
-				std::unique_ptr<stbi_uc[], decltype( &stbi_image_free )> image_resized( (stbi_uc*)malloc( size.width * size.height * components ), stbi_image_free );
+	/**	Loads a DDS or KTX2 file with all of its mip levels, without decompressing the blocks.
+		Levels bigger than maxSize are dropped.
+	*/
+	std::shared_ptr<CCompressedImage> LoadCompressed( const CFileSystem &p_filesystem, const fs::path &path, const u32 maxSize, const bool flipVertically )
+	{
+		if( !path.has_filename() )
+		{
+			logWARNING( "path '{0}' does not contain a filename", path.generic_string() );
+			return( nullptr );
+		}
 
-				if( !stbir_resize_uint8( image.get(), original_size.width, original_size.height, 0,
-										 image_resized.get(), size.width, size.height, 0,
-					                     components ) )
-				{
-					logWARNING( "failed to rescale image '{0}'", path.generic_string() );
+		if( !p_filesystem.Exists( path ) )
+		{
+			logWARNING( "image '{0}' does not exist", path.generic_string() );
+			return( nullptr );
+		}
 
-					return( nullptr );
-				}
+		const CFileView file = p_filesystem.MapFile( path );
 
-				image.reset( image_resized.release() );
-			}
+		if( file.Empty() )
+		{
+			logWARNING( "failed to open '{0}'", path.generic_string() );
+			return( nullptr );
+		}
 
-			const u32 pitch = components * size.width;
-			const u32 bpp = components * 8;
+		const std::string fileExtensionString = path.extension().generic_string();
 
-			auto imageData = std::make_unique<CImage::PixelBuffer>( pitch * size.height );
+		CCompressedImage::ECompression compression;
 
-			std::copy( reinterpret_cast<std::byte*>( image.get() ), reinterpret_cast<std::byte*>( image.get() ) + ( pitch * size.height ), imageData->data() );
+		std::vector<CCompressedImage::SLevel> levels;
 
-			return( std::make_shared<CImage>( size, bpp, pitch, std::move( imageData ) ) );
+		if( fileExtensionString == std::string( ".dds" ) )
+		{
+			if( !ParseDDS( file, path, compression, levels ) )
+			{
+				return( nullptr );
+			}
+		}
+		else if( fileExtensionString == std::string( ".ktx2" ) )
+		{
+			if( !ParseKTX2( file, path, compression, levels ) )
+			{
+				return( nullptr );
+			}
 		}
 		else
 		{
-			logWARNING( "failed to open '{0}'", path.generic_string() );
+			logWARNING( "file type '{0}' of '{1}' is not a compressed image", fileExtensionString, path.generic_string() );
 			return( nullptr );
 		}
+
+		if(	!Math::IsPowerOfTwo( levels.front().size.width )
+			||
+			!Math::IsPowerOfTwo( levels.front().size.height ) )
+		{
+			logWARNING( "the size of image '{0}' is not a power of two", path.generic_string() );
+			return( nullptr );
+		}
+
+		// instead of scaling the image down, the levels which are too big get skipped
+		if( ( levels.front().size.width > maxSize ) || ( levels.front().size.height > maxSize ) )
+		{
+			logWARNING( "image '{0}' has to skip levels because it's bigger than the allowed max size of '{1}' pixels", path.generic_string(), maxSize );
+
+			levels.erase( std::begin( levels ), std::find_if( std::begin( levels ), std::end( levels ), [ maxSize ]( const auto &level ) { return( ( level.size.width <= maxSize ) && ( level.size.height <= maxSize ) ); } ) );
+
+			if( levels.empty() )
+			{
+				logWARNING( "image '{0}' has no level which is small enough", path.generic_string() );
+				return( nullptr );
+			}
+		}
+
+		// same orientation as the images loaded via stb_image
+		if( !flipVertically )
+		{
+			for( auto &level : levels )
+			{
+				if( !BlockCompression::FlipVertically( compression, level.size, level.data ) )
+				{
+					logWARNING( "the {0} blocks of '{1}' can't be flipped, so it is shown upside down", CCompressedImage::CompressionName( compression ), path.generic_string() );
+					break;
+				}
+			}
+		}
+
+		return( std::make_shared<CCompressedImage>( compression, std::move( levels ) ) );
 	}
 
 	bool Save( const CFileSystem &p_filesystem, const CImage &image, const std::string &format, const fs::path &path )
@@ -157,6 +575,59 @@ namespace ImageHandler
 		return( p_filesystem.SaveBufferToFile( *buffer.get(), path ) );
 	}
 
+	std::vector<std::shared_ptr<const CImage>> GenerateMipChain( const std::shared_ptr<const CImage> &image, const bool sRGB )
+	{
+		std::vector<std::shared_ptr<const CImage>> mipChain;
+
+		std::shared_ptr<const CImage> level = image;
+
+		while( ( level->Size().width > 1 ) || ( level->Size().height > 1 ) )
+		{
+			level = ImageKernels::Downsample2x( *level, sRGB );
+
+			mipChain.push_back( level );
+		}
+
+		return( mipChain );
+	}
+
+	std::shared_ptr<const CImage> LoadWithMipChain( const CFileSystem &p_filesystem, const fs::path &path, const u32 maxSize, std::vector<std::shared_ptr<const CImage>> &mipChain )
+	{
+		mipChain.clear();
+
+		if( AssetPack::EEntryKind::TEXTURE == p_filesystem.EntryKind( path ) )
+		{
+			std::vector<std::shared_ptr<CImage>> levels;
+
+			if( !ReadCookedTexture( p_filesystem, path, maxSize, levels ) )
+			{
+				return( nullptr );
+			}
+
+			mipChain.assign( std::next( std::cbegin( levels ) ), std::cend( levels ) );
+
+			return( levels.front() );
+		}
+
+		std::shared_ptr<const CImage> image = Load( p_filesystem, path, maxSize, false );
+
+		if( !image )
+		{
+			return( nullptr );
+		}
+
+		// the driver would expand every pixel on upload anyway
+		if( 24 == image->BPP() )
+		{
+			image = ImageKernels::ExpandRGBToRGBA( *image );
+		}
+
+		// only colors are sRGB encoded, 8 and 16bpp images hold data like heights or normals
+		mipChain = GenerateMipChain( image, image->BPP() >= 24 );
+
+		return( image );
+	}
+
 	std::shared_ptr<CImage> GenerateCheckerImage( const CSize &size, const CColor &color1, const CColor &color2 )
 	{
 		if( !Math::IsPowerOfTwo( size.width ) )
@@ -183,26 +654,38 @@ namespace ImageHandler
 
 			const std::array<ColorBytes, 2> colors = { ConvertColorToByteArray( color1 ), ConvertColorToByteArray( color2 ) };
 
-			auto checkerImageData = std::make_unique<CImage::PixelBuffer>( size.width * size.height * 4 );
+			const u32 pitch = size.width * 4;
 
-			for( u32 i = 0; i < size.height; ++i )
+			// there are only two different rows, which start with the one or the other color
+			std::array<CImage::PixelBuffer, 2> rows;
+
+			for( u8 row = 0; row < 2; ++row )
 			{
+				rows[ row ].resize( pitch );
+
 				for( u32 j = 0; j < size.width; ++j )
 				{
 					// change color every 8 pixels
-					const auto c = ( ( i & 0x8 ) == 0 ) ^ ( ( j & 0x8 ) == 0 );
-
-					const auto &color = colors[ c ];
+					const auto &color = colors[ row ^ ( ( j & 0x8 ) == 0 ) ];
 
-					const u32 index = ( ( i * size.width ) * 4 ) + ( j * 4 );
-					checkerImageData->at( index + 0 ) = color[ 2 ];	// blue
-					checkerImageData->at( index + 1 ) = color[ 1 ];	// green
-					checkerImageData->at( index + 2 ) = color[ 0 ];	// red
-					checkerImageData->at( index + 3 ) = color[ 3 ];	// alpha
+					std::byte *pixel = rows[ row ].data() + ( j * 4 );
+					pixel[ 0 ] = color[ 2 ];	// blue
+					pixel[ 1 ] = color[ 1 ];	// green
+					pixel[ 2 ] = color[ 0 ];	// red
+					pixel[ 3 ] = color[ 3 ];	// alpha
 				}
 			}
 
-			return( std::make_shared<CImage>( size, 32, size.width * 4, std::move( checkerImageData ) ) );
+			auto checkerImageData = std::make_unique<CImage::PixelBuffer>( pitch * size.height );
+
+			for( u32 i = 0; i < size.height; ++i )
+			{
+				const auto &row = rows[ ( i & 0x8 ) == 0 ];
+
+				std::copy( std::cbegin( row ), std::cend( row ), checkerImageData->data() + ( i * pitch ) );
+			}
+
+			return( std::make_shared<CImage>( size, 32, pitch, std::move( checkerImageData ) ) );
 		}
 	}
 }
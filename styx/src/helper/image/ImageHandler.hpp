@@ -1,4 +1,5 @@
 #include "CImage.hpp"
+#include "CCompressedImage.hpp"
 
 #include "src/core/Types.hpp"
 
@@ -10,7 +11,15 @@ namespace ImageHandler
 {
 	[[nodiscard]] std::shared_ptr<CImage> Load( const CFileSystem &p_filesystem, const fs::path &path, const u32 maxSize, const bool flipVertically );
 
+	[[nodiscard]] std::shared_ptr<CCompressedImage> LoadCompressed( const CFileSystem &p_filesystem, const fs::path &path, const u32 maxSize, const bool flipVertically );
+
 	bool Save( const CFileSystem &p_filesystem, const CImage &image, const std::string &format, const fs::path &path );
 
+	// all levels below the image down to 1x1, with sRGB the color channels are filtered in linear space
+	[[nodiscard]] std::vector<std::shared_ptr<const CImage>> GenerateMipChain( const std::shared_ptr<const CImage> &image, const bool sRGB );
+
+	// the image like it is uploaded, with 24bpp expanded to 32bpp, and its mip chain, which comes straight from a cooked texture if there is one
+	[[nodiscard]] std::shared_ptr<const CImage> LoadWithMipChain( const CFileSystem &p_filesystem, const fs::path &path, const u32 maxSize, std::vector<std::shared_ptr<const CImage>> &mipChain );
+
 	[[nodiscard]] std::shared_ptr<CImage> GenerateCheckerImage( const CSize &size, const CColor &color1, const CColor &color2 );
 }
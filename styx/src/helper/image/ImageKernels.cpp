@@ -0,0 +1,510 @@
+#include "ImageKernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/system/ComputerInfo.hpp"
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+	#define STYX_IMAGE_KERNELS_X86
+
+	#include <smmintrin.h>
+
+	// GCC and Clang only emit the instructions in functions which ask for them, MSVC always does
+	#if defined( __GNUC__ )
+		#define STYX_TARGET_SSE41 __attribute__( ( target( "sse4.1" ) ) )
+	#else
+		#define STYX_TARGET_SSE41
+	#endif
+#endif
+
+namespace ImageKernels
+{
+	static EInstructionSet DetectInstructionSet()
+	{
+		#ifdef STYX_IMAGE_KERNELS_X86
+			if( ComputerInfo::HasSSE41() )
+			{
+				return( EInstructionSet::SSE41 );
+			}
+		#endif
+
+		return( EInstructionSet::SCALAR );
+	}
+
+	static std::atomic<EInstructionSet> &SelectedInstructionSet()
+	{
+		static std::atomic<EInstructionSet> selectedInstructionSet { DetectInstructionSet() };
+
+		return( selectedInstructionSet );
+	}
+
+	EInstructionSet InstructionSet()
+	{
+		return( SelectedInstructionSet() );
+	}
+
+	void ForceInstructionSet( const EInstructionSet instructionSet )
+	{
+		if( ( EInstructionSet::SCALAR != instructionSet ) && ( DetectInstructionSet() != instructionSet ) )
+		{
+			logWARNING( "the processor doesn't support {0}, using {1} image kernels", InstructionSetName( instructionSet ), InstructionSetName( EInstructionSet::SCALAR ) );
+
+			SelectedInstructionSet() = EInstructionSet::SCALAR;
+		}
+		else
+		{
+			SelectedInstructionSet() = instructionSet;
+		}
+	}
+
+	std::string InstructionSetName( const EInstructionSet instructionSet )
+	{
+		switch( instructionSet )
+		{
+			case EInstructionSet::SCALAR:
+				return( "scalar" );
+
+			case EInstructionSet::SSE41:
+				return( "SSE4.1" );
+
+			default:
+				return( "unknown" );
+		}
+	}
+
+	/*
+	 * sRGB conversion
+	 */
+
+	static const std::array<u16, 256> &SRGBToLinearTable()
+	{
+		static const std::array<u16, 256> table = []
+		{
+			std::array<u16, 256> values;
+
+			for( u32 i = 0; i < values.size(); i++ )
+			{
+				const f32 srgb = i / 255.0;
+
+				const f32 linear = ( srgb <= 0.04045 ) ? ( srgb / 12.92 ) : std::pow( ( srgb + 0.055 ) / 1.055, 2.4 );
+
+				values[ i ] = static_cast<u16>( std::lround( linear * 65535.0 ) );
+			}
+
+			return( values );
+		}();
+
+		return( table );
+	}
+
+	// indexed with the full 16 bit linear value, so no precision is lost in the dark values
+	static const std::vector<u8> &LinearToSRGBTable()
+	{
+		static const std::vector<u8> table = []
+		{
+			std::vector<u8> values( 65536 );
+
+			for( u32 i = 0; i < values.size(); i++ )
+			{
+				const f32 linear = i / 65535.0;
+
+				const f32 srgb = ( linear <= 0.0031308 ) ? ( linear * 12.92 ) : ( 1.055 * std::pow( linear, 1.0 / 2.4 ) - 0.055 );
+
+				values[ i ] = static_cast<u8>( std::lround( std::clamp( srgb, 0.0, 1.0 ) * 255.0 ) );
+			}
+
+			return( values );
+		}();
+
+		return( table );
+	}
+
+	/*
+	 * scalar implementations, they also handle what is left over by the vectorized ones
+	 */
+
+	static void Downsample2xPixel( const std::byte *topLeft, const std::byte *topRight, const std::byte *bottomLeft, const std::byte *bottomRight, const u8 channels, const u8 srgbChannels, std::byte *destination )
+	{
+		for( u8 channel = 0; channel < channels; channel++ )
+		{
+			if( channel < srgbChannels )
+			{
+				const auto &toLinear = SRGBToLinearTable();
+
+				const u32 sum =	toLinear[ static_cast<u8>( topLeft[ channel ] ) ] + toLinear[ static_cast<u8>( topRight[ channel ] ) ] +
+								toLinear[ static_cast<u8>( bottomLeft[ channel ] ) ] + toLinear[ static_cast<u8>( bottomRight[ channel ] ) ];
+
+				destination[ channel ] = static_cast<std::byte>( LinearToSRGBTable()[ ( sum + 2 ) >> 2 ] );
+			}
+			else
+			{
+				const u32 sum =	static_cast<u32>( topLeft[ channel ] ) + static_cast<u32>( topRight[ channel ] ) +
+								static_cast<u32>( bottomLeft[ channel ] ) + static_cast<u32>( bottomRight[ channel ] );
+
+				destination[ channel ] = static_cast<std::byte>( ( sum + 2 ) >> 2 );
+			}
+		}
+	}
+
+	static void Downsample2xRowScalar( const std::byte *top, const std::byte *bottom, const u32 sourceWidth, const u32 firstPixel, const u32 width, const u8 channels, const u8 srgbChannels, std::byte *destination )
+	{
+		// a source of width 1 has no right neighbour, so the left pixel is taken twice
+		const u32 rightOffset = ( sourceWidth > 1 ) ? channels : 0;
+
+		for( u32 x = firstPixel; x < width; x++ )
+		{
+			const u32 left = 2 * x * channels;
+
+			Downsample2xPixel( top + left, top + left + rightOffset, bottom + left, bottom + left + rightOffset, channels, srgbChannels, destination + x * channels );
+		}
+	}
+
+	static void ExpandRGBToRGBAScalar( const std::byte *source, std::byte *destination, const size_t firstPixel, const size_t pixelCount )
+	{
+		for( size_t i = firstPixel; i < pixelCount; i++ )
+		{
+			destination[ i * 4 + 0 ] = source[ i * 3 + 0 ];
+			destination[ i * 4 + 1 ] = source[ i * 3 + 1 ];
+			destination[ i * 4 + 2 ] = source[ i * 3 + 2 ];
+			destination[ i * 4 + 3 ] = static_cast<std::byte>( 0xFF );
+		}
+	}
+
+	static void SwizzleRGBAToBGRAScalar( std::byte *pixels, const size_t firstPixel, const size_t pixelCount )
+	{
+		for( size_t i = firstPixel; i < pixelCount; i++ )
+		{
+			std::swap( pixels[ i * 4 + 0 ], pixels[ i * 4 + 2 ] );
+		}
+	}
+
+	// exactly rounds value / 255 for every product of two bytes
+	static inline u32 DivideBy255( const u32 value )
+	{
+		const u32 rounded = value + 128;
+
+		return( ( rounded + ( rounded >> 8 ) ) >> 8 );
+	}
+
+	static void PremultiplyAlphaScalar( std::byte *pixels, const size_t firstPixel, const size_t pixelCount )
+	{
+		for( size_t i = firstPixel; i < pixelCount; i++ )
+		{
+			std::byte *pixel = pixels + i * 4;
+
+			const u32 alpha = static_cast<u32>( pixel[ 3 ] );
+
+			for( u8 channel = 0; channel < 3; channel++ )
+			{
+				pixel[ channel ] = static_cast<std::byte>( DivideBy255( static_cast<u32>( pixel[ channel ] ) * alpha ) );
+			}
+		}
+	}
+
+	static void SwapRowsScalar( std::byte *top, std::byte *bottom, const u32 firstByte, const u32 pitch )
+	{
+		std::swap_ranges( top + firstByte, top + pitch, bottom + firstByte );
+	}
+
+	/*
+	 * SSE4.1 implementations, they return how many pixels they did, the rest is left to the scalar ones
+	 */
+
+	#ifdef STYX_IMAGE_KERNELS_X86
+		STYX_TARGET_SSE41 static u32 Downsample2xRowRGBASSE41( const std::byte *top, const std::byte *bottom, const u32 width, std::byte *destination )
+		{
+			const __m128i zero	= _mm_setzero_si128();
+			const __m128i two	= _mm_set1_epi16( 2 );
+
+			u32 x = 0;
+
+			// 4 source pixels of both rows make 2 destination pixels
+			for( ; x + 2 <= width; x += 2 )
+			{
+				// [ p0 p2 p1 p3 ], so the left pixels of both blocks end up in the low and the right pixels in the high half
+				const __m128i topPixels		= _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( top + x * 8 ) ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
+				const __m128i bottomPixels	= _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i *>( bottom + x * 8 ) ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
+
+				__m128i sum = _mm_add_epi16( _mm_cvtepu8_epi16( topPixels ), _mm_unpackhi_epi8( topPixels, zero ) );
+				sum = _mm_add_epi16( sum, _mm_cvtepu8_epi16( bottomPixels ) );
+				sum = _mm_add_epi16( sum, _mm_unpackhi_epi8( bottomPixels, zero ) );
+
+				sum = _mm_srli_epi16( _mm_add_epi16( sum, two ), 2 );
+
+				_mm_storel_epi64( reinterpret_cast<__m128i *>( destination + x * 4 ), _mm_packus_epi16( sum, sum ) );
+			}
+
+			return( x );
+		}
+
+		// the color channels of the pixel gathered through the table into the lanes, alpha as it is
+		STYX_TARGET_SSE41 static inline __m128i ToLinearSSE41( const std::byte *pixel, const std::array<u16, 256> &toLinear )
+		{
+			return( _mm_setr_epi32(	toLinear[ static_cast<u8>( pixel[ 0 ] ) ],
+									toLinear[ static_cast<u8>( pixel[ 1 ] ) ],
+									toLinear[ static_cast<u8>( pixel[ 2 ] ) ],
+									static_cast<u8>( pixel[ 3 ] ) ) );
+		}
+
+		// there is no gather before AVX2, so the tables are read per channel while the sums and the rounding are done for all channels at once
+		STYX_TARGET_SSE41 static u32 Downsample2xRowSRGBASSE41( const std::byte *top, const std::byte *bottom, const u32 width, std::byte *destination )
+		{
+			const auto &toLinear	= SRGBToLinearTable();
+			const u8 *toSRGB		= LinearToSRGBTable().data();
+
+			const __m128i two = _mm_set1_epi32( 2 );
+
+			u32 x = 0;
+
+			for( ; x < width; x++ )
+			{
+				const std::byte *topLeft	= top + x * 8;
+				const std::byte *bottomLeft	= bottom + x * 8;
+
+				__m128i sum = _mm_add_epi32( ToLinearSSE41( topLeft, toLinear ), ToLinearSSE41( topLeft + 4, toLinear ) );
+				sum = _mm_add_epi32( sum, ToLinearSSE41( bottomLeft, toLinear ) );
+				sum = _mm_add_epi32( sum, ToLinearSSE41( bottomLeft + 4, toLinear ) );
+
+				sum = _mm_srli_epi32( _mm_add_epi32( sum, two ), 2 );
+
+				std::byte *pixel = destination + x * 4;
+
+				pixel[ 0 ] = static_cast<std::byte>( toSRGB[ _mm_extract_epi32( sum, 0 ) ] );
+				pixel[ 1 ] = static_cast<std::byte>( toSRGB[ _mm_extract_epi32( sum, 1 ) ] );
+				pixel[ 2 ] = static_cast<std::byte>( toSRGB[ _mm_extract_epi32( sum, 2 ) ] );
+				pixel[ 3 ] = static_cast<std::byte>( _mm_extract_epi32( sum, 3 ) );
+			}
+
+			return( x );
+		}
+
+		STYX_TARGET_SSE41 static size_t ExpandRGBToRGBASSE41( const std::byte *source, std::byte *destination, const size_t pixelCount )
+		{
+			const __m128i shuffle	= _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+			const __m128i alpha		= _mm_set1_epi32( static_cast<int>( 0xFF000000 ) );
+
+			size_t i = 0;
+
+			// 16 bytes are loaded for the 12 of 4 pixels, so it stops early enough to not read past the end
+			for( ; i + 6 <= pixelCount; i += 4 )
+			{
+				const __m128i rgb = _mm_loadu_si128( reinterpret_cast<const __m128i *>( source + i * 3 ) );
+
+				_mm_storeu_si128( reinterpret_cast<__m128i *>( destination + i * 4 ), _mm_or_si128( _mm_shuffle_epi8( rgb, shuffle ), alpha ) );
+			}
+
+			return( i );
+		}
+
+		STYX_TARGET_SSE41 static size_t SwizzleRGBAToBGRASSE41( std::byte *pixels, const size_t pixelCount )
+		{
+			const __m128i shuffle = _mm_setr_epi8( 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 );
+
+			size_t i = 0;
+
+			for( ; i + 4 <= pixelCount; i += 4 )
+			{
+				__m128i *chunk = reinterpret_cast<__m128i *>( pixels + i * 4 );
+
+				_mm_storeu_si128( chunk, _mm_shuffle_epi8( _mm_loadu_si128( chunk ), shuffle ) );
+			}
+
+			return( i );
+		}
+
+		// the alpha of every pixel in each of its channels and 255 for the alpha channel itself, so alpha stays untouched
+		STYX_TARGET_SSE41 static inline __m128i PremultiplyFactorsSSE41( const __m128i channels )
+		{
+			const __m128i alpha = _mm_shufflehi_epi16( _mm_shufflelo_epi16( channels, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) );
+
+			return( _mm_blend_epi16( alpha, _mm_set1_epi16( 255 ), 0x88 ) );
+		}
+
+		STYX_TARGET_SSE41 static inline __m128i DivideBy255SSE41( const __m128i products )
+		{
+			const __m128i rounded = _mm_add_epi16( products, _mm_set1_epi16( 128 ) );
+
+			return( _mm_srli_epi16( _mm_add_epi16( rounded, _mm_srli_epi16( rounded, 8 ) ), 8 ) );
+		}
+
+		STYX_TARGET_SSE41 static size_t PremultiplyAlphaSSE41( std::byte *pixels, const size_t pixelCount )
+		{
+			const __m128i zero = _mm_setzero_si128();
+
+			size_t i = 0;
+
+			for( ; i + 4 <= pixelCount; i += 4 )
+			{
+				__m128i *chunk = reinterpret_cast<__m128i *>( pixels + i * 4 );
+
+				const __m128i pixelsRGBA = _mm_loadu_si128( chunk );
+
+				const __m128i low	= _mm_cvtepu8_epi16( pixelsRGBA );
+				const __m128i high	= _mm_unpackhi_epi8( pixelsRGBA, zero );
+
+				const __m128i lowPremultiplied	= DivideBy255SSE41( _mm_mullo_epi16( low, PremultiplyFactorsSSE41( low ) ) );
+				const __m128i highPremultiplied	= DivideBy255SSE41( _mm_mullo_epi16( high, PremultiplyFactorsSSE41( high ) ) );
+
+				_mm_storeu_si128( chunk, _mm_packus_epi16( lowPremultiplied, highPremultiplied ) );
+			}
+
+			return( i );
+		}
+
+		STYX_TARGET_SSE41 static u32 SwapRowsSSE41( std::byte *top, std::byte *bottom, const u32 pitch )
+		{
+			u32 i = 0;
+
+			for( ; i + 16 <= pitch; i += 16 )
+			{
+				__m128i *topChunk		= reinterpret_cast<__m128i *>( top + i );
+				__m128i *bottomChunk	= reinterpret_cast<__m128i *>( bottom + i );
+
+				const __m128i topBytes = _mm_loadu_si128( topChunk );
+
+				_mm_storeu_si128( topChunk, _mm_loadu_si128( bottomChunk ) );
+				_mm_storeu_si128( bottomChunk, topBytes );
+			}
+
+			return( i );
+		}
+	#endif
+
+	/*
+	 * dispatch
+	 */
+
+	void Downsample2x( const std::byte *source, const CSize &sourceSize, const u32 sourcePitch, const u8 channels, const bool sRGB, std::byte *destination )
+	{
+		const u32 width		= std::max( sourceSize.width / 2, static_cast<u32>( 1 ) );
+		const u32 height	= std::max( sourceSize.height / 2, static_cast<u32>( 1 ) );
+
+		const u8 srgbChannels = ( sRGB && ( channels >= 3 ) ) ? 3 : 0;
+
+		// only RGBA with two columns to average is vectorized
+		[[maybe_unused]] const bool vectorized = ( EInstructionSet::SSE41 == InstructionSet() ) && ( 4 == channels ) && ( sourceSize.width > 1 );
+
+		for( u32 y = 0; y < height; y++ )
+		{
+			const std::byte *top	= source + ( 2 * y ) * sourcePitch;
+			const std::byte *bottom	= ( sourceSize.height > 1 ) ? top + sourcePitch : top;
+
+			std::byte *row = destination + y * width * channels;
+
+			u32 firstPixel = 0;
+
+			#ifdef STYX_IMAGE_KERNELS_X86
+				if( vectorized )
+				{
+					firstPixel = ( 0 == srgbChannels ) ? Downsample2xRowRGBASSE41( top, bottom, width, row ) : Downsample2xRowSRGBASSE41( top, bottom, width, row );
+				}
+			#endif
+
+			Downsample2xRowScalar( top, bottom, sourceSize.width, firstPixel, width, channels, srgbChannels, row );
+		}
+	}
+
+	void ExpandRGBToRGBA( const std::byte *source, std::byte *destination, const size_t pixelCount )
+	{
+		size_t firstPixel = 0;
+
+		#ifdef STYX_IMAGE_KERNELS_X86
+			if( EInstructionSet::SSE41 == InstructionSet() )
+			{
+				firstPixel = ExpandRGBToRGBASSE41( source, destination, pixelCount );
+			}
+		#endif
+
+		ExpandRGBToRGBAScalar( source, destination, firstPixel, pixelCount );
+	}
+
+	void SwizzleRGBAToBGRA( std::byte *pixels, const size_t pixelCount )
+	{
+		size_t firstPixel = 0;
+
+		#ifdef STYX_IMAGE_KERNELS_X86
+			if( EInstructionSet::SSE41 == InstructionSet() )
+			{
+				firstPixel = SwizzleRGBAToBGRASSE41( pixels, pixelCount );
+			}
+		#endif
+
+		SwizzleRGBAToBGRAScalar( pixels, firstPixel, pixelCount );
+	}
+
+	void PremultiplyAlpha( std::byte *pixels, const size_t pixelCount )
+	{
+		size_t firstPixel = 0;
+
+		#ifdef STYX_IMAGE_KERNELS_X86
+			if( EInstructionSet::SSE41 == InstructionSet() )
+			{
+				firstPixel = PremultiplyAlphaSSE41( pixels, pixelCount );
+			}
+		#endif
+
+		PremultiplyAlphaScalar( pixels, firstPixel, pixelCount );
+	}
+
+	void FlipVertically( std::byte *pixels, const u32 pitch, const u32 height )
+	{
+		[[maybe_unused]] const bool vectorized = ( EInstructionSet::SSE41 == InstructionSet() );
+
+		for( u32 row = 0; row < height / 2; row++ )
+		{
+			std::byte *top		= pixels + row * pitch;
+			std::byte *bottom	= pixels + ( height - 1 - row ) * pitch;
+
+			u32 firstByte = 0;
+
+			#ifdef STYX_IMAGE_KERNELS_X86
+				if( vectorized )
+				{
+					firstByte = SwapRowsSSE41( top, bottom, pitch );
+				}
+			#endif
+
+			SwapRowsScalar( top, bottom, firstByte, pitch );
+		}
+	}
+
+	std::shared_ptr<CImage> Downsample2x( const CImage &image, const bool sRGB )
+	{
+		const auto &size = image.Size();
+
+		const u8 channels = image.BPP() / 8;
+
+		const CSize downsampledSize { std::max( size.width / 2, static_cast<u32>( 1 ) ), std::max( size.height / 2, static_cast<u32>( 1 ) ) };
+
+		const u32 pitch = downsampledSize.width * channels;
+
+		auto pixels = std::make_unique<CImage::PixelBuffer>( static_cast<size_t>( pitch ) * downsampledSize.height );
+
+		Downsample2x( image.RawPixelData(), size, image.Pitch(), channels, sRGB, pixels->data() );
+
+		return( std::make_shared<CImage>( downsampledSize, image.BPP(), pitch, std::move( pixels ) ) );
+	}
+
+	std::shared_ptr<CImage> ExpandRGBToRGBA( const CImage &image )
+	{
+		const auto &size = image.Size();
+
+		const u32 pitch = size.width * 4;
+
+		auto pixels = std::make_unique<CImage::PixelBuffer>( static_cast<size_t>( pitch ) * size.height );
+
+		// rows may be padded, so they are expanded one by one
+		for( u32 row = 0; row < size.height; row++ )
+		{
+			ExpandRGBToRGBA( image.RawPixelData() + row * image.Pitch(), pixels->data() + row * pitch, size.width );
+		}
+
+		return( std::make_shared<CImage>( size, 32, pitch, std::move( pixels ) ) );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "src/core/Types.hpp"
+
+#include "src/helper/CSize.hpp"
+
+#include "src/helper/image/CImage.hpp"
+
+/**	Pixel kernels on 8 bit channels with a scalar and an SSE4.1 implementation each.
+	The implementation is picked once from the features of the processor, both produce the exact same results.
+*/
+namespace ImageKernels
+{
+	enum class EInstructionSet : u8
+	{
+		SCALAR,
+		SSE41
+	};
+
+	EInstructionSet InstructionSet();
+
+	// lets the benchmark compare the implementations, falls back to the scalar one if the processor lacks the instructions
+	void ForceInstructionSet( const EInstructionSet instructionSet );
+
+	std::string InstructionSetName( const EInstructionSet instructionSet );
+
+	// 2x2 box filter into an image of half the size, a side of 1 stays 1, the destination has no padding between rows
+	// with sRGB the color channels of 3 and 4 channel images are averaged in linear space, alpha never is
+	void Downsample2x( const std::byte *source, const CSize &sourceSize, const u32 sourcePitch, const u8 channels, const bool sRGB, std::byte *destination );
+
+	void ExpandRGBToRGBA( const std::byte *source, std::byte *destination, const size_t pixelCount );
+
+	void SwizzleRGBAToBGRA( std::byte *pixels, const size_t pixelCount );
+
+	void PremultiplyAlpha( std::byte *pixels, const size_t pixelCount );
+
+	void FlipVertically( std::byte *pixels, const u32 pitch, const u32 height );
+
+	[[nodiscard]] std::shared_ptr<CImage> Downsample2x( const CImage &image, const bool sRGB );
+
+	[[nodiscard]] std::shared_ptr<CImage> ExpandRGBToRGBA( const CImage &image );
+}
\ No newline at end of file
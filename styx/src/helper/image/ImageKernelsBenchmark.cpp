@@ -0,0 +1,133 @@
+#include "ImageKernelsBenchmark.hpp"
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "external/stb/stb_image_resize.h"
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/core/Types.hpp"
+
+#include "src/helper/CSize.hpp"
+
+#include "src/helper/image/ImageKernels.hpp"
+
+namespace ImageKernelsBenchmark
+{
+	namespace
+	{
+		constexpr u32 ImageSide		{ 2048 };
+		constexpr u32 Repetitions	{ 10 };
+
+		// average over the repetitions in milliseconds
+		f32 Measure( const std::function<void()> &kernel )
+		{
+			// warms up the caches and builds the lookup tables
+			kernel();
+
+			const auto start = std::chrono::steady_clock::now();
+
+			for( u32 i = 0; i < Repetitions; i++ )
+			{
+				kernel();
+			}
+
+			return( std::chrono::duration<f32, std::milli>( std::chrono::steady_clock::now() - start ).count() / Repetitions );
+		}
+
+		void LogTime( const std::string &name, const std::string &implementation, const f32 time, const f32 baseline )
+		{
+			logINFO( "{0:<24} {1:<8} : {2:8.3f} ms ( {3:5.2f}x )", name, implementation, time, baseline / time );
+		}
+
+		// the scalar kernel is the baseline, unless there is an stb path to compare against
+		void Compare( const std::string &name, const std::function<void()> &kernel, const std::string &stbName = {}, const std::function<void()> &stbPath = {} )
+		{
+			const auto instructionSet = ImageKernels::InstructionSet();
+
+			ImageKernels::ForceInstructionSet( ImageKernels::EInstructionSet::SCALAR );
+
+			const f32 scalarTime = Measure( kernel );
+
+			f32 baseline = scalarTime;
+
+			if( stbPath )
+			{
+				baseline = Measure( stbPath );
+
+				LogTime( name, stbName, baseline, baseline );
+			}
+
+			LogTime( name, ImageKernels::InstructionSetName( ImageKernels::EInstructionSet::SCALAR ), scalarTime, baseline );
+
+			if( ImageKernels::EInstructionSet::SCALAR != instructionSet )
+			{
+				ImageKernels::ForceInstructionSet( instructionSet );
+
+				LogTime( name, ImageKernels::InstructionSetName( instructionSet ), Measure( kernel ), baseline );
+			}
+		}
+	}
+
+	void Run()
+	{
+		logINFO( "benchmarking the image kernels on {0}x{0} pixels, the processor supports {1}", ImageSide, ImageKernels::InstructionSetName( ImageKernels::InstructionSet() ) );
+
+		const CSize size { ImageSide, ImageSide };
+
+		const size_t pixelCount = static_cast<size_t>( ImageSide ) * ImageSide;
+
+		// a gradient with noise, so neither the cache nor the branch predictor gets an easy time
+		std::vector<std::byte> rgba( pixelCount * 4 );
+		std::vector<std::byte> rgb( pixelCount * 3 );
+
+		u32 seed { 0x5717 };
+
+		for( size_t i = 0; i < rgba.size(); i++ )
+		{
+			seed = ( seed * 1664525u ) + 1013904223u;
+
+			rgba[ i ] = static_cast<std::byte>( ( ( i / 4 ) % ImageSide ) / 8 + ( seed >> 28 ) );
+		}
+
+		std::copy( std::cbegin( rgba ), std::cbegin( rgba ) + rgb.size(), std::begin( rgb ) );
+
+		std::vector<std::byte> work( rgba.size() );
+		std::vector<std::byte> half( pixelCount );
+
+		const auto source	= reinterpret_cast<const unsigned char*>( rgba.data() );
+		const auto halfData	= reinterpret_cast<unsigned char*>( half.data() );
+
+		Compare( "downsample",
+				 [ & ] { ImageKernels::Downsample2x( rgba.data(), size, ImageSide * 4, 4, false, half.data() ); },
+				 "stbir", [ & ] { stbir_resize_uint8( source, ImageSide, ImageSide, 0, halfData, ImageSide / 2, ImageSide / 2, 0, 4 ); } );
+
+		Compare( "downsample sRGB",
+				 [ & ] { ImageKernels::Downsample2x( rgba.data(), size, ImageSide * 4, 4, true, half.data() ); },
+				 "stbir", [ & ] { stbir_resize_uint8_srgb( source, ImageSide, ImageSide, 0, halfData, ImageSide / 2, ImageSide / 2, 0, 4, 3, 0 ); } );
+
+		// the copy row by row is what loading an image did before
+		Compare( "flip vertically",
+				 [ & ] { ImageKernels::FlipVertically( work.data(), ImageSide * 4, ImageSide ); },
+				 "row copy", [ & ] {
+					for( u32 row = 0; row < ImageSide; ++row )
+					{
+						const std::byte *sourceRow = rgba.data() + ( static_cast<size_t>( ImageSide ) * 4 * ( ImageSide - 1 - row ) );
+
+						std::copy( sourceRow, sourceRow + ( ImageSide * 4 ), work.data() + ( static_cast<size_t>( ImageSide ) * 4 * row ) );
+					}
+				 } );
+
+		// these were left to the driver, so there is no stb path to compare against
+		Compare( "expand RGB to RGBA", [ & ] { ImageKernels::ExpandRGBToRGBA( rgb.data(), work.data(), pixelCount ); } );
+
+		Compare( "swizzle RGBA to BGRA", [ & ] { ImageKernels::SwizzleRGBAToBGRA( work.data(), pixelCount ); } );
+
+		Compare( "premultiply alpha", [ & ] {
+			std::copy( std::cbegin( rgba ), std::cend( rgba ), std::begin( work ) );
+			ImageKernels::PremultiplyAlpha( work.data(), pixelCount );
+		} );
+	}
+}
\ No newline at end of file
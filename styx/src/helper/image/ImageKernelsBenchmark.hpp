@@ -0,0 +1,7 @@
+#pragma once
+
+namespace ImageKernelsBenchmark
+{
+	// times the scalar and SSE4.1 image kernels and the stb paths they replace on a synthetic image and logs the timings
+	void Run();
+}
\ No newline at end of file
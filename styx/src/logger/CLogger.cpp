@@ -6,12 +6,16 @@ CLogger::TLogBuffer CLogger::m_logBuffer;
 
 std::list<std::unique_ptr<CLogger::CLogTarget>> CLogger::m_logTargets;
 
+std::mutex CLogger::m_mutex;
+
 void CLogger::Log( e_loglevel logLevel, const std::string &message )
 {
 	static const std::chrono::high_resolution_clock::time_point first = std::chrono::high_resolution_clock::now();
 
 	const std::chrono::milliseconds	diff = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::high_resolution_clock::now() - first );
 
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
 	const auto &logEntry = m_logBuffer.emplace_back( std::make_unique<CLogEntry>( diff, logLevel, message ) );
 	
 	for( const auto &target : m_logTargets )
@@ -43,6 +47,8 @@ const std::string CLogger::LogLevelToString( e_loglevel level )
 
 void CLogger::Destroy()
 {
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
 	m_logBuffer.clear();
 }
 
@@ -5,6 +5,7 @@
 #include <memory>
 #include <list>
 #include <sstream>
+#include <mutex>
 
 #include "external/fmt/format.h"
 
@@ -106,4 +107,7 @@ private:
 	static TLogBuffer m_logBuffer;
 
 	static std::list<std::unique_ptr<CLogTarget>> m_logTargets;
+
+	// resources get decoded on worker threads, which log too
+	static std::mutex m_mutex;
 };
@@ -1,9 +1,11 @@
 #include "CBufferObject.hpp"
 
+#include "src/renderer/CGLState.hpp"
+
 CBufferObject::~CBufferObject()
 {
 	if( glIsBuffer( GLID ) == GL_TRUE )
 	{
-		glDeleteBuffers( 1, &GLID );
+		CGLState::DeleteBuffer( GLID );
 	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "src/core/Types.hpp"
+
 #include "src/renderer/GL.h"
 
 class CBufferObject final
@@ -26,7 +28,29 @@ public:
 	template<typename T>
 	void Data( const typename std::vector<T> &vector )
 	{
-		glNamedBufferData( GLID, vector.size() * sizeof( T ), vector.data(), m_usage );
+		m_size = vector.size() * sizeof( T );
+
+		glNamedBufferData( GLID, m_size, vector.data(), m_usage );
+	}
+
+	// in bytes, of the data last handed to the buffer
+	[[nodiscard]] u64 Size() const
+	{
+		return( m_size );
+	}
+
+	// reads the whole content of the buffer back from the GPU
+	template<typename T>
+	[[nodiscard]] std::vector<T> Read() const
+	{
+		GLint size { 0 };
+		glGetNamedBufferParameteriv( GLID, GL_BUFFER_SIZE, &size );
+
+		std::vector<T> vector( size / sizeof( T ) );
+
+		glGetNamedBufferSubData( GLID, 0, vector.size() * sizeof( T ), vector.data() );
+
+		return( vector );
 	}
 	
 	~CBufferObject();
@@ -35,4 +59,6 @@ public:
 
 private:
 	const GLenum m_usage;
+
+	u64 m_size { 0 };
 };
\ No newline at end of file
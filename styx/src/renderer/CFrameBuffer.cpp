@@ -6,6 +6,8 @@
 
 #include "src/core/StyxException.hpp"
 
+#include "src/renderer/CGLState.hpp"
+
 const GLenum CFrameBuffer::attachmentColorTexture = GL_COLOR_ATTACHMENT0;
 
 CFrameBuffer::CFrameBuffer( const CSize &size ) :
@@ -30,6 +32,8 @@ CFrameBuffer::CFrameBuffer( const CSize &size ) :
 							size.width,
 							size.height );
 
+		m_colorTexture->AllocatedLevels( size, 1, GL_RGBA8, 1, 4 );
+
 		glNamedFramebufferTexture( GLID, attachmentColorTexture, m_colorTexture->GLID, 0 );
 	}
 
@@ -49,17 +53,19 @@ CFrameBuffer::~CFrameBuffer()
 {
 	glDeleteRenderbuffers( 1, &m_renderBufferId );
 
-	glDeleteFramebuffers( 1, &GLID );
+	CGLState::DeleteFramebuffer( GLID );
 }
 
 void CFrameBuffer::Bind() const
 {
-	glBindFramebuffer( GL_FRAMEBUFFER, GLID );
+	CGLState::BindFramebuffer( GLID );
+
+	CGLState::Viewport( 0, 0, Size.width, Size.height );
 }
 
 void CFrameBuffer::Unbind() const
 {
-	glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+	CGLState::BindFramebuffer( 0 );
 }
 
 void CFrameBuffer::Clear( const CColor &color ) const
@@ -1,5 +1,9 @@
 #include "CGLState.hpp"
 
+#include <algorithm>
+
+#include "src/logger/CLogger.hpp"
+
 bool	CGLState::cullFaceEnabed	{ false };
 GLenum	CGLState::cullFaceMode		{ GL_NONE };
 
@@ -20,6 +24,20 @@ GLuint CGLState::boundVertexArray	{ 0 };
 
 GLboolean CGLState::depthMaskFlag	{ GL_TRUE };
 
+std::unordered_map<GLuint, std::unordered_map<GLint, CGLState::TUniformValue>> CGLState::uniformValues;
+
+std::map<std::tuple<GLenum, GLuint>, CGLState::TIndexedBuffer> CGLState::indexedBuffers;
+
+GLuint CGLState::boundPixelUnpackBuffer	{ 0 };
+
+GLint CGLState::unpackAlignment	{ 4 };
+
+GLuint CGLState::boundFramebuffer	{ 0 };
+
+std::array<GLint, 4> CGLState::viewport { { 0, 0, 0, 0 } };
+
+CGLState::SStatistics CGLState::statistics;
+
 void CGLState::CullFace( const bool culling, const GLenum mode )
 {
 	if( cullFaceEnabed != culling )
@@ -34,12 +52,27 @@ void CGLState::CullFace( const bool culling, const GLenum mode )
 		{
 			glDisable( GL_CULL_FACE );
 		}
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 
-	if( culling && ( cullFaceMode != mode ) )
+	if( culling )
 	{
-		cullFaceMode = mode;
-		glCullFace( mode );
+		if( cullFaceMode != mode )
+		{
+			cullFaceMode = mode;
+			glCullFace( mode );
+
+			statistics.issuedCalls++;
+		}
+		else
+		{
+			statistics.avoidedCalls++;
+		}
 	}
 }
 
@@ -49,6 +82,12 @@ void CGLState::PolygonMode( const GLenum mode )
 	{
 		polygonMode = mode;
 		glPolygonMode( GL_FRONT_AND_BACK, mode );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 }
 
@@ -66,15 +105,30 @@ void CGLState::Blending( const bool blending, const GLenum modeSrc, const GLenum
 		{
 			glDisable( GL_BLEND );
 		}
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 
-	if( blending && (	( blendModeSrc != modeSrc )
-						||
-						( blendModeDst != modeDst ) ) )
+	if( blending )
 	{
+		if(	( blendModeSrc != modeSrc )
+			||
+			( blendModeDst != modeDst ) )
+		{
 			blendModeSrc = modeSrc;
 			blendModeDst = modeDst;
 			glBlendFunc( modeSrc, modeDst );
+
+			statistics.issuedCalls++;
+		}
+		else
+		{
+			statistics.avoidedCalls++;
+		}
 	}
 }
 
@@ -84,6 +138,12 @@ void CGLState::BlendEquation( const GLenum mode )
 	{
 		blendEquation = mode;
 		glBlendEquation( mode );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 }
 
@@ -93,6 +153,12 @@ void CGLState::BindTextureToUnit( const GLuint texID, const GLuint unit )
 	{
 		textureUnits[ unit ] = texID;
 		glBindTextureUnit( unit, texID );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 }
 
@@ -102,6 +168,12 @@ void CGLState::BindSamplerToUnit( const GLuint samplerID, const GLuint unit )
 	{
 		samplerUnits[ unit ] = samplerID;
 		glBindSampler( unit, samplerID );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 }
 
@@ -111,6 +183,12 @@ void CGLState::UseProgram( const GLuint program )
 	{
 		usedProgram = program;
 		glUseProgram( program );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 }
 
@@ -120,6 +198,12 @@ void CGLState::BindVertexArray( const GLuint vao )
 	{
 		boundVertexArray = vao;
 		glBindVertexArray( vao );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
 	}
 }
 
@@ -129,5 +213,370 @@ void CGLState::DepthMask( const GLboolean flag )
 	{
 		depthMaskFlag = flag;
 		glDepthMask( flag );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+bool CGLState::UpdateUniform( const GLint location, const TUniformValue &value )
+{
+	auto &programValues = uniformValues[ usedProgram ];
+
+	const auto it = programValues.find( location );
+
+	if( ( std::end( programValues ) != it ) && ( it->second == value ) )
+	{
+		statistics.avoidedCalls++;
+		return( false );
+	}
+
+	programValues[ location ] = value;
+
+	statistics.issuedCalls++;
+	return( true );
+}
+
+void CGLState::Uniform1i( const GLint location, const GLint value )
+{
+	if( UpdateUniform( location, value ) )
+	{
+		glUniform1i( location, value );
+	}
+}
+
+void CGLState::UniformMatrix4fv( const GLint location, const glm::mat4 &value )
+{
+	if( UpdateUniform( location, value ) )
+	{
+		glUniformMatrix4fv( location, 1, GL_FALSE, &value[ 0 ][ 0 ] );
+	}
+}
+
+void CGLState::BindBufferBase( const GLenum target, const GLuint index, const GLuint buffer )
+{
+	// a base binding is stored as a range with a size of 0, which is also what GL reports for it
+	const TIndexedBuffer binding { buffer, 0, 0 };
+
+	auto &boundBuffer = indexedBuffers[ { target, index } ];
+
+	if( boundBuffer != binding )
+	{
+		boundBuffer = binding;
+		glBindBufferBase( target, index, buffer );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+void CGLState::BindBufferRange( const GLenum target, const GLuint index, const GLuint buffer, const GLintptr offset, const GLsizeiptr size )
+{
+	const TIndexedBuffer binding { buffer, offset, size };
+
+	auto &boundBuffer = indexedBuffers[ { target, index } ];
+
+	if( boundBuffer != binding )
+	{
+		boundBuffer = binding;
+		glBindBufferRange( target, index, buffer, offset, size );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+void CGLState::BindPixelUnpackBuffer( const GLuint buffer )
+{
+	if( buffer != boundPixelUnpackBuffer )
+	{
+		boundPixelUnpackBuffer = buffer;
+		glBindBuffer( GL_PIXEL_UNPACK_BUFFER, buffer );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+void CGLState::UnpackAlignment( const GLint alignment )
+{
+	if( alignment != unpackAlignment )
+	{
+		unpackAlignment = alignment;
+		glPixelStorei( GL_UNPACK_ALIGNMENT, alignment );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+void CGLState::BindFramebuffer( const GLuint framebuffer )
+{
+	if( framebuffer != boundFramebuffer )
+	{
+		boundFramebuffer = framebuffer;
+		glBindFramebuffer( GL_FRAMEBUFFER, framebuffer );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+void CGLState::Viewport( const GLint x, const GLint y, const GLsizei width, const GLsizei height )
+{
+	const std::array<GLint, 4> newViewport { { x, y, width, height } };
+
+	if( newViewport != viewport )
+	{
+		viewport = newViewport;
+		glViewport( x, y, width, height );
+
+		statistics.issuedCalls++;
+	}
+	else
+	{
+		statistics.avoidedCalls++;
+	}
+}
+
+void CGLState::DeleteProgram( const GLuint program )
+{
+	// a program which is in use only gets flagged for deletion, so release it to free its name
+	if( program == usedProgram )
+	{
+		usedProgram = 0;
+		glUseProgram( 0 );
+	}
+
+	uniformValues.erase( program );
+
+	glDeleteProgram( program );
+}
+
+void CGLState::DeleteVertexArray( const GLuint vao )
+{
+	if( vao == boundVertexArray )
+	{
+		boundVertexArray = 0;
+	}
+
+	glDeleteVertexArrays( 1, &vao );
+}
+
+void CGLState::DeleteBuffer( const GLuint buffer )
+{
+	// GL reverts every binding of a deleted buffer to 0
+	for( auto &[ key, boundBuffer ] : indexedBuffers )
+	{
+		if( std::get<0>( boundBuffer ) == buffer )
+		{
+			boundBuffer = { 0, 0, 0 };
+		}
+	}
+
+	if( buffer == boundPixelUnpackBuffer )
+	{
+		boundPixelUnpackBuffer = 0;
+	}
+
+	glDeleteBuffers( 1, &buffer );
+}
+
+void CGLState::DeleteTexture( const GLuint texID )
+{
+	std::replace( std::begin( textureUnits ), std::end( textureUnits ), texID, 0u );
+
+	glDeleteTextures( 1, &texID );
+}
+
+void CGLState::DeleteSampler( const GLuint samplerID )
+{
+	std::replace( std::begin( samplerUnits ), std::end( samplerUnits ), samplerID, 0u );
+
+	glDeleteSamplers( 1, &samplerID );
+}
+
+void CGLState::DeleteFramebuffer( const GLuint framebuffer )
+{
+	if( framebuffer == boundFramebuffer )
+	{
+		boundFramebuffer = 0;
+	}
+
+	glDeleteFramebuffers( 1, &framebuffer );
+}
+
+const CGLState::SStatistics &CGLState::Statistics()
+{
+	return( statistics );
+}
+
+void CGLState::ResetStatistics()
+{
+	statistics = SStatistics();
+}
+
+#ifdef STYX_DEBUG
+	bool CGLState::Verify()
+	{
+		bool inSync = true;
+
+		const auto check = [ &inSync ]( const std::string &name, const s64 actual, const s64 shadowed )
+		{
+			if( actual != shadowed )
+			{
+				logERROR( "GL state desync: {0} is {1} but the shadow has {2}", name, actual, shadowed );
+				inSync = false;
+			}
+		};
+
+		const auto getInteger = []( const GLenum pname )
+		{
+			GLint value;
+			glGetIntegerv( pname, &value );
+			return( static_cast<s64>( value ) );
+		};
+
+		const auto enumValue = []( const GLenum value )
+		{
+			return( static_cast<s64>( static_cast<GLuint>( value ) ) );
+		};
+
+		check( "GL_CULL_FACE", glIsEnabled( GL_CULL_FACE ) == GL_TRUE, cullFaceEnabed );
+		if( cullFaceEnabed && ( GL_NONE != cullFaceMode ) )
+		{
+			check( "GL_CULL_FACE_MODE", getInteger( GL_CULL_FACE_MODE ), enumValue( cullFaceMode ) );
+		}
+
+		{
+			std::array<GLint, 2> polygonModes;
+			glGetIntegerv( GL_POLYGON_MODE, polygonModes.data() );
+			check( "GL_POLYGON_MODE", polygonModes[ 0 ], enumValue( polygonMode ) );
+		}
+
+		check( "GL_BLEND", glIsEnabled( GL_BLEND ) == GL_TRUE, blendingEnabed );
+		if( blendingEnabed && ( GL_NONE != blendModeSrc ) )
+		{
+			check( "GL_BLEND_SRC_RGB", getInteger( GL_BLEND_SRC_RGB ), enumValue( blendModeSrc ) );
+			check( "GL_BLEND_DST_RGB", getInteger( GL_BLEND_DST_RGB ), enumValue( blendModeDst ) );
+		}
+
+		if( GL_NONE != blendEquation )
+		{
+			check( "GL_BLEND_EQUATION_RGB", getInteger( GL_BLEND_EQUATION_RGB ), enumValue( blendEquation ) );
+		}
+
+		{
+			GLboolean depthWriteMask;
+			glGetBooleanv( GL_DEPTH_WRITEMASK, &depthWriteMask );
+			check( "GL_DEPTH_WRITEMASK", depthWriteMask == GL_TRUE, depthMaskFlag == GL_TRUE );
+		}
+
+		check( "GL_CURRENT_PROGRAM", getInteger( GL_CURRENT_PROGRAM ), usedProgram );
+		check( "GL_VERTEX_ARRAY_BINDING", getInteger( GL_VERTEX_ARRAY_BINDING ), boundVertexArray );
+		check( "GL_PIXEL_UNPACK_BUFFER_BINDING", getInteger( GL_PIXEL_UNPACK_BUFFER_BINDING ), boundPixelUnpackBuffer );
+		check( "GL_UNPACK_ALIGNMENT", getInteger( GL_UNPACK_ALIGNMENT ), unpackAlignment );
+		check( "GL_DRAW_FRAMEBUFFER_BINDING", getInteger( GL_DRAW_FRAMEBUFFER_BINDING ), boundFramebuffer );
+		check( "GL_READ_FRAMEBUFFER_BINDING", getInteger( GL_READ_FRAMEBUFFER_BINDING ), boundFramebuffer );
+
+		if( 0 != viewport[ 2 ] )
+		{
+			std::array<GLint, 4> actualViewport;
+			glGetIntegerv( GL_VIEWPORT, actualViewport.data() );
+			for( u8 i = 0; i < 4; i++ )
+			{
+				check( fmt::format( "GL_VIEWPORT[{0}]", i ), actualViewport[ i ], viewport[ i ] );
+			}
+		}
+
+		{
+			// texture and sampler bindings can only be queried for the active texture unit
+			const s64 activeTexture = getInteger( GL_ACTIVE_TEXTURE );
+
+			for( GLuint unit = 0; unit < CShaderProgramCompiler::RequiredCombinedTextureImageUnits; unit++ )
+			{
+				glActiveTexture( static_cast<GLenum>( static_cast<GLuint>( GL_TEXTURE0 ) + unit ) );
+
+				if( 0 != textureUnits[ unit ] )
+				{
+					// the target of the texture is unknown here, so it has to be bound to one of them
+					const std::array<GLenum, 3> bindings { { GL_TEXTURE_BINDING_2D, GL_TEXTURE_BINDING_2D_ARRAY, GL_TEXTURE_BINDING_CUBE_MAP } };
+
+					if( std::none_of( std::cbegin( bindings ), std::cend( bindings ), [ & ]( const GLenum binding ) { return( getInteger( binding ) == textureUnits[ unit ] ); } ) )
+					{
+						check( fmt::format( "texture unit {0}", unit ), 0, textureUnits[ unit ] );
+					}
+				}
+
+				check( fmt::format( "GL_SAMPLER_BINDING[{0}]", unit ), getInteger( GL_SAMPLER_BINDING ), samplerUnits[ unit ] );
+			}
+
+			glActiveTexture( static_cast<GLenum>( activeTexture ) );
+		}
+
+		for( const auto & [ key, boundBuffer ] : indexedBuffers )
+		{
+			const auto & [ target, index ] = key;
+			const auto & [ buffer, offset, size ] = boundBuffer;
+
+			if( GL_UNIFORM_BUFFER == target )
+			{
+				GLint64 actualBuffer;
+				GLint64 actualOffset;
+				GLint64 actualSize;
+				glGetInteger64i_v( GL_UNIFORM_BUFFER_BINDING, index, &actualBuffer );
+				glGetInteger64i_v( GL_UNIFORM_BUFFER_START, index, &actualOffset );
+				glGetInteger64i_v( GL_UNIFORM_BUFFER_SIZE, index, &actualSize );
+
+				check( fmt::format( "GL_UNIFORM_BUFFER_BINDING[{0}]", index ), actualBuffer, buffer );
+				check( fmt::format( "GL_UNIFORM_BUFFER_START[{0}]", index ), actualOffset, offset );
+				check( fmt::format( "GL_UNIFORM_BUFFER_SIZE[{0}]", index ), actualSize, size );
+			}
+		}
+
+		const auto programValues = uniformValues.find( usedProgram );
+
+		if( ( 0 != usedProgram ) && ( std::end( uniformValues ) != programValues ) )
+		{
+			for( const auto & [ location, value ] : programValues->second )
+			{
+				if( std::holds_alternative<GLint>( value ) )
+				{
+					GLint actual;
+					glGetUniformiv( usedProgram, location, &actual );
+					check( fmt::format( "uniform {0} of program {1}", location, usedProgram ), actual, std::get<GLint>( value ) );
+				}
+				else
+				{
+					glm::mat4 actual;
+					glGetUniformfv( usedProgram, location, &actual[ 0 ][ 0 ] );
+					if( actual != std::get<glm::mat4>( value ) )
+					{
+						logERROR( "GL state desync: matrix uniform {0} of program {1} differs from the shadow", location, usedProgram );
+						inSync = false;
+					}
+				}
+			}
+		}
+
+		return( inSync );
 	}
-}
\ No newline at end of file
+#endif
\ No newline at end of file
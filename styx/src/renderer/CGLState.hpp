@@ -1,14 +1,33 @@
 #pragma once
 
 #include <array>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <variant>
+
+#include <glm/glm.hpp>
 
 #include "src/renderer/GL.h"
 
+#include "src/core/Types.hpp"
+
 #include "src/renderer/shader/CShaderProgramCompiler.hpp"
 
+/**
+ * Shadow of the OpenGL context state.
+ * Every state change goes through here so redundant calls never reach the driver.
+ * Objects have to be deleted via the Delete* functions so no stale names stay in the shadow.
+ */
 class CGLState final
 {
 public:
+	struct SStatistics final
+	{
+		u64 issuedCalls		{ 0 };
+		u64 avoidedCalls	{ 0 };
+	};
+
 	static void CullFace( const bool culling, const GLenum mode );
 	static void PolygonMode( const GLenum mode );
 
@@ -26,6 +45,39 @@ public:
 
 	static void DepthMask( const GLboolean flag );
 
+	/** uniforms are set on the currently used program and cached per program and location */
+	static void Uniform1i( const GLint location, const GLint value );
+	static void UniformMatrix4fv( const GLint location, const glm::mat4 &value );
+
+	static void BindBufferBase( const GLenum target, const GLuint index, const GLuint buffer );
+	static void BindBufferRange( const GLenum target, const GLuint index, const GLuint buffer, const GLintptr offset, const GLsizeiptr size );
+
+	/** has to be reset to 0 after uploading, otherwise every following texture upload reads from the buffer */
+	static void BindPixelUnpackBuffer( const GLuint buffer );
+
+	/** 1, 2, 4 or 8, the rows of uploaded pixels start at multiples of it */
+	static void UnpackAlignment( const GLint alignment );
+
+	/** binds to GL_FRAMEBUFFER, so this sets the draw and the read framebuffer */
+	static void BindFramebuffer( const GLuint framebuffer );
+
+	static void Viewport( const GLint x, const GLint y, const GLsizei width, const GLsizei height );
+
+	static void DeleteProgram( const GLuint program );
+	static void DeleteVertexArray( const GLuint vao );
+	static void DeleteBuffer( const GLuint buffer );
+	static void DeleteTexture( const GLuint texID );
+	static void DeleteSampler( const GLuint samplerID );
+	static void DeleteFramebuffer( const GLuint framebuffer );
+
+	static const SStatistics &Statistics();
+	static void ResetStatistics();
+
+	#ifdef STYX_DEBUG
+		/** compares the shadow against the real context state and logs every desync */
+		static bool Verify();
+	#endif
+
 private:
 	CGLState() {};
 
@@ -48,4 +100,24 @@ private:
 	static GLuint boundVertexArray;
 
 	static GLboolean depthMaskFlag;
-};
+
+	using TUniformValue = std::variant<GLint, glm::mat4>;
+
+	static std::unordered_map<GLuint, std::unordered_map<GLint, TUniformValue>> uniformValues;
+
+	using TIndexedBuffer = std::tuple<GLuint, GLintptr, GLsizeiptr>;
+
+	static std::map<std::tuple<GLenum, GLuint>, TIndexedBuffer> indexedBuffers;
+
+	static GLuint boundPixelUnpackBuffer;
+
+	static GLint unpackAlignment;
+
+	static GLuint boundFramebuffer;
+
+	static std::array<GLint, 4> viewport;
+
+	static SStatistics statistics;
+
+	static bool UpdateUniform( const GLint location, const TUniformValue &value );
+};
\ No newline at end of file
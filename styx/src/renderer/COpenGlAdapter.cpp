@@ -101,6 +101,31 @@ COpenGlAdapter::COpenGlAdapter( const CSettings &p_settings )
 		THROW_STYX_EXCEPTION( "at least one required extension is missing" );
 	}
 
+	if( isSupported( supportedOpenGLExtensions, GLextension::GL_KHR_parallel_shader_compile ) )
+	{
+		m_parallelShaderCompile = true;
+
+		// let the driver decide how many threads it wants to use
+		glMaxShaderCompilerThreadsKHR( 0xFFFFFFFF );
+
+		logINFO( "{0} is available, shaders will be compiled in the background", glbinding::aux::Meta::getString( GLextension::GL_KHR_parallel_shader_compile ) );
+	}
+	else
+	{
+		logINFO( "{0} is not available, shaders will be compiled synchronously", glbinding::aux::Meta::getString( GLextension::GL_KHR_parallel_shader_compile ) );
+	}
+
+	if( isSupported( supportedOpenGLExtensions, GLextension::GL_EXT_texture_compression_s3tc ) )
+	{
+		m_textureCompressionS3TC = true;
+
+		logINFO( "{0} is available, BC1 and BC3 textures will be uploaded compressed", glbinding::aux::Meta::getString( GLextension::GL_EXT_texture_compression_s3tc ) );
+	}
+	else
+	{
+		logINFO( "{0} is not available, BC1 and BC3 textures will be decompressed", glbinding::aux::Meta::getString( GLextension::GL_EXT_texture_compression_s3tc ) );
+	}
+
 	const bool supports_GL_NVX_gpu_memory_info = isSupported( supportedOpenGLExtensions, GLextension::GL_NVX_gpu_memory_info );
 	const bool supports_GL_ATI_meminfo         = isSupported( supportedOpenGLExtensions, GLextension::GL_ATI_meminfo );
 
@@ -195,6 +220,16 @@ GLint COpenGlAdapter::AnisotropicLevel() const
 	return( m_anisotropicLevel );
 }
 
+bool COpenGlAdapter::ParallelShaderCompile() const
+{
+	return( m_parallelShaderCompile );
+}
+
+bool COpenGlAdapter::TextureCompressionS3TC() const
+{
+	return( m_textureCompressionS3TC );
+}
+
 bool COpenGlAdapter::isSupported( const std::set<GLextension> &extensions, const GLextension extension ) const
 {
 	if( extensions.find( extension ) != std::end( extensions ) )
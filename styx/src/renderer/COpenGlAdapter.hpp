@@ -18,6 +18,12 @@ public:
 	GLint MaxCubeMapTextureSize() const;
 	
 	GLint AnisotropicLevel() const;
+
+	// shaders and programs can be compiled in the background and polled for completion
+	bool ParallelShaderCompile() const;
+
+	// BC1 and BC3 need the extension, BC4, BC5 and BC7 are part of the core profile
+	bool TextureCompressionS3TC() const;
 	
 private:
 	bool isSupported( const std::set<GLextension> &extensions, const GLextension extension ) const;
@@ -26,4 +32,8 @@ private:
 	GLint m_maxCubeMapTextureSize;
 	
 	GLint m_anisotropicLevel;
+
+	bool m_parallelShaderCompile { false };
+
+	bool m_textureCompressionS3TC { false };
 };
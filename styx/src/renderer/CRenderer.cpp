@@ -1,5 +1,8 @@
 #include "CRenderer.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -15,13 +18,15 @@
 
 CRenderer::CRenderer( const CSettings &settings, const CFileSystem &filesystem, CResources &resources ) :
 	OpenGlAdapter( settings ),
-	ShaderCompiler(),
-	ShaderProgramCompiler( ShaderCompiler ),
+	ShaderCompiler( OpenGlAdapter ),
+	ShaderProgramCompiler( filesystem, OpenGlAdapter, ShaderCompiler ),
+	TextureStreamer( settings ),
+	MaterialBlockArena { std::make_shared<CMaterialBlockArena>() },
 	m_settings { settings },
 	m_resources { resources },
-	m_textureCache { std::make_shared<CTextureCache>( filesystem, OpenGlAdapter ) },
+	m_textureCache { std::make_shared<CTextureCache>( filesystem, OpenGlAdapter, TextureStreamer ) },
 	m_modelCache { std::make_shared<CModelCache>( filesystem, resources ) },
-	m_materialCache { std::make_shared<CMaterialCache>( filesystem, resources, ShaderProgramCompiler.DummyShaderProgram() ) },
+	m_materialCache { std::make_shared<CMaterialCache>( filesystem, resources, ShaderProgramCompiler, MaterialBlockArena ) },
 	m_shaderCache { std::make_shared<CShaderCache>( filesystem, ShaderCompiler ) },
 	m_shaderProgramCache { std::make_shared<CShaderProgramCache>( filesystem, resources, ShaderCompiler, ShaderProgramCompiler ) }
 {
@@ -135,17 +140,26 @@ void CRenderer::RenderPackageToFramebuffer( const RenderPackage &renderPackage,
 	
 	UpdateRenderPackageUniformBuffers( renderPackage );
 
+	const u64 frame = TextureStreamer.Frame();
+
+	const f16 framebufferHeight = static_cast<f16>( framebuffer.Size.height );
+
 	for( const auto &layer : renderPackage.RenderLayers )
 	{
 		UpdateRenderLayerUniformBuffers( layer );
 		
 		auto const &view = layer.View;
+
+		const f16 projectionScale = layer.ProjectionScale();
+
+		const bool orthographic = layer.Orthographic();
 		
 		const CMesh * currentMesh = nullptr;
 		const CMaterial * currentMaterial = nullptr;
+		const CMaterialInstance * currentMaterialInstance = nullptr;
 		const CShaderProgram * currentShader = nullptr;
 
-		for( const auto & [ blending, mesh, material, shaderProgram, modelMatrix, viewDepth ] : layer.drawCommands )
+		for( const auto & [ blending, mesh, material, materialInstance, shaderProgram, modelMatrix, viewDepth ] : layer.drawCommands )
 		{
 			if( currentMesh != mesh )
 			{
@@ -156,26 +170,52 @@ void CRenderer::RenderPackageToFramebuffer( const RenderPackage &renderPackage,
 					currentMaterial = material;
 					material->Activate();
 
+					currentMaterialInstance = nullptr;
+
 					currentShader = shaderProgram;
 				}
 
+				// instances of the same material only differ in their material block
+				if( currentMaterialInstance != materialInstance )
+				{
+					currentMaterialInstance = materialInstance;
+
+					if( nullptr != materialInstance )
+					{
+						materialInstance->Activate();
+					}
+					else
+					{
+						material->BindMaterialBlock();
+					}
+				}
+
 				mesh->Bind();
 			}
 
+			{
+				// the view depth is the squared distance to the view
+				const f16 distance = orthographic ? 1.0f : std::sqrt( viewDepth );
+
+				const f16 boundingSphereRadius = glm::length( glm::mat3( modelMatrix ) * mesh->BoundingSphereRadiusVector );
+
+				mesh->RequestTextureMips( frame, ( boundingSphereRadius * projectionScale * framebufferHeight ) / std::max( distance, 0.001f ) );
+			}
+
 			for( const auto & [ location, engineUniform ] : currentShader->RequiredEngineUniforms() )
 			{
 				switch( engineUniform )
 				{
 					case EEngineUniform::modelViewProjectionMatrix:
-						glUniformMatrix4fv( location, 1, GL_FALSE, &( view.ViewProjectionMatrix * modelMatrix )[ 0 ][ 0 ] );
+						CGLState::UniformMatrix4fv( location, view.ViewProjectionMatrix * modelMatrix );
 						break;
 
 					case EEngineUniform::modelViewMatrix:
-						glUniformMatrix4fv( location, 1, GL_FALSE, &( view.ViewMatrix * modelMatrix )[ 0 ][ 0 ] );
+						CGLState::UniformMatrix4fv( location, view.ViewMatrix * modelMatrix );
 						break;
 
 					case EEngineUniform::modelMatrix:
-						glUniformMatrix4fv( location, 1, GL_FALSE, &modelMatrix[ 0 ][ 0 ] );
+						CGLState::UniformMatrix4fv( location, modelMatrix );
 						break;
 				}
 			}
@@ -184,6 +224,10 @@ void CRenderer::RenderPackageToFramebuffer( const RenderPackage &renderPackage,
 		}
 	}
 
+	#ifdef STYX_DEBUG
+		CGLState::Verify();
+	#endif
+
 	framebuffer.Unbind();
 }
 
@@ -19,6 +19,7 @@
 #include "src/renderer/RenderPackage.hpp"
 
 #include "src/renderer/texture/CTextureCache.hpp"
+#include "src/renderer/texture/CTextureStreamer.hpp"
 #include "src/renderer/model/CModelCache.hpp"
 #include "src/renderer/material/CMaterialCache.hpp"
 
@@ -48,6 +49,10 @@ public:
 	CShaderCompiler			ShaderCompiler;
 	CShaderProgramCompiler	ShaderProgramCompiler;
 
+	CTextureStreamer TextureStreamer;
+
+	const std::shared_ptr<CMaterialBlockArena> MaterialBlockArena;
+
 	void RenderPackageToFramebuffer( const RenderPackage &renderPackage, const CFrameBuffer &framebuffer ) const;
 
 	// presents the framebuffer on screen
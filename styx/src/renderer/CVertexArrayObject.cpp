@@ -280,10 +280,15 @@ CVertexArrayObject::~CVertexArrayObject()
 {
 	if( glIsVertexArray( GLID ) )
 	{
-		glDeleteVertexArrays( 1, &GLID );
+		CGLState::DeleteVertexArray( GLID );
 	}
 }
 
+u64 CVertexArrayObject::Size() const
+{
+	return( m_vbo.Size() + m_ibo.Size() );
+}
+
 void CVertexArrayObject::Bind() const
 {
 	CGLState::BindVertexArray( GLID );
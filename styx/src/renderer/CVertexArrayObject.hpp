@@ -31,6 +31,21 @@ public:
 		m_ibo.Data( geometry.Indices );
 	}
 
+	template<typename T>
+	[[nodiscard]] Geometry<T> ReadGeometry() const
+	{
+		Geometry<T> geometry;
+
+		geometry.Mode = m_mode;
+		geometry.Vertices = m_vbo.Read<T>();
+		geometry.Indices = m_ibo.Read<u32>();
+
+		return( geometry );
+	}
+
+	// in bytes, of the vertices and indices in video memory
+	[[nodiscard]] u64 Size() const;
+
 	void Bind() const;
 
 	void Draw() const;
@@ -4,5 +4,6 @@ enum class EUniformBufferLocation : GLuint
 {
 	VIEW = 0,
 	TIME = 1,
-	FRAMEBUFFER
+	FRAMEBUFFER,
+	MATERIAL
 };
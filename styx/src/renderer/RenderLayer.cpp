@@ -2,6 +2,17 @@
 
 #include <algorithm>
 
+f16 RenderLayer::ProjectionScale() const
+{
+	// 1 / tan( fovy / 2 ) for a perspective projection
+	return( View.ProjectionMatrix[ 1 ][ 1 ] );
+}
+
+bool RenderLayer::Orthographic() const
+{
+	return( 1.0f == View.ProjectionMatrix[ 3 ][ 3 ] );
+}
+
 void RenderLayer::SortDrawCommands()
 {
 	// TODO multithreaded?
@@ -24,7 +35,16 @@ void RenderLayer::SortDrawCommands()
 			}
 			else
 			{
-				if( a.material > b.material )
+				// every variant is an own program, so grouping by program first keeps the program switches low
+				if( a.shaderProgram > b.shaderProgram )
+				{
+					return( true );
+				}
+				else if( a.shaderProgram < b.shaderProgram )
+				{
+					return( false );
+				}
+				else if( a.material > b.material )
 				{
 					return( true );
 				}
@@ -32,6 +52,14 @@ void RenderLayer::SortDrawCommands()
 				{
 					return( false );
 				}
+				else if( a.materialInstance > b.materialInstance )
+				{
+					return( true );
+				}
+				else if( a.materialInstance < b.materialInstance )
+				{
+					return( false );
+				}
 				else
 				{
 					return( a.viewDepth < b.viewDepth );
@@ -14,13 +14,21 @@ struct RenderLayer final
 		glm::mat4 ViewMatrix;
 		glm::mat4 ViewProjectionMatrix;
 	} View;
+
+	// the reciprocal of half of the height of the viewport in view space at a distance of 1,
+	// so a size there times this is the fraction of half of the viewport height which it covers
+	f16 ProjectionScale() const;
+
+	// the size on the screen doesn't depend on the distance with an orthographic projection
+	bool Orthographic() const;
 	
 	struct DrawCommand
 	{
-		DrawCommand( bool p_blending, const CMesh * p_mesh, const CMaterial * p_material, const CShaderProgram * p_shaderProgram, const glm::mat4 &p_modelMatrix, f16 p_viewDepth ) :
+		DrawCommand( bool p_blending, const CMesh * p_mesh, const CMaterial * p_material, const CMaterialInstance * p_materialInstance, const CShaderProgram * p_shaderProgram, const glm::mat4 &p_modelMatrix, f16 p_viewDepth ) :
 			blending{ p_blending },
 			mesh{ p_mesh },
 			material{ p_material },
+			materialInstance{ p_materialInstance },
 			shaderProgram{ p_shaderProgram },
 			modelMatrix{ p_modelMatrix },
 			viewDepth{ p_viewDepth }
@@ -29,6 +37,7 @@ struct RenderLayer final
 		bool blending;
 		const CMesh * mesh;
 		const CMaterial * material;
+		const CMaterialInstance * materialInstance;
 		const CShaderProgram * shaderProgram;
 		glm::mat4 modelMatrix;
 		f16 viewDepth;
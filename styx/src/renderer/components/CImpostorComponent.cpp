@@ -0,0 +1,7 @@
+#include "CImpostorComponent.hpp"
+
+CImpostorComponent::CImpostorComponent( const std::shared_ptr<CEntity> &parent, const std::shared_ptr<const CImpostor> &impostor, const f16 screenSize ) :
+	CBaseComponent( parent ),
+	Impostor { impostor },
+	ScreenSize { screenSize }
+{}
\ No newline at end of file
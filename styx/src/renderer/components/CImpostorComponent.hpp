@@ -0,0 +1,23 @@
+#pragma once
+
+#include "src/scene/components/CBaseComponent.hpp"
+
+#include "src/renderer/impostor/CImpostor.hpp"
+
+// replaces the mesh of the CModelComponent with the impostor, as soon as the entity covers less than ScreenSize of the viewport height
+class CImpostorComponent final : public CBaseComponent
+{
+private:
+	CImpostorComponent(const CImpostorComponent& rhs);
+	CImpostorComponent& operator=(const CImpostorComponent& rhs);
+
+public:
+	CImpostorComponent( const std::shared_ptr<CEntity> &parent, const std::shared_ptr<const CImpostor> &impostor, const f16 screenSize );
+	~CImpostorComponent() {};
+
+	static const u16 Index = static_cast<u16>( EComponentIndex::IMPOSTOR );
+
+	std::shared_ptr<const CImpostor> Impostor;
+
+	f16 ScreenSize;
+};
\ No newline at end of file
@@ -1,6 +1,36 @@
 #include "CModelComponent.hpp"
 
+u32 CModelComponent::s_staticRevision = 0;
+
 CModelComponent::CModelComponent( const std::shared_ptr<CEntity> &parent, const std::shared_ptr<const CMesh> &mesh ) :
 	CBaseComponent( parent ),
 	Mesh { mesh }
-{}
\ No newline at end of file
+{}
+
+CModelComponent::~CModelComponent()
+{
+	if( m_static )
+	{
+		++s_staticRevision;
+	}
+}
+
+bool CModelComponent::Static() const
+{
+	return( m_static );
+}
+
+void CModelComponent::Static( const bool isStatic )
+{
+	if( m_static != isStatic )
+	{
+		m_static = isStatic;
+
+		++s_staticRevision;
+	}
+}
+
+bool CModelComponent::Batched() const
+{
+	return( m_batched );
+}
\ No newline at end of file
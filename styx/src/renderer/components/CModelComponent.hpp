@@ -7,15 +7,32 @@
 // TODO this implies it holds a model, but for the moment just holds a mesh, since we don't have models yet
 class CModelComponent final : public CBaseComponent
 {
+friend class CStaticBatches;
+
 private:
 	CModelComponent(const CModelComponent& rhs);
 	CModelComponent& operator=(const CModelComponent& rhs);
 
 public:
 	CModelComponent( const std::shared_ptr<CEntity> &parent, const std::shared_ptr<const CMesh> &mesh );
-	~CModelComponent() {};
+	~CModelComponent();
 
 	static const u16 Index = static_cast<u16>( EComponentIndex::MODEL );
 
 	std::shared_ptr<const CMesh> Mesh;
-};
+
+	// static entities promise not to move anymore, so their meshes can be merged into the batches of CStaticBatches
+	[[nodiscard]] bool Static() const;
+	void Static( const bool isStatic );
+
+	// true, when the mesh is drawn as part of a static batch
+	[[nodiscard]] bool Batched() const;
+
+private:
+	bool m_static { false };
+
+	bool m_batched { false };
+
+	// gets increased whenever the set of static components changes, so the batches know when to rebuild
+	static u32 s_staticRevision;
+};
\ No newline at end of file
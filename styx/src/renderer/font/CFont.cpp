@@ -1,5 +1,7 @@
 #include "CFont.hpp"
 
+#include <algorithm>
+
 CFont::CFont( const std::string &name, const u16 size, const CSize &atlasSize ) :
 	Name { name },
 	Size { size },
@@ -62,4 +64,30 @@ const stbtt_packedchar * CFont::PackedCharFromCodepoint( EFontWeight fontWeight,
 	}
 	
 	return( nullptr );
+}
+
+SMemoryUsage CFont::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage;
+
+	// the nodes of the maps are estimated, they carry a pointer to the next one besides the entry
+	const auto codepointMapSize = []( const CodepointMap &codepointMap ) -> u64
+	{
+		return( codepointMap.size() * ( sizeof( CodepointMap::value_type ) + sizeof( void* ) ) + codepointMap.bucket_count() * sizeof( void* ) );
+	};
+
+	memoryUsage.cpu = sizeof( CFont ) + codepointMapSize( CodepointsRegular );
+
+	if( CodepointsBold.has_value() )
+	{
+		memoryUsage.cpu += codepointMapSize( CodepointsBold.value() );
+	}
+
+	// the atlas has one byte per texel and gets a complete mip chain
+	for( u64 width = AtlasSize.width, height = AtlasSize.height; ( width > 0 ) || ( height > 0 ); width >>= 1, height >>= 1 )
+	{
+		memoryUsage.gpu += std::max( width, u64 { 1 } ) * std::max( height, u64 { 1 } );
+	}
+
+	return( memoryUsage );
 }
\ No newline at end of file
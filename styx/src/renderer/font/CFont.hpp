@@ -8,6 +8,7 @@
 #include "external/stb/stb_truetype.h"
 
 #include "src/core/Types.hpp"
+#include "src/core/SMemoryUsage.hpp"
 
 #include "src/helper/CSize.hpp"
 
@@ -36,4 +37,7 @@ public:
 
 	CodepointMap CodepointsRegular;
 	std::optional<CodepointMap> CodepointsBold;
+
+	// the atlas with its mip chain in video memory and the packed glyphs
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
 };
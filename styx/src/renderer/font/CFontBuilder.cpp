@@ -1,5 +1,6 @@
 #include "CFontBuilder.hpp"
 
+#include <algorithm>
 #include <array>
 
 #include "external/stb/stb_truetype.h"
@@ -20,6 +21,44 @@ const std::shared_ptr<const CFont> CFontBuilder::FromFile( const std::string &na
 }
 
 const std::shared_ptr<const CFont> CFontBuilder::FromFile( const std::string &name, const fs::path &pathRegular, const fs::path &pathBold, const u16 size, const CGlyphRange &glyphRange ) const
+{
+	const auto font = Build( name, pathRegular, pathBold, size, glyphRange );
+
+	m_fonts.erase( std::remove_if( std::begin( m_fonts ), std::end( m_fonts ), []( const std::weak_ptr<const CFont> &trackedFont ) { return( trackedFont.expired() ); } ), std::end( m_fonts ) );
+
+	m_fonts.emplace_back( font );
+
+	return( font );
+}
+
+std::vector<std::shared_ptr<const CFont>> CFontBuilder::Fonts() const
+{
+	std::vector<std::shared_ptr<const CFont>> fonts;
+
+	for( const auto &trackedFont : m_fonts )
+	{
+		if( auto font = trackedFont.lock() )
+		{
+			fonts.emplace_back( std::move( font ) );
+		}
+	}
+
+	return( fonts );
+}
+
+SMemoryUsage CFontBuilder::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage;
+
+	for( const auto &font : Fonts() )
+	{
+		memoryUsage += font->MemoryUsage();
+	}
+
+	return( memoryUsage );
+}
+
+const std::shared_ptr<const CFont> CFontBuilder::Build( const std::string &name, const fs::path &pathRegular, const fs::path &pathBold, const u16 size, const CGlyphRange &glyphRange ) const
 {
 	if( glyphRange.Count() == 0 )
 	{
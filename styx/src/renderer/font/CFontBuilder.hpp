@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "src/system/CFileSystem.hpp"
 
@@ -18,11 +19,22 @@ public:
 	const std::shared_ptr<const CFont> FromFile( const std::string &name, const fs::path &pathRegular, const fs::path &pathBold, const u16 size, const CGlyphRange &glyphRange ) const;
 	const std::shared_ptr<const CFont> FromFile( const std::string &name, const fs::path &pathRegular, const u16 size, const CGlyphRange &glyphRange ) const;
 
+	// the built fonts which are still in use
+	[[nodiscard]] std::vector<std::shared_ptr<const CFont>> Fonts() const;
+
+	// of all built fonts which are still in use
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 private:
+	const std::shared_ptr<const CFont> Build( const std::string &name, const fs::path &pathRegular, const fs::path &pathBold, const u16 size, const CGlyphRange &glyphRange ) const;
+
 	const std::shared_ptr<const CFont> FromDummy( const u16 size ) const;
 
 	bool PackFont( stbtt_pack_context &context, const f16 size, std::vector<s32> &glyphs, CFileSystem::FileBuffer &fileBuffer, CFont::CodepointMap &codepointMap ) const;
 	
 	const CFileSystem &m_filesystem;
+
+	// fonts are not cached like resources, so they are only tracked to account for their memory
+	mutable std::vector<std::weak_ptr<const CFont>> m_fonts;
 };
 
@@ -0,0 +1,6 @@
+#include "CImpostor.hpp"
+
+CImpostor::CImpostor( const std::shared_ptr<const CMesh> &mesh, const u16 viewCount ) :
+	Mesh { mesh },
+	ViewCount { viewCount }
+{}
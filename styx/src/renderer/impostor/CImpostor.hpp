@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+
+#include "src/core/Types.hpp"
+
+#include "src/renderer/model/CMesh.hpp"
+
+/**	A camera-facing quad which shows a mesh, pre-rendered from several view directions around its up-axis.
+	The views are stored as the layers of a 2D array texture.
+*/
+class CImpostor final
+{
+public:
+	CImpostor( const std::shared_ptr<const CMesh> &mesh, const u16 viewCount );
+
+	const std::shared_ptr<const CMesh> Mesh;
+
+	const u16 ViewCount;
+};
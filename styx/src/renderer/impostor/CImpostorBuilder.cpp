@@ -0,0 +1,203 @@
+#include "CImpostorBuilder.hpp"
+
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include "src/core/StyxException.hpp"
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/scene/CWorld.hpp"
+
+#include "src/renderer/CFrameBuffer.hpp"
+#include "src/renderer/RenderPackage.hpp"
+
+#include "src/renderer/geometry/prefabs/Rectangle.hpp"
+
+const u16 CImpostorBuilder::DefaultViewCount	{ 16 };
+const u32 CImpostorBuilder::DefaultResolution	{ 256 };
+
+const std::string CImpostorBuilder::m_impostorTextureName	= "impostorTexture";
+const std::string CImpostorBuilder::m_viewCountUniformName	= "viewCount";
+
+const std::string CImpostorBuilder::ImpostorVertexShaderBody = R"glsl(
+uniform {4}
+{{
+	uint {3};
+}};
+
+out vec3 UVW;
+
+void main()
+{{
+	vec3 center = ( {0} * vec4( 0, 0, 0, 1 ) ).xyz;
+
+	// the rows of the view matrix are the axes of the camera in world space
+	vec3 cameraRight	= vec3( View.viewMatrix[ 0 ][ 0 ], View.viewMatrix[ 1 ][ 0 ], View.viewMatrix[ 2 ][ 0 ] );
+	vec3 cameraUp		= vec3( View.viewMatrix[ 0 ][ 1 ], View.viewMatrix[ 1 ][ 1 ], View.viewMatrix[ 2 ][ 1 ] );
+
+	float scale = length( {0}[ 0 ].xyz );
+
+	gl_Position = View.viewProjectionMatrix * vec4( center + ( ( cameraRight * {1}.x ) + ( cameraUp * {1}.y ) ) * scale, 1 );
+
+	// pick the captured view which lies closest to the direction towards the camera
+	vec3 toCamera = inverse( mat3( {0} ) ) * ( View.position - center );
+
+	int count = int( {3} );
+	int view = int( round( ( atan( toCamera.z, toCamera.x ) / 6.28318530718 ) * count ) );
+
+	UVW = vec3( {2}, ( ( view % count ) + count ) % count );
+}}
+)glsl";
+
+const std::string CImpostorBuilder::ImpostorFragmentShaderBody = R"glsl(
+uniform sampler2DArray {0};
+
+in vec3 UVW;
+
+out vec4 color;
+
+void main()
+{{
+	color = texture( {0}, UVW );
+
+	if( color.a < 0.5 )
+	{{
+		discard;
+	}}
+}}
+)glsl";
+
+CImpostorBuilder::CImpostorBuilder( CRenderer &renderer, const CSamplerManager &samplerManager ) :
+	m_renderer { renderer },
+	m_samplerManager { samplerManager },
+	m_shaderProgram { std::make_shared<CShaderProgram>() }
+{
+	const std::shared_ptr<CShader> vertexShader = std::make_shared<CShader>();
+	const std::shared_ptr<CShader> fragmentShader = std::make_shared<CShader>();
+
+	if( !renderer.ShaderCompiler.Compile( vertexShader, GL_VERTEX_SHADER, fmt::format( ImpostorVertexShaderBody, CShaderCompiler::EngineUniforms.at( EEngineUniform::modelMatrix ).name, CShaderCompiler::AllowedAttributes.at( AttributeLocation::position ).name, CShaderCompiler::AllowedAttributes.at( AttributeLocation::uv0 ).name, m_viewCountUniformName, CShaderCompiler::MaterialBlockName ) ) )
+	{
+		THROW_STYX_EXCEPTION( "couldn't create impostor vertex shader" );
+	}
+
+	if( !renderer.ShaderCompiler.Compile( fragmentShader, GL_FRAGMENT_SHADER, fmt::format( ImpostorFragmentShaderBody, m_impostorTextureName ) ) )
+	{
+		THROW_STYX_EXCEPTION( "couldn't create impostor fragment shader" );
+	}
+
+	m_shaderProgram->VertexShader = vertexShader;
+	m_shaderProgram->FragmentShader = fragmentShader;
+
+	if( !renderer.ShaderProgramCompiler.Compile( m_shaderProgram ) )
+	{
+		THROW_STYX_EXCEPTION( "couldn't create impostor shader program" );
+	}
+
+	logINFO( "impostor builder was initialized" );
+}
+
+std::shared_ptr<const CImpostor> CImpostorBuilder::Create( const std::shared_ptr<const CMesh> &mesh, const u16 viewCount, const u32 resolution ) const
+{
+	const f16 radius = glm::length( mesh->BoundingSphereRadiusVector );
+
+	if( radius <= 0.0f )
+	{
+		logWARNING( "impostor can't be created for a mesh without extent" );
+		return( nullptr );
+	}
+
+	if( 0 == viewCount )
+	{
+		logWARNING( "impostor needs at least one view" );
+		return( nullptr );
+	}
+
+	// the views have to show the real material and textures and not the placeholders which are used while they are still loading
+	m_renderer.ShaderProgramCompiler.Finish();
+	m_renderer.TextureStreamer.Finish();
+
+	const auto &material = mesh->Material();
+
+	/*
+	 * render every view into the framebuffer and copy it into its layer of the array texture
+	 */
+
+	const CFrameBuffer framebuffer( CSize( resolution, resolution ) );
+
+	auto texture = std::make_shared<CTexture>();
+
+	texture->Target = GL_TEXTURE_2D_ARRAY;
+
+	glCreateTextures( texture->Target, 1, &texture->GLID );
+
+	const GLint mipLevels = static_cast<GLint>( floor( log2( resolution ) ) ) + 1;
+	glTextureParameteri( texture->GLID, GL_TEXTURE_BASE_LEVEL, 0 );
+	glTextureParameteri( texture->GLID, GL_TEXTURE_MAX_LEVEL, mipLevels - 1 );
+
+	glTextureStorage3D( texture->GLID, mipLevels, GL_RGBA8, resolution, resolution, viewCount );
+
+	texture->AllocatedLevels( CSize( resolution, resolution ), viewCount, GL_RGBA8, static_cast<u32>( mipLevels ), 4 );
+
+	for( u16 viewIndex = 0; viewIndex < viewCount; ++viewIndex )
+	{
+		const f16 angle = ( glm::two_pi<f16>() * viewIndex ) / viewCount;
+
+		// keep the whole bounding sphere between the near and the far plane
+		const glm::vec3 eye = glm::vec3( std::cos( angle ), 0.0f, std::sin( angle ) ) * ( 2.0f * radius );
+
+		RenderPackage renderPackage;
+
+		renderPackage.ClearColor = CColor( 0.0f, 0.0f, 0.0f, 0.0f );
+		renderPackage.TimeMilliseconds = 0;
+
+		auto &renderLayer = renderPackage.RenderLayers.emplace_back();
+
+		auto &view = renderLayer.View;
+
+		view.Position = eye;
+		view.Direction = glm::normalize( -eye );
+		view.ProjectionMatrix = glm::ortho( -radius, radius, -radius, radius, 0.0f, 4.0f * radius );
+		view.ViewMatrix = glm::lookAt( eye, glm::vec3( 0.0f ), CWorld::Y );
+		view.ViewProjectionMatrix = view.ProjectionMatrix * view.ViewMatrix;
+
+		renderLayer.drawCommands.emplace_back( material->Blending(), mesh.get(), material.get(), mesh->MaterialInstance().get(), material->ShaderProgram().get(), glm::mat4( 1.0f ), 0.0f );
+
+		m_renderer.RenderPackageToFramebuffer( renderPackage, framebuffer );
+
+		glCopyImageSubData(	framebuffer.ColorTexture()->GLID, GL_TEXTURE_2D, 0, 0, 0, 0,
+							texture->GLID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, viewIndex,
+							resolution, resolution, 1 );
+	}
+
+	glGenerateTextureMipmap( texture->GLID );
+
+	/*
+	 * set up the material and the quad which shows the views
+	 */
+
+	auto impostorMaterial = std::make_shared<CMaterial>();
+
+	impostorMaterial->Name( fmt::format( "impostor of '{0}'", material->Name() ) );
+	impostorMaterial->DisableBlending();
+	impostorMaterial->DisableCulling();
+	impostorMaterial->ShaderProgram( m_shaderProgram );
+
+	for( const auto & [ offset, interface ] : m_shaderProgram->RequiredMaterialUniforms() )
+	{
+		if( interface.name == m_viewCountUniformName )
+		{
+			impostorMaterial->AddMaterialUniform<CMaterialUniformUINT>( offset, interface.name, viewCount );
+		}
+	}
+
+	impostorMaterial->UploadMaterialBlock( m_renderer.MaterialBlockArena );
+
+	const CMesh::TMeshTextureSlots textureSlots = { { m_impostorTextureName, std::make_shared<CMeshTextureSlot>( texture, m_samplerManager.GetFromType( CSampler::SamplerType::EDGE_2D ) ) } };
+
+	const auto impostorMesh = std::make_shared<CMesh>( GeometryPrefabs::RectanglePNU0( 2.0f * radius, 2.0f * radius ), impostorMaterial, textureSlots );
+
+	return( std::make_shared<CImpostor>( impostorMesh, viewCount ) );
+}
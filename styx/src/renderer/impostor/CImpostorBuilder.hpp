@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+
+#include "src/core/Types.hpp"
+
+#include "src/renderer/CRenderer.hpp"
+
+#include "src/renderer/sampler/CSamplerManager.hpp"
+
+#include "src/renderer/model/CMesh.hpp"
+
+#include "src/renderer/impostor/CImpostor.hpp"
+
+class CImpostorBuilder final
+{
+public:
+	CImpostorBuilder( CRenderer &renderer, const CSamplerManager &samplerManager );
+
+	/**	Renders the mesh from viewCount directions around its up-axis into the layers of an array texture
+		and returns a quad which always shows the view closest to the direction of the camera.
+	*/
+	[[nodiscard]] std::shared_ptr<const CImpostor> Create( const std::shared_ptr<const CMesh> &mesh, const u16 viewCount = DefaultViewCount, const u32 resolution = DefaultResolution ) const;
+
+	static const u16 DefaultViewCount;
+	static const u32 DefaultResolution;
+
+private:
+	// not const, because the pending texture uploads are finished before the views are rendered
+	CRenderer &m_renderer;
+
+	const CSamplerManager &m_samplerManager;
+
+	const std::shared_ptr<CShaderProgram> m_shaderProgram;
+
+	static const std::string m_impostorTextureName;
+	static const std::string m_viewCountUniformName;
+
+	static const std::string ImpostorVertexShaderBody;
+	static const std::string ImpostorFragmentShaderBody;
+};
@@ -2,6 +2,11 @@
 
 #include "src/renderer/CGLState.hpp"
 
+CMaterial::~CMaterial()
+{
+	FreeMaterialBlock();
+}
+
 void CMaterial::Activate() const
 {
 	CGLState::CullFace( m_bCullFace, m_cullfaceMode );
@@ -11,9 +16,74 @@ void CMaterial::Activate() const
 
 	m_shaderProgram->Use();
 
-	for( const auto & [ location, uniform ] : m_materialUniforms )
+	BindMaterialBlock();
+}
+
+void CMaterial::UploadMaterialBlock( const std::shared_ptr<CMaterialBlockArena> &arena )
+{
+	FreeMaterialBlock();
+
+	m_revision++;
+
+	if( m_shaderProgram->MaterialBlockSize() > 0 )
+	{
+		const auto block = PackMaterialBlock();
+
+		m_materialBlockArena	= arena;
+		m_materialBlockOffset	= arena->Allocate( block );
+		m_materialBlockSize		= block.size();
+	}
+}
+
+std::vector<std::byte> CMaterial::PackMaterialBlock() const
+{
+	std::vector<std::byte> block( m_shaderProgram->MaterialBlockSize() );
+
+	for( const auto & [ offset, uniform ] : m_materialUniforms )
+	{
+		uniform->Pack( block.data() + offset );
+	}
+
+	return( block );
+}
+
+void CMaterial::BindMaterialBlock() const
+{
+	if( m_materialBlockSize > 0 )
 	{
-		uniform->Set( location );
+		m_materialBlockArena->BindRange( m_materialBlockOffset, m_materialBlockSize );
+	}
+}
+
+SMemoryUsage CMaterial::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage;
+
+	memoryUsage.cpu = sizeof( CMaterial ) + m_name.capacity() + m_materialUniforms.capacity() * sizeof( decltype( m_materialUniforms )::value_type );
+	memoryUsage.gpu = static_cast<u64>( m_materialBlockSize );
+
+	return( memoryUsage );
+}
+
+const std::shared_ptr<CMaterialBlockArena> &CMaterial::MaterialBlockArena() const
+{
+	return( m_materialBlockArena );
+}
+
+u32 CMaterial::Revision() const
+{
+	return( m_revision );
+}
+
+void CMaterial::FreeMaterialBlock()
+{
+	if( m_materialBlockSize > 0 )
+	{
+		m_materialBlockArena->Free( m_materialBlockOffset );
+
+		m_materialBlockArena	= nullptr;
+		m_materialBlockOffset	= 0;
+		m_materialBlockSize		= 0;
 	}
 }
 
@@ -88,14 +158,30 @@ void CMaterial::Name( const std::string &name )
 	m_name = name;
 }
 
+f16 CMaterial::UVScale() const
+{
+	return( m_uvScale );
+}
+
+void CMaterial::UVScale( const f16 uvScale )
+{
+	m_uvScale = uvScale;
+}
+
 void CMaterial::Reset()
 {
 	m_name = "";
 
+	m_uvScale = 1.0f;
+
 	m_shaderProgram = nullptr;
 
 	m_materialUniforms.clear();
 
+	FreeMaterialBlock();
+
+	m_revision++;
+
 	m_bCullFace		= false;
 	m_cullfaceMode	= GL_NONE;
 
@@ -2,15 +2,19 @@
 
 #include <memory>
 
+#include "src/core/SMemoryUsage.hpp"
+
 #include "src/renderer/texture/CTexture.hpp"
 #include "src/renderer/shader/CShaderProgram.hpp"
 
 #include "src/renderer/material/CMaterialUniform.hpp"
+#include "src/renderer/material/CMaterialBlockArena.hpp"
 
 class CMaterial final
 {
 public:
 	CMaterial() {};
+	~CMaterial();
 
 	void Activate() const;
 
@@ -31,19 +35,39 @@ public:
 
 	const std::vector<std::pair<GLuint, std::unique_ptr<const CMaterialUniform>>> &MaterialUniforms() const;
 	
+	// the offset is the one of the uniform inside of the material block of the shader program
 	template<typename T, typename ...Args>
-	void AddMaterialUniform( GLuint location, Args... args )
+	void AddMaterialUniform( GLuint offset, Args... args )
 	{
 		static_assert( std::is_base_of<CMaterialUniform, T>::value, "must derive from CMaterialUniform" );
 		
-		m_materialUniforms.emplace_back( std::make_pair( location, std::make_unique<const T>( std::forward<Args>(args)... ) ) );
+		m_materialUniforms.emplace_back( std::make_pair( offset, std::make_unique<const T>( std::forward<Args>(args)... ) ) );
 	}
 
+	// packs all material uniforms into the material block and stores it in the arena, has to be called after all uniforms were added
+	void UploadMaterialBlock( const std::shared_ptr<CMaterialBlockArena> &arena );
+
+	[[nodiscard]] std::vector<std::byte> PackMaterialBlock() const;
+
+	void BindMaterialBlock() const;
+
+	const std::shared_ptr<CMaterialBlockArena> &MaterialBlockArena() const;
+
+	// changes whenever the material block was uploaded anew, so instances know when to repack theirs
+	u32 Revision() const;
+
 	const std::string &Name() const;
 	void Name( const std::string &name );
 
+	// how often the textures repeat across the UVs of a mesh, tiling needs finer mip levels
+	f16 UVScale() const;
+	void UVScale( const f16 uvScale );
+
 	void Reset();
 
+	// the textures and the shader program are resources of their own, the material block lives in the arena
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 private:
 	std::string m_name;
 
@@ -51,6 +75,16 @@ private:
 
 	std::vector<std::pair<GLuint, std::unique_ptr<const CMaterialUniform>>> m_materialUniforms;
 
+	void FreeMaterialBlock();
+
+	std::shared_ptr<CMaterialBlockArena>	m_materialBlockArena;
+	GLintptr								m_materialBlockOffset	{ 0 };
+	GLsizeiptr								m_materialBlockSize		{ 0 };
+
+	u32 m_revision { 0 };
+
+	f16 m_uvScale { 1.0f };
+
 	bool	m_bCullFace		{ false };
 	GLenum	m_cullfaceMode	{ GL_NONE };	// GL_FRONT, GL_BACK or GL_FRONT_AND_BACK
 
@@ -0,0 +1,157 @@
+#include "CMaterialBlockArena.hpp"
+
+#include <algorithm>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/renderer/EUniformBufferLocations.hpp"
+#include "src/renderer/CGLState.hpp"
+
+const GLsizeiptr CMaterialBlockArena::InitialSize { 64 * 1024 };
+
+CMaterialBlockArena::CMaterialBlockArena() :
+	m_size { InitialSize }
+{
+	glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &m_offsetAlignment );
+
+	glCreateBuffers( 1, &m_id );
+	glNamedBufferData( m_id, m_size, nullptr, GL_STATIC_DRAW );
+
+	m_freeRanges[ 0 ] = m_size;
+}
+
+CMaterialBlockArena::~CMaterialBlockArena()
+{
+	#ifdef STYX_DEBUG
+	if( !m_usedRanges.empty() )
+	{
+		logWARNING( "there are still {0} material blocks in the arena", m_usedRanges.size() );
+	}
+	#endif
+
+	CGLState::DeleteBuffer( m_id );
+}
+
+GLintptr CMaterialBlockArena::Allocate( const std::vector<std::byte> &block )
+{
+	// every block has to start at a multiple of the alignment to be bindable
+	const GLsizeiptr size = ( ( static_cast<GLsizeiptr>( block.size() ) + m_offsetAlignment - 1 ) / m_offsetAlignment ) * m_offsetAlignment;
+
+	auto freeRange = std::find_if( std::begin( m_freeRanges ), std::end( m_freeRanges ), [ size ]( const auto &range ) { return( range.second >= size ); } );
+
+	if( std::end( m_freeRanges ) == freeRange )
+	{
+		Grow( size );
+
+		freeRange = std::find_if( std::begin( m_freeRanges ), std::end( m_freeRanges ), [ size ]( const auto &range ) { return( range.second >= size ); } );
+	}
+
+	const auto [ offset, freeSize ] = *freeRange;
+
+	m_freeRanges.erase( freeRange );
+
+	if( freeSize > size )
+	{
+		m_freeRanges[ offset + size ] = freeSize - size;
+	}
+
+	m_usedRanges[ offset ] = size;
+
+	glNamedBufferSubData( m_id, offset, block.size(), block.data() );
+
+	return( offset );
+}
+
+void CMaterialBlockArena::Free( const GLintptr offset )
+{
+	const auto usedRange = m_usedRanges.find( offset );
+
+	if( std::end( m_usedRanges ) == usedRange )
+	{
+		logERROR( "there is no material block at offset {0}", offset );
+		return;
+	}
+
+	GLintptr	freeOffset	= usedRange->first;
+	GLsizeiptr	freeSize	= usedRange->second;
+
+	m_usedRanges.erase( usedRange );
+
+	// merge with the following free range
+	if( const auto next = m_freeRanges.find( freeOffset + freeSize ); std::end( m_freeRanges ) != next )
+	{
+		freeSize += next->second;
+		m_freeRanges.erase( next );
+	}
+
+	// merge with the preceding free range
+	if( const auto next = m_freeRanges.lower_bound( freeOffset ); std::begin( m_freeRanges ) != next )
+	{
+		const auto previous = std::prev( next );
+
+		if( previous->first + previous->second == freeOffset )
+		{
+			freeOffset = previous->first;
+			freeSize += previous->second;
+			m_freeRanges.erase( previous );
+		}
+	}
+
+	m_freeRanges[ freeOffset ] = freeSize;
+}
+
+void CMaterialBlockArena::Update( const GLintptr offset, const std::vector<std::byte> &block )
+{
+	const auto usedRange = m_usedRanges.find( offset );
+
+	if( ( std::end( m_usedRanges ) == usedRange ) || ( usedRange->second < static_cast<GLsizeiptr>( block.size() ) ) )
+	{
+		logERROR( "there is no material block of size {0} at offset {1}", block.size(), offset );
+		return;
+	}
+
+	glNamedBufferSubData( m_id, offset, block.size(), block.data() );
+}
+
+void CMaterialBlockArena::BindRange( const GLintptr offset, const GLsizeiptr size ) const
+{
+	CGLState::BindBufferRange( GL_UNIFORM_BUFFER, static_cast<GLuint>( EUniformBufferLocation::MATERIAL ), m_id, offset, size );
+}
+
+void CMaterialBlockArena::Grow( const GLsizeiptr minimumSize )
+{
+	const GLsizeiptr newSize = std::max( 2 * m_size, m_size + minimumSize );
+
+	GLuint newId;
+	glCreateBuffers( 1, &newId );
+	glNamedBufferData( newId, newSize, nullptr, GL_STATIC_DRAW );
+
+	// the offsets of all blocks stay the same
+	glCopyNamedBufferSubData( m_id, newId, 0, 0, m_size );
+
+	CGLState::DeleteBuffer( m_id );
+
+	m_id = newId;
+
+	// append the new space to a free range at the end, if there is one
+	GLintptr	freeOffset	= m_size;
+	GLsizeiptr	freeSize	= newSize - m_size;
+
+	if( !m_freeRanges.empty() )
+	{
+		const auto last = std::prev( std::end( m_freeRanges ) );
+
+		if( last->first + last->second == m_size )
+		{
+			freeOffset = last->first;
+			freeSize += last->second;
+			m_freeRanges.erase( last );
+		}
+	}
+
+	m_freeRanges[ freeOffset ] = freeSize;
+
+	logDEBUG( "material block arena grew from {0} to {1} bytes", m_size, newSize );
+
+	m_size = newSize;
+}
\ No newline at end of file
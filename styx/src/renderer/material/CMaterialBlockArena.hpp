@@ -0,0 +1,44 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <cstddef>
+
+#include "src/renderer/GL.h"
+
+/**	One uniform buffer which holds the packed material blocks of all materials.
+	Activating a material only binds its range of the buffer.
+*/
+class CMaterialBlockArena final
+{
+private:
+	CMaterialBlockArena( const CMaterialBlockArena &rhs ) = delete;
+	CMaterialBlockArena& operator = ( const CMaterialBlockArena &rhs ) = delete;
+
+public:
+	CMaterialBlockArena();
+	~CMaterialBlockArena();
+
+	// copies the block into the arena and returns its offset
+	[[nodiscard]] GLintptr Allocate( const std::vector<std::byte> &block );
+	void Free( const GLintptr offset );
+
+	// overwrites an already allocated block
+	void Update( const GLintptr offset, const std::vector<std::byte> &block );
+
+	void BindRange( const GLintptr offset, const GLsizeiptr size ) const;
+
+private:
+	void Grow( const GLsizeiptr minimumSize );
+
+	GLuint		m_id;
+	GLsizeiptr	m_size;
+
+	GLint m_offsetAlignment { 0 };
+
+	// offset and size of the used and the free ranges
+	std::map<GLintptr, GLsizeiptr> m_usedRanges;
+	std::map<GLintptr, GLsizeiptr> m_freeRanges;
+
+	static const GLsizeiptr InitialSize;
+};
\ No newline at end of file
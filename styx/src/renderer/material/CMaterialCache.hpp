@@ -11,9 +11,9 @@
 class CMaterialCache final : public CResourceCache<CMaterial>
 {
 public:
-	CMaterialCache( const CFileSystem &filesystem, CResources &resources, const std::shared_ptr<const CShaderProgram> &dummyShaderProgram ) :
+	CMaterialCache( const CFileSystem &filesystem, CResources &resources, const CShaderProgramCompiler &shaderProgramCompiler, const std::shared_ptr<CMaterialBlockArena> &materialBlockArena ) :
 		CResourceCache( "material", filesystem ),
-		m_materialLoader( filesystem, resources, dummyShaderProgram )
+		m_materialLoader( filesystem, resources, shaderProgramCompiler, materialBlockArena )
 	{}
 
 private:
@@ -22,5 +22,15 @@ private:
 		m_materialLoader.FromFile( resource, id );
 	}
 
+	TFinisher Decode( const std::string &id ) const override
+	{
+		return( [ this, id, mat_root = m_materialLoader.Decode( id ) ]( const std::shared_ptr<CMaterial> &resource ) { m_materialLoader.FromDecoded( resource, id, mat_root ); } );
+	}
+
+	void LoadPlaceholder( const std::shared_ptr<CMaterial> &resource, const std::string &id ) const override
+	{
+		m_materialLoader.FromPlaceholder( resource, id );
+	}
+
 	const CMaterialLoader m_materialLoader;
 };
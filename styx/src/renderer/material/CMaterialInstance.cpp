@@ -0,0 +1,88 @@
+#include "CMaterialInstance.hpp"
+
+#include "src/logger/CLogger.hpp"
+
+CMaterialInstance::CMaterialInstance( const std::shared_ptr<const CMaterial> &parent ) :
+	m_parent { parent }
+{
+	Update();
+}
+
+CMaterialInstance::~CMaterialInstance()
+{
+	FreeMaterialBlock();
+}
+
+void CMaterialInstance::Activate() const
+{
+	if( m_parentRevision != m_parent->Revision() )
+	{
+		Update();
+	}
+
+	if( m_materialBlockSize > 0 )
+	{
+		m_materialBlockArena->BindRange( m_materialBlockOffset, m_materialBlockSize );
+	}
+}
+
+const std::shared_ptr<const CMaterial> &CMaterialInstance::Parent() const
+{
+	return( m_parent );
+}
+
+void CMaterialInstance::Update() const
+{
+	m_parentRevision = m_parent->Revision();
+
+	auto block = m_parent->PackMaterialBlock();
+
+	if( block.empty() || ( nullptr == m_parent->MaterialBlockArena() ) )
+	{
+		FreeMaterialBlock();
+		return;
+	}
+
+	const auto &requiredMaterialUniforms = m_parent->ShaderProgram()->RequiredMaterialUniforms();
+
+	for( const auto &uniform : m_overrides )
+	{
+		const auto &name = uniform->Name();
+
+		const auto requiredMaterialUniform = std::find_if( std::cbegin( requiredMaterialUniforms ), std::cend( requiredMaterialUniforms ), [ &name ]( const auto &requiredUniform ) { return( requiredUniform.second.name == name ); } );
+
+		if( std::cend( requiredMaterialUniforms ) == requiredMaterialUniform )
+		{
+			logWARNING( "material '{0}' has no uniform '{1}' which could be overridden", m_parent->Name(), name );
+		}
+		else
+		{
+			uniform->Pack( block.data() + requiredMaterialUniform->first );
+		}
+	}
+
+	if( ( m_materialBlockArena == m_parent->MaterialBlockArena() ) && ( static_cast<GLsizeiptr>( block.size() ) == m_materialBlockSize ) )
+	{
+		m_materialBlockArena->Update( m_materialBlockOffset, block );
+	}
+	else
+	{
+		FreeMaterialBlock();
+
+		m_materialBlockArena	= m_parent->MaterialBlockArena();
+		m_materialBlockOffset	= m_materialBlockArena->Allocate( block );
+		m_materialBlockSize		= block.size();
+	}
+}
+
+void CMaterialInstance::FreeMaterialBlock() const
+{
+	if( m_materialBlockSize > 0 )
+	{
+		m_materialBlockArena->Free( m_materialBlockOffset );
+
+		m_materialBlockArena	= nullptr;
+		m_materialBlockOffset	= 0;
+		m_materialBlockSize		= 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include "src/renderer/material/CMaterial.hpp"
+
+/**	Shares the shader program and the render state of its parent material and only overrides some of its uniforms.
+	Draws with different instances of the same material are sorted next to each other and only need to bind another range of the material block arena.
+*/
+class CMaterialInstance final
+{
+private:
+	CMaterialInstance( const CMaterialInstance &rhs ) = delete;
+	CMaterialInstance& operator = ( const CMaterialInstance &rhs ) = delete;
+
+public:
+	explicit CMaterialInstance( const std::shared_ptr<const CMaterial> &parent );
+	~CMaterialInstance();
+
+	// binds the material block of this instance, the parent has to be activated before
+	void Activate() const;
+
+	const std::shared_ptr<const CMaterial> &Parent() const;
+
+	// the uniform is looked up by name whenever the parent changes, so this also works while the parent is still waiting for its shader program
+	template<typename T, typename ...Args>
+	void OverrideMaterialUniform( const std::string &name, Args... args )
+	{
+		static_assert( std::is_base_of<CMaterialUniform, T>::value, "must derive from CMaterialUniform" );
+
+		m_overrides.erase( std::remove_if( std::begin( m_overrides ), std::end( m_overrides ), [ &name ]( const auto &overriddenUniform ) { return( overriddenUniform->Name() == name ); } ), std::end( m_overrides ) );
+
+		m_overrides.emplace_back( std::make_unique<const T>( name, std::forward<Args>(args)... ) );
+
+		Update();
+	}
+
+private:
+	// packs the values of the parent with the overrides on top and uploads them
+	void Update() const;
+
+	void FreeMaterialBlock() const;
+
+	const std::shared_ptr<const CMaterial> m_parent;
+
+	std::vector<std::unique_ptr<const CMaterialUniform>> m_overrides;
+
+	// the revision of the parent the material block was packed from
+	mutable u32 m_parentRevision { 0 };
+
+	mutable std::shared_ptr<CMaterialBlockArena>	m_materialBlockArena;
+	mutable GLintptr								m_materialBlockOffset	{ 0 };
+	mutable GLsizeiptr								m_materialBlockSize		{ 0 };
+};
\ No newline at end of file
@@ -2,23 +2,27 @@
 
 #include <algorithm>
 
-#include "external/json/json.hpp"
-using json = nlohmann::json;
-
 #include <glbinding-aux/Meta.h>
 
 #include "src/logger/CLogger.hpp"
 
 #include "src/core/FileExtension.hpp"
 
+#include "src/helper/Json.hpp"
+
 #include "src/renderer/GLHelper.hpp"
 
+#include "src/renderer/shader/ShaderVariant.hpp"
+
+using json = nlohmann::json;
+
 u16 CMaterialLoader::m_dummyCounter { 0 };
 
-CMaterialLoader::CMaterialLoader( const CFileSystem &filesystem, CResources &resources, const std::shared_ptr<const CShaderProgram> &dummyShaderProgram ) :
+CMaterialLoader::CMaterialLoader( const CFileSystem &filesystem, CResources &resources, const CShaderProgramCompiler &shaderProgramCompiler, const std::shared_ptr<CMaterialBlockArena> &materialBlockArena ) :
 	m_filesystem { filesystem },
 	m_resources { resources },
-	m_dummyShaderProgram { dummyShaderProgram }
+	m_shaderProgramCompiler { shaderProgramCompiler },
+	m_materialBlockArena { materialBlockArena }
 {
 	logINFO( "material loader was initialized" );
 }
@@ -36,6 +40,29 @@ CMaterialLoader::~CMaterialLoader()
 }
 
 void CMaterialLoader::FromFile( const std::shared_ptr<CMaterial> &material, const fs::path &path ) const
+{
+	FromDecoded( material, path, Decode( path ) );
+}
+
+std::optional<json> CMaterialLoader::Decode( const fs::path &path ) const
+{
+	if( !path.has_filename() || ( path.extension().generic_string() != FileExtension::Material::mat ) || !m_filesystem.Exists( path ) )
+	{
+		return( std::nullopt );
+	}
+
+	try
+	{
+		return( Json::Load( m_filesystem, path ) );
+	}
+	catch( json::parse_error &e )
+	{
+		logWARNING( "failed to parse '{0}' because of {1}", path.generic_string(), e.what() );
+		return( std::nullopt );
+	}
+}
+
+void CMaterialLoader::FromDecoded( const std::shared_ptr<CMaterial> &material, const fs::path &path, const std::optional<json> &mat_root ) const
 {
 	if( !path.has_filename() )
 	{
@@ -55,11 +82,15 @@ void CMaterialLoader::FromFile( const std::shared_ptr<CMaterial> &material, cons
 		logWARNING( "material file '{0}' does not exist", path.generic_string() );
 		FromDummy( material );
 	}
+	else if( !mat_root )
+	{
+		FromDummy( material );
+	}
 	else
 	{
 		try
 		{
-			if( !FromMatFile( material, path ) )
+			if( !FromMatRoot( material, *mat_root, path ) )
 			{
 				FromDummy( material );
 			}
@@ -72,21 +103,9 @@ void CMaterialLoader::FromFile( const std::shared_ptr<CMaterial> &material, cons
 	}
 }
 
-bool CMaterialLoader::FromMatFile( const std::shared_ptr<CMaterial> &material, const fs::path &path ) const
+bool CMaterialLoader::FromMatRoot( const std::shared_ptr<CMaterial> &material, const json &mat_root, const fs::path &path ) const
 {
-	json mat_root;
-
-	try
-	{
-		mat_root = json::parse( m_filesystem.LoadFileToString( path ) );
-	}
-	catch( json::parse_error &e )
-	{
-		logWARNING( "failed to parse '{0}' because of {1}", path.generic_string(), e.what() );
-		return( false );
-	}
-
-	const auto mat_name = mat_root[ "name" ];
+	const auto mat_name = mat_root.at( "name" );
 
 	material->Name( mat_name.get<std::string>() );
 
@@ -156,6 +175,21 @@ bool CMaterialLoader::FromMatFile( const std::shared_ptr<CMaterial> &material, c
 		material->EnableDepthMask();
 	}
 
+	const auto mat_uvscale = mat_root.find( "uvscale" );
+	if( mat_uvscale != mat_root.end() )
+	{
+		const f16 uvScale = mat_uvscale->get<f16>();
+
+		if( uvScale > 0.0f )
+		{
+			material->UVScale( uvScale );
+		}
+		else
+		{
+			logWARNING( "uvscale of '{0}' has to be positive", path.generic_string() );
+		}
+	}
+
 	const auto mat_shader = mat_root.find( "shader" );
 	if( mat_shader == mat_root.end() )
 	{
@@ -164,193 +198,242 @@ bool CMaterialLoader::FromMatFile( const std::shared_ptr<CMaterial> &material, c
 	}
 	else
 	{
-		const auto shaderProgram = m_resources.Get<CShaderProgram>( mat_shader->get<std::string>() );
+		// the keywords select the variant of the shader program, which gets compiled the first time it is requested
+		ShaderVariant::TKeywords keywords;
 
-		material->ShaderProgram( shaderProgram );
+		const auto mat_keywords = mat_root.find( "keywords" );
+		if( mat_keywords != mat_root.end() )
+		{
+			for( const auto &mat_keyword : *mat_keywords )
+			{
+				keywords.insert( mat_keyword.get<std::string>() );
+			}
+		}
+
+		const std::shared_ptr<const CShaderProgram> shaderProgram = m_resources.Get<CShaderProgram>( ShaderVariant::Id( mat_shader->get<std::string>(), keywords ) );
 
 		const auto mat_uniforms = mat_root.find( "uniforms" );
 
-		if( !shaderProgram->RequiredMaterialUniforms().empty() )
+		const json uniforms = ( mat_uniforms != mat_root.end() ) ? *mat_uniforms : json();
+
+		if( shaderProgram->Ready() )
 		{
-			if( mat_uniforms == mat_root.end() )
+			return( SetupShaderProgram( material, shaderProgram, uniforms, path ) );
+		}
+
+		// the program is still being linked, so render with the dummy until the uniforms can be resolved
+		material->ShaderProgram( m_shaderProgramCompiler.DummyShaderProgram() );
+
+		const std::weak_ptr<CMaterial> pendingMaterial = material;
+
+		m_shaderProgramCompiler.OnReady( shaderProgram, [ this, pendingMaterial, shaderProgram, uniforms, path ]
+		{
+			if( const auto readyMaterial = pendingMaterial.lock(); nullptr != readyMaterial )
 			{
-				logWARNING( "no required uniforms specified in '{0}'", path.generic_string() );
-				return( false );
+				if( !SetupShaderProgram( readyMaterial, shaderProgram, uniforms, path ) )
+				{
+					FromDummy( readyMaterial );
+				}
 			}
-			else
+		} );
+	}
+
+	return( true );
+}
+
+bool CMaterialLoader::SetupShaderProgram( const std::shared_ptr<CMaterial> &material, const std::shared_ptr<const CShaderProgram> &shaderProgram, const json &mat_uniforms, const fs::path &path ) const
+{
+	material->ShaderProgram( shaderProgram );
+
+	if( !shaderProgram->RequiredMaterialUniforms().empty() )
+	{
+		if( mat_uniforms.is_null() )
+		{
+			logWARNING( "no required uniforms specified in '{0}'", path.generic_string() );
+			return( false );
+		}
+		else
+		{
+			for( const auto & [ offset, interface ] : shaderProgram->RequiredMaterialUniforms() )
 			{
-				for( const auto & [ location, interface ] : shaderProgram->RequiredMaterialUniforms() )
+				const auto mat_uniform = mat_uniforms.find( interface.name );
+				if( mat_uniform == mat_uniforms.end() )
 				{
-					const auto mat_uniform = mat_uniforms->find( interface.name );
-					if( mat_uniform == mat_uniforms->end() )
-					{
-						logWARNING( "required uniform '{0}' not specified in '{1}'", interface.name, path.generic_string() );
-						return( false );
-					}
-					else
+					logWARNING( "required uniform '{0}' not specified in '{1}'", interface.name, path.generic_string() );
+					return( false );
+				}
+				else
+				{
+					switch( interface.type )
 					{
-						switch( interface.type )
-						{
-							case GL_UNSIGNED_INT:
-								if( !mat_uniform->is_number_unsigned() )
-								{
-									logWARNING( "uniform '{0}' in '{1}' is not of type {2}", interface.name, path.generic_string(), glbinding::aux::Meta::getString( interface.type ) );
-									return( false );
-								}
-								else
-								{
-									material->AddMaterialUniform<CMaterialUniformUINT>( location, interface.name, mat_uniform->get<glm::uint>() );
-								}
-								break;
+						case GL_UNSIGNED_INT:
+							if( !mat_uniform->is_number_unsigned() )
+							{
+								logWARNING( "uniform '{0}' in '{1}' is not of type {2}", interface.name, path.generic_string(), glbinding::aux::Meta::getString( interface.type ) );
+								return( false );
+							}
+							else
+							{
+								material->AddMaterialUniform<CMaterialUniformUINT>( offset, interface.name, mat_uniform->get<glm::uint>() );
+							}
+							break;
+
+						case GL_FLOAT:
+							if( !mat_uniform->is_number_float() )
+							{
+								logWARNING( "uniform '{0}' in '{1}' is not of type {2}", interface.name, path.generic_string(), glbinding::aux::Meta::getString( interface.type ) );
+								return( false );
+							}
+							else
+							{
+								material->AddMaterialUniform<CMaterialUniformFLOAT>( offset, interface.name, mat_uniform->get<glm::float32>() );
+							}
+							break;
+
+						case GL_FLOAT_VEC2:
+						case GL_FLOAT_VEC3:
+						case GL_FLOAT_VEC4:
+							if( !mat_uniform->is_array() )
+							{
+								logWARNING( "uniform '{0}' in '{1}' is not an array", interface.name, path.generic_string() );
+								return( false );
+							}
+							else
+							{
+								const auto &type = interface.type;
 
-							case GL_FLOAT:
-								if( !mat_uniform->is_number_float() )
-								{
-									logWARNING( "uniform '{0}' in '{1}' is not of type {2}", interface.name, path.generic_string(), glbinding::aux::Meta::getString( interface.type ) );
-									return( false );
-								}
-								else
+								const u8 requiredAmountOfValues = [&type]
 								{
-									material->AddMaterialUniform<CMaterialUniformFLOAT>( location, interface.name, mat_uniform->get<glm::float32>() );
-								}
-								break;
+									switch( type )
+									{
+										case GL_FLOAT_VEC2:
+											return( 2 );
+										case GL_FLOAT_VEC3:
+											return( 3 );
+										case GL_FLOAT_VEC4:
+											return( 4 );
+										default:
+											return( 0 );
+									}
+								}();
 
-							case GL_FLOAT_VEC2:
-							case GL_FLOAT_VEC3:
-							case GL_FLOAT_VEC4:
-								if( !mat_uniform->is_array() )
+								if( mat_uniform->size() != requiredAmountOfValues )
 								{
-									logWARNING( "uniform '{0}' in '{1}' is not an array", interface.name, path.generic_string() );
+									logWARNING( "uniform '{0}' in '{1}' requires {2} values but got {3}", interface.name, path.generic_string(), requiredAmountOfValues, mat_uniform->size() );
 									return( false );
 								}
 								else
 								{
-									const auto &type = interface.type;
-
-									const u8 requiredAmountOfValues = [&type]
-									{
-										switch( type )
-										{
-											case GL_FLOAT_VEC2:
-												return( 2 );
-											case GL_FLOAT_VEC3:
-												return( 3 );
-											case GL_FLOAT_VEC4:
-												return( 4 );
-											default:
-												return( 0 );
-										}
-									}();
-
-									if( mat_uniform->size() != requiredAmountOfValues )
-									{
-										logWARNING( "uniform '{0}' in '{1}' requires {2} values but got {3}", interface.name, path.generic_string(), requiredAmountOfValues, mat_uniform->size() );
-										return( false );
-									}
-									else
+									switch( requiredAmountOfValues )
 									{
-										switch( requiredAmountOfValues )
-										{
-											case 2:
+										case 2:
+											{
+												const auto value0 = (*mat_uniform)[ 0 ];
+												const auto value1 = (*mat_uniform)[ 1 ];
+
+												if( value0.is_number_float()
+													&&
+													value1.is_number_float() )
 												{
-													const auto value0 = (*mat_uniform)[ 0 ];
-													const auto value1 = (*mat_uniform)[ 1 ];
-
-													if( value0.is_number_float()
-														&&
-														value1.is_number_float() )
-													{
-														material->AddMaterialUniform<CMaterialUniformFLOATVEC2>( location, interface.name, glm::vec2( value0.get<f16>(), value1.get<f16>() ) );
-													}
-													else
-													{
-														logWARNING( "not all values of uniform '{0}' in '{1}' are floats", interface.name, path.generic_string() );
-														return( false );
-													}
+													material->AddMaterialUniform<CMaterialUniformFLOATVEC2>( offset, interface.name, glm::vec2( value0.get<f16>(), value1.get<f16>() ) );
 												}
-												break;
-
-											case 3:
+												else
 												{
-													const auto value0 = (*mat_uniform)[ 0 ];
-													const auto value1 = (*mat_uniform)[ 1 ];
-													const auto value2 = (*mat_uniform)[ 2 ];
-
-													if( value0.is_number_float()
-														&&
-														value1.is_number_float()
-														&&
-														value2.is_number_float() )
-													{
-														material->AddMaterialUniform<CMaterialUniformFLOATVEC3>( location, interface.name, glm::vec3( value0.get<f16>(), value1.get<f16>(), value2.get<f16>() ) );
-													}
-													else
-													{
-														logWARNING( "not all values of uniform '{0}' in '{1}' are floats", interface.name, path.generic_string() );
-														return( false );
-													}
+													logWARNING( "not all values of uniform '{0}' in '{1}' are floats", interface.name, path.generic_string() );
+													return( false );
 												}
-												break;
-
-											case 4:
+											}
+											break;
+
+										case 3:
+											{
+												const auto value0 = (*mat_uniform)[ 0 ];
+												const auto value1 = (*mat_uniform)[ 1 ];
+												const auto value2 = (*mat_uniform)[ 2 ];
+
+												if( value0.is_number_float()
+													&&
+													value1.is_number_float()
+													&&
+													value2.is_number_float() )
+												{
+													material->AddMaterialUniform<CMaterialUniformFLOATVEC3>( offset, interface.name, glm::vec3( value0.get<f16>(), value1.get<f16>(), value2.get<f16>() ) );
+												}
+												else
+												{
+													logWARNING( "not all values of uniform '{0}' in '{1}' are floats", interface.name, path.generic_string() );
+													return( false );
+												}
+											}
+											break;
+
+										case 4:
+											{
+												const auto value0 = (*mat_uniform)[ 0 ];
+												const auto value1 = (*mat_uniform)[ 1 ];
+												const auto value2 = (*mat_uniform)[ 2 ];
+												const auto value3 = (*mat_uniform)[ 3 ];
+
+												if( value0.is_number_float()
+													&&
+													value1.is_number_float()
+													&&
+													value2.is_number_float()
+													&&
+													value3.is_number_float() )
 												{
-													const auto value0 = (*mat_uniform)[ 0 ];
-													const auto value1 = (*mat_uniform)[ 1 ];
-													const auto value2 = (*mat_uniform)[ 2 ];
-													const auto value3 = (*mat_uniform)[ 3 ];
-
-													if( value0.is_number_float()
-														&&
-														value1.is_number_float()
-														&&
-														value2.is_number_float()
-														&&
-														value3.is_number_float() )
-													{
-														material->AddMaterialUniform<CMaterialUniformFLOATVEC4>( location, interface.name, glm::vec4( value0.get<f16>(), value1.get<f16>(), value2.get<f16>(), value3.get<f16>() ) );
-													}
-													else
-													{
-														logWARNING( "not all values of uniform '{0}' in '{1}' are floats", interface.name, path.generic_string() );
-														return( false );
-													}
+													material->AddMaterialUniform<CMaterialUniformFLOATVEC4>( offset, interface.name, glm::vec4( value0.get<f16>(), value1.get<f16>(), value2.get<f16>(), value3.get<f16>() ) );
 												}
-												break;
+												else
+												{
+													logWARNING( "not all values of uniform '{0}' in '{1}' are floats", interface.name, path.generic_string() );
+													return( false );
+												}
+											}
+											break;
 
-											default:
-												logWARNING( "unhandled amount of values ('{0}') for uniform {1} in {2}", requiredAmountOfValues, interface.name, path.generic_string() );
-												return( false );
-										}
+										default:
+											logWARNING( "unhandled amount of values ('{0}') for uniform {1} in {2}", requiredAmountOfValues, interface.name, path.generic_string() );
+											return( false );
 									}
 								}
-								break;
+							}
+							break;
 
-							default:
-								logWARNING( "uniform '{0}' in '{1}' is of unsupported type {2}", interface.name, path.generic_string(), glbinding::aux::Meta::getString( interface.type ) );
-								return( false );
-								break;
-						}
+						default:
+							logWARNING( "uniform '{0}' in '{1}' is of unsupported type {2}", interface.name, path.generic_string(), glbinding::aux::Meta::getString( interface.type ) );
+							return( false );
+							break;
 					}
 				}
 			}
 		}
-		else
+	}
+	else
+	{
+		if( !mat_uniforms.is_null() )
 		{
-			if( mat_uniforms != mat_root.end() )
-			{
-				logWARNING( "shaderprogram requires no uniforms but material '{0}' has some specified", path.generic_string() );
-			}
+			logWARNING( "shaderprogram requires no uniforms but material '{0}' has some specified", path.generic_string() );
 		}
 	}
 
+	material->UploadMaterialBlock( m_materialBlockArena );
+
 	return( true );
 }
 
+void CMaterialLoader::FromPlaceholder( const std::shared_ptr<CMaterial> &material, const fs::path &path ) const
+{
+	material->Name( path.generic_string() );
+
+	material->ShaderProgram( m_shaderProgramCompiler.DummyShaderProgram() );
+}
+
 void CMaterialLoader::FromDummy( const std::shared_ptr<CMaterial> &material ) const
 {
 	material->Reset();
 
 	material->Name( "dummy " + std::to_string( ++m_dummyCounter ) );
 	
-	material->ShaderProgram( m_dummyShaderProgram );
+	material->ShaderProgram( m_shaderProgramCompiler.DummyShaderProgram() );
 }
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <optional>
+
+#include "external/json/json.hpp"
+
 #include "src/core/Types.hpp"
 
 #include "CMaterial.hpp"
@@ -12,13 +16,25 @@
 class CMaterialLoader final
 {
 public:
-	CMaterialLoader( const CFileSystem &filesystem, CResources &resources, const std::shared_ptr<const CShaderProgram> &dummyShaderProgram );
+	CMaterialLoader( const CFileSystem &filesystem, CResources &resources, const CShaderProgramCompiler &shaderProgramCompiler, const std::shared_ptr<CMaterialBlockArena> &materialBlockArena );
 	~CMaterialLoader();
 
 	void FromFile( const std::shared_ptr<CMaterial> &material, const fs::path &path ) const;
 
+	// the thread safe part of FromFile, parses the .mat file or returns nothing if that fails
+	[[nodiscard]] std::optional<nlohmann::json> Decode( const fs::path &path ) const;
+
+	// sets up the material from what Decode parsed
+	void FromDecoded( const std::shared_ptr<CMaterial> &material, const fs::path &path, const std::optional<nlohmann::json> &mat_root ) const;
+
+	// renders with the dummy shader program until the material is loaded, without counting as a dummy
+	void FromPlaceholder( const std::shared_ptr<CMaterial> &material, const fs::path &path ) const;
+
 private:
-	bool FromMatFile( const std::shared_ptr<CMaterial> &material, const fs::path &path ) const;
+	bool FromMatRoot( const std::shared_ptr<CMaterial> &material, const nlohmann::json &mat_root, const fs::path &path ) const;
+
+	// resolves the uniforms of the material against the interface of the program, which has to be ready for that
+	bool SetupShaderProgram( const std::shared_ptr<CMaterial> &material, const std::shared_ptr<const CShaderProgram> &shaderProgram, const nlohmann::json &mat_uniforms, const fs::path &path ) const;
 
 	void FromDummy( const std::shared_ptr<CMaterial> &material ) const;
 
@@ -26,7 +42,9 @@ private:
 
 	CResources &m_resources;
 
-	const std::shared_ptr<const CShaderProgram> m_dummyShaderProgram;
+	const CShaderProgramCompiler &m_shaderProgramCompiler;
+
+	const std::shared_ptr<CMaterialBlockArena> m_materialBlockArena;
 
 	static u16 m_dummyCounter;
 };
@@ -1,5 +1,7 @@
 #include "CMaterialUniform.hpp"
 
+#include <cstring>
+
 #include <glm/gtc/type_ptr.hpp>
 
 CMaterialUniform::CMaterialUniform( const std::string &name ) :
@@ -17,9 +19,9 @@ CMaterialUniformFLOAT::CMaterialUniformFLOAT( const std::string &name, const glm
 {
 }
 
-void CMaterialUniformFLOAT::Set( const GLuint location ) const
+void CMaterialUniformFLOAT::Pack( std::byte *destination ) const
 {
-	glUniform1f( location, m_value );
+	std::memcpy( destination, &m_value, sizeof( m_value ) );
 }
 
 
@@ -29,9 +31,9 @@ CMaterialUniformUINT::CMaterialUniformUINT( const std::string &name, const glm::
 {
 }
 
-void CMaterialUniformUINT::Set( const GLuint location ) const
+void CMaterialUniformUINT::Pack( std::byte *destination ) const
 {
-	glUniform1ui( location, m_value );
+	std::memcpy( destination, &m_value, sizeof( m_value ) );
 }
 
 CMaterialUniformFLOATVEC2::CMaterialUniformFLOATVEC2( const std::string &name, const glm::vec2 &values ) :
@@ -40,9 +42,9 @@ CMaterialUniformFLOATVEC2::CMaterialUniformFLOATVEC2( const std::string &name, c
 {
 }
 
-void CMaterialUniformFLOATVEC2::Set( const GLuint location ) const
+void CMaterialUniformFLOATVEC2::Pack( std::byte *destination ) const
 {
-	glUniform2fv( location, 1, glm::value_ptr( m_values ) );
+	std::memcpy( destination, glm::value_ptr( m_values ), sizeof( m_values ) );
 }
 
 CMaterialUniformFLOATVEC3::CMaterialUniformFLOATVEC3( const std::string &name, const glm::vec3 &values ) :
@@ -51,9 +53,9 @@ CMaterialUniformFLOATVEC3::CMaterialUniformFLOATVEC3( const std::string &name, c
 {
 }
 
-void CMaterialUniformFLOATVEC3::Set( const GLuint location ) const
+void CMaterialUniformFLOATVEC3::Pack( std::byte *destination ) const
 {
-	glUniform3fv( location, 1, glm::value_ptr( m_values ) );
+	std::memcpy( destination, glm::value_ptr( m_values ), sizeof( m_values ) );
 }
 
 CMaterialUniformFLOATVEC4::CMaterialUniformFLOATVEC4( const std::string &name, const glm::vec4 &values ) :
@@ -62,7 +64,7 @@ CMaterialUniformFLOATVEC4::CMaterialUniformFLOATVEC4( const std::string &name, c
 {
 }
 
-void CMaterialUniformFLOATVEC4::Set( const GLuint location ) const
+void CMaterialUniformFLOATVEC4::Pack( std::byte *destination ) const
 {
-	glUniform4fv( location, 1, glm::value_ptr( m_values ) );
+	std::memcpy( destination, glm::value_ptr( m_values ), sizeof( m_values ) );
 }
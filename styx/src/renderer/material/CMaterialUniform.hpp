@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include <glm/glm.hpp>
 
 #include "src/renderer/GL.h"
@@ -9,7 +11,8 @@ class CMaterialUniform
 public:
 	virtual ~CMaterialUniform() {};
 
-	virtual void Set( const GLuint location ) const = 0;
+	// copies the value into its place inside the material block
+	virtual void Pack( std::byte *destination ) const = 0;
 
 	const std::string &Name() const;
 
@@ -24,7 +27,7 @@ class CMaterialUniformFLOAT final : public CMaterialUniform
 public:
 	CMaterialUniformFLOAT( const std::string &name, const glm::float32 value );
 
-	void Set( const GLuint location ) const override;
+	void Pack( std::byte *destination ) const override;
 
 private:
 	const glm::float32 m_value;
@@ -35,7 +38,7 @@ class CMaterialUniformUINT final : public CMaterialUniform
 public:
 	CMaterialUniformUINT( const std::string &name, const glm::uint value );
 
-	void Set( const GLuint location ) const override;
+	void Pack( std::byte *destination ) const override;
 
 private:
 	const glm::uint m_value;
@@ -46,7 +49,7 @@ class CMaterialUniformFLOATVEC2 final : public CMaterialUniform
 public:
 	CMaterialUniformFLOATVEC2( const std::string &name, const glm::vec2 &values );
 
-	void Set( const GLuint location ) const override;
+	void Pack( std::byte *destination ) const override;
 
 private:
 	const glm::vec2 m_values;
@@ -57,7 +60,7 @@ class CMaterialUniformFLOATVEC3 final : public CMaterialUniform
 public:
 	CMaterialUniformFLOATVEC3( const std::string &name, const glm::vec3 &values );
 
-	void Set( const GLuint location ) const override;
+	void Pack( std::byte *destination ) const override;
 
 private:
 	const glm::vec3 m_values;
@@ -68,7 +71,7 @@ class CMaterialUniformFLOATVEC4 final : public CMaterialUniform
 public:
 	CMaterialUniformFLOATVEC4( const std::string &name, const glm::vec4 &values );
 
-	void Set( const GLuint location ) const override;
+	void Pack( std::byte *destination ) const override;
 
 private:
 	const glm::vec4 m_values;
@@ -1,5 +1,8 @@
 #include "CMesh.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include <glbinding-aux/Meta.h>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -8,10 +11,14 @@
 
 #include "src/logger/CLogger.hpp"
 
+#include "src/renderer/CGLState.hpp"
+
 void CMesh::SetMaterial( const std::shared_ptr<const CMaterial> &mat )
 {
 	m_material = mat;
 
+	m_materialInstance = nullptr;
+
 	SetupMaterialTextureSlotMapping();
 
 	/* TODO setup the necessary things for the material
@@ -76,12 +83,16 @@ void CMesh::ChangeTextureAndSampler( const std::string &slotName, const std::sha
 	}
 }
 
-void CMesh::SetupMaterialTextureSlotMapping()
+void CMesh::SetupMaterialTextureSlotMapping() const
 {
 	m_materialTextureSlotMapping.clear();
 
+	m_mappedShaderProgram = nullptr;
+
 	if( m_material )
 	{
+		m_mappedShaderProgram = m_material->ShaderProgram().get();
+
 		for( const auto & [ location, interface ] : m_material->ShaderProgram()->RequiredSamplers() )
 		{
 			if( const auto textureSlot = m_textureSlots.find( interface.name ); textureSlot != std::cend( m_textureSlots ) )
@@ -135,12 +146,49 @@ const std::shared_ptr<const CMaterial> &CMesh::Material() const
 	return( m_material );
 }
 
+void CMesh::SetMaterialInstance( const std::shared_ptr<const CMaterialInstance> &materialInstance )
+{
+	SetMaterial( materialInstance->Parent() );
+
+	m_materialInstance = materialInstance;
+}
+
+const std::shared_ptr<const CMaterialInstance> &CMesh::MaterialInstance() const
+{
+	return( m_materialInstance );
+}
+
+CMesh::TGeometry CMesh::ReadGeometry() const
+{
+	return( m_readGeometry() );
+}
+
+SMemoryUsage CMesh::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage;
+
+	memoryUsage.cpu = sizeof( CMesh ) + m_textureSlots.size() * sizeof( CMeshTextureSlot );
+	memoryUsage.gpu = m_vao.Size();
+
+	return( memoryUsage );
+}
+
+const CMesh::TMeshTextureSlots &CMesh::TextureSlots() const
+{
+	return( m_textureSlots );
+}
+
 void CMesh::Bind() const
 {
+	if( m_material && ( m_material->ShaderProgram().get() != m_mappedShaderProgram ) )
+	{
+		SetupMaterialTextureSlotMapping();
+	}
+
 	u8 textureUnit = 0;
 	for( const auto & [ location, meshTextureSlot ] : m_materialTextureSlotMapping )
 	{
-		glUniform1i( location, textureUnit );
+		CGLState::Uniform1i( location, textureUnit );
 
 		meshTextureSlot->BindToUnit( textureUnit );
 
@@ -150,6 +198,30 @@ void CMesh::Bind() const
 	m_vao.Bind();
 }
 
+void CMesh::RequestTextureMips( const u64 frame, const f16 screenPixels ) const
+{
+	// a tiling material samples the texture that often across the pixels of the mesh
+	const f16 uvScale = m_material ? m_material->UVScale() : 1.0f;
+
+	for( const auto & [ location, meshTextureSlot ] : m_materialTextureSlotMapping )
+	{
+		const auto &texture = meshTextureSlot->m_texture;
+
+		if( texture && texture->Streamed )
+		{
+			const auto &size = texture->MipChain.size;
+
+			const f16 texels = static_cast<f16>( std::max( size.width, size.height ) ) * uvScale;
+
+			const f16 mip = std::floor( std::log2( texels / std::max( screenPixels, 1.0f ) ) );
+
+			const f16 coarsestMip = static_cast<f16>( texture->MipChain.levelBytes.size() - 1 );
+
+			texture->RequestMip( frame, static_cast<u8>( std::clamp( mip, 0.0f, coarsestMip ) ) );
+		}
+	}
+}
+
 void CMesh::Draw() const
 {
 	m_vao.Draw();
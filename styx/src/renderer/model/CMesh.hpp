@@ -2,12 +2,17 @@
 
 #include <vector>
 #include <unordered_map>
+#include <variant>
+#include <functional>
 
 #include <glm/glm.hpp>
 
+#include "src/core/SMemoryUsage.hpp"
+
 #include "src/renderer/model/CMeshTextureSlot.hpp"
 
 #include "src/renderer/material/CMaterial.hpp"
+#include "src/renderer/material/CMaterialInstance.hpp"
 #include "src/renderer/CVertexArrayObject.hpp"
 
 class CMesh final
@@ -17,11 +22,22 @@ friend class CModelLoader;
 public:
 	using TMeshTextureSlots = std::unordered_map<std::string, const std::shared_ptr<CMeshTextureSlot>>;
 
+	using TGeometry = std::variant<	Geometry<VertexP>,
+									Geometry<VertexPN>,
+									Geometry<VertexPC>,
+									Geometry<VertexPU0>,
+									Geometry<VertexPCU0>,
+									Geometry<VertexPNU0>,
+									Geometry<VertexPNTB>,
+									Geometry<VertexPNTBU0>,
+									Geometry<VertexPNTBCU0U1U2U3>>;
+
 	template<typename T>
 	CMesh( const Geometry<T> &geometry, const std::shared_ptr<const CMaterial> &mat, const TMeshTextureSlots &textureSlots = TMeshTextureSlots(), const bool dynamic = false ) :
 		m_vao( geometry, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW ),
 		m_material { mat },
 		m_textureSlots { textureSlots },
+		m_readGeometry { [ this ]() -> TGeometry { return( m_vao.ReadGeometry<T>() ); } },
 		BoundingSphereRadiusVector { geometry.CalculateBoundingSphereRadiusVector() }
 	{
 		SetupMaterialTextureSlotMapping();
@@ -31,30 +47,52 @@ public:
 	void SetGeometry( const Geometry<T> &geometry )
 	{
 		m_vao.Rebuild( geometry );
+		m_readGeometry = [ this ]() -> TGeometry { return( m_vao.ReadGeometry<T>() ); };
 		BoundingSphereRadiusVector = geometry.CalculateBoundingSphereRadiusVector();
 	}
 
+	// reads the geometry back from the GPU, since the mesh doesn't keep a copy of it
+	[[nodiscard]] TGeometry ReadGeometry() const;
+
+	const TMeshTextureSlots &TextureSlots() const;
+
 	void SetMaterial( const std::shared_ptr<const CMaterial> &mat );
 	const std::shared_ptr<const CMaterial> &Material() const;
 
+	// also sets the parent of the instance as the material
+	void SetMaterialInstance( const std::shared_ptr<const CMaterialInstance> &materialInstance );
+	const std::shared_ptr<const CMaterialInstance> &MaterialInstance() const;
+
 	void ChangeTexture( const std::string &slotName, const std::shared_ptr<const CTexture> &texture );
 	void ChangeSampler( const std::string &slotName, const std::shared_ptr<const CSampler> &sampler );
 	void ChangeTextureAndSampler( const std::string &slotName, const std::shared_ptr<const CTexture> &texture, const std::shared_ptr<const CSampler> &sampler );
 
 	void Bind() const;
 
+	// lets the textures of the bound mapping know how many pixels the mesh covers on screen
+	void RequestTextureMips( const u64 frame, const f16 screenPixels ) const;
+
 	void Draw() const;
 
+	// the material and the textures are resources of their own and not counted here
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 private:
 	CVertexArrayObject m_vao;
 
 	std::shared_ptr<const CMaterial> m_material;
 
+	std::shared_ptr<const CMaterialInstance> m_materialInstance;
+
 	const TMeshTextureSlots m_textureSlots;
 
-	std::vector<std::pair<GLuint, const std::shared_ptr<const CMeshTextureSlot>>> m_materialTextureSlotMapping;
+	std::function<TGeometry()> m_readGeometry;
+
+	// rebuilt lazily when the material switches its shader program, which happens when it was waiting for it to be linked
+	mutable std::vector<std::pair<GLuint, const std::shared_ptr<const CMeshTextureSlot>>> m_materialTextureSlotMapping;
+	mutable const CShaderProgram *m_mappedShaderProgram { nullptr };
 
-	void SetupMaterialTextureSlotMapping();
+	void SetupMaterialTextureSlotMapping() const;
 
 public:
 	glm::vec3	BoundingSphereRadiusVector;
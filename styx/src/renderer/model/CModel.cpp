@@ -11,4 +11,16 @@ CModel::~CModel()
 void CModel::Reset()
 {
 	Meshes.clear();
+}
+
+SMemoryUsage CModel::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage { sizeof( CModel ), 0 };
+
+	for( const auto &mesh : Meshes )
+	{
+		memoryUsage += mesh.MemoryUsage();
+	}
+
+	return( memoryUsage );
 }
\ No newline at end of file
@@ -17,5 +17,7 @@ public:
 
 	void Reset();
 
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 	std::vector<CMesh> Meshes;
 };
@@ -21,6 +21,13 @@ private:
 		m_modelLoader.FromFile( resource, id );
 	}
 
+	TFinisher Decode( const std::string &id ) const override
+	{
+		const std::shared_ptr<const Assimp::Importer> importer = m_modelLoader.Decode( id );
+
+		return( [ this, id, importer ]( const std::shared_ptr<CModel> &resource ) { m_modelLoader.FromDecoded( resource, id, importer.get() ); } );
+	}
+
 private:
 	const CModelLoader m_modelLoader;
 };
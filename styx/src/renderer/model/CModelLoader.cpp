@@ -18,6 +18,33 @@ CModelLoader::~CModelLoader()
 }
 
 void CModelLoader::FromFile( const std::shared_ptr<CModel> &model, const fs::path &path ) const
+{
+	FromDecoded( model, path, Decode( path ).get() );
+}
+
+std::unique_ptr<Assimp::Importer> CModelLoader::Decode( const fs::path &path ) const
+{
+	if( !path.has_filename() || ( std::string( ".dae" ) != path.extension().generic_string() ) || !m_filesystem.Exists( path ) )
+	{
+		return( nullptr );
+	}
+
+	const CFileView file = m_filesystem.MapFile( path );
+
+	auto importer = std::make_unique<Assimp::Importer>();
+
+	const aiScene *assimpScene = importer->ReadFileFromMemory( file.Data(), file.Size(), aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace, nullptr );
+
+	if( !assimpScene || ( assimpScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ) || !assimpScene->mRootNode )
+	{
+		logWARNING( "failed to load '{0}' because of: {1}", path.generic_string(), importer->GetErrorString() );
+		return( nullptr );
+	}
+
+	return( importer );
+}
+
+void CModelLoader::FromDecoded( const std::shared_ptr<CModel> &model, const fs::path &path, const Assimp::Importer *importer ) const
 {
 	if( !path.has_filename() )
 	{
@@ -36,7 +63,7 @@ void CModelLoader::FromFile( const std::shared_ptr<CModel> &model, const fs::pat
 
 		if( std::string( ".dae" ) == fileExtensionString )
 		{
-			if( !FromDaeFile( model, path ) )
+			if( ( nullptr == importer ) || !FromAssimpScene( model, importer->GetScene() ) )
 			{
 				FromDummy( model );
 			}
@@ -49,25 +76,6 @@ void CModelLoader::FromFile( const std::shared_ptr<CModel> &model, const fs::pat
 	}
 }
 
-bool CModelLoader::FromDaeFile( const std::shared_ptr<CModel> &model, const fs::path &path ) const
-{
-	const auto buffer = m_filesystem.LoadFileToBuffer( path );
-
-	Assimp::Importer importer;
-
-	const aiScene *assimpScene = importer.ReadFileFromMemory( buffer.data(), buffer.size(), aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace, nullptr );
-
-	if( !assimpScene || ( assimpScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE ) || !assimpScene->mRootNode )
-	{
-		logWARNING( "failed to load '{0}' because of: {1}", path.generic_string(), importer.GetErrorString() );
-		return( false );
-	}
-
-	FromAssimpScene( model, assimpScene );
-
-	return( true );
-}
-
 bool CModelLoader::FromAssimpScene( const std::shared_ptr<CModel> &model, const aiScene *assimpScene ) const
 {
 	model->Meshes.reserve( assimpScene->mNumMeshes );
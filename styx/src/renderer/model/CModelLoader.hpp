@@ -26,13 +26,17 @@ public:
 
 	void FromFile( const std::shared_ptr<CModel> &model, const fs::path &path ) const;
 
+	// the thread safe part of FromFile, the imported scene lives as long as the importer, nullptr if importing failed
+	[[nodiscard]] std::unique_ptr<Assimp::Importer> Decode( const fs::path &path ) const;
+
+	// builds the model from the scene which was imported by Decode
+	void FromDecoded( const std::shared_ptr<CModel> &model, const fs::path &path, const Assimp::Importer *importer ) const;
+
 private:
 	const CFileSystem &m_filesystem;
 
 	CResources &m_resources;
 
-	bool FromDaeFile( const std::shared_ptr<CModel> &model, const fs::path &path ) const;
-
 	bool FromAssimpScene( const std::shared_ptr<CModel> &model, const aiScene *assimpScene ) const;
 
 	bool ProcessMesh( const std::shared_ptr<CModel> &model, const aiMesh *assimpMesh ) const;
@@ -0,0 +1,262 @@
+#include "CStaticBatches.hpp"
+
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <type_traits>
+#include <limits>
+#include <array>
+
+#include <glm/gtc/matrix_inverse.hpp>
+
+#include "external/minitrace/minitrace.h"
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/renderer/components/CModelComponent.hpp"
+
+const f16 CStaticBatches::CellSize { 64.0f };
+
+template<typename T, typename = void> struct HasNormal : std::false_type {};
+template<typename T> struct HasNormal<T, std::void_t<decltype( T::Normal )>> : std::true_type {};
+
+template<typename T, typename = void> struct HasTangent : std::false_type {};
+template<typename T> struct HasTangent<T, std::void_t<decltype( T::Tangent )>> : std::true_type {};
+
+template<typename T, typename = void> struct HasBitangent : std::false_type {};
+template<typename T> struct HasBitangent<T, std::void_t<decltype( T::Bitangent )>> : std::true_type {};
+
+// the mode in which merged geometry of this mode is drawn, or GL_NONE when it can't be merged
+static GLenum BatchMode( const GLenum mode )
+{
+	switch( mode )
+	{
+		case GL_TRIANGLES:
+		case GL_TRIANGLE_STRIP:
+		case GL_TRIANGLE_FAN:
+			return( GL_TRIANGLES );
+
+		case GL_LINES:
+		case GL_POINTS:
+			return( mode );
+
+		default:
+			return( GL_NONE );
+	}
+}
+
+// appends the geometry transformed into world space, strips and fans get converted into plain triangles
+template<typename T>
+static void AppendGeometry( Geometry<T> &merged, const Geometry<T> &geometry, const glm::mat4 &modelMatrix )
+{
+	const glm::mat3 normalMatrix = glm::inverseTranspose( glm::mat3( modelMatrix ) );
+
+	const u32 offset = static_cast<u32>( merged.Vertices.size() );
+
+	for( auto vertex : geometry.Vertices )
+	{
+		vertex.Position = glm::vec3( modelMatrix * glm::vec4( vertex.Position, 1.0f ) );
+
+		if constexpr( HasNormal<T>::value )
+		{
+			vertex.Normal = glm::normalize( normalMatrix * vertex.Normal );
+		}
+
+		if constexpr( HasTangent<T>::value )
+		{
+			vertex.Tangent = glm::normalize( glm::mat3( modelMatrix ) * vertex.Tangent );
+		}
+
+		if constexpr( HasBitangent<T>::value )
+		{
+			vertex.Bitangent = glm::normalize( glm::mat3( modelMatrix ) * vertex.Bitangent );
+		}
+
+		merged.Vertices.push_back( vertex );
+	}
+
+	const auto &indices = geometry.Indices;
+
+	switch( geometry.Mode )
+	{
+		case GL_TRIANGLE_STRIP:
+			for( size_t i = 2; i < indices.size(); i++ )
+			{
+				// every second triangle of a strip has a flipped winding
+				if( i % 2 == 0 )
+				{
+					merged.Indices.insert( std::end( merged.Indices ), { offset + indices[ i - 2 ], offset + indices[ i - 1 ], offset + indices[ i ] } );
+				}
+				else
+				{
+					merged.Indices.insert( std::end( merged.Indices ), { offset + indices[ i - 1 ], offset + indices[ i - 2 ], offset + indices[ i ] } );
+				}
+			}
+			break;
+
+		case GL_TRIANGLE_FAN:
+			for( size_t i = 2; i < indices.size(); i++ )
+			{
+				merged.Indices.insert( std::end( merged.Indices ), { offset + indices[ 0 ], offset + indices[ i - 1 ], offset + indices[ i ] } );
+			}
+			break;
+
+		default:
+			for( const auto index : indices )
+			{
+				merged.Indices.push_back( offset + index );
+			}
+			break;
+	}
+}
+
+void CStaticBatches::Update( const CScene &scene )
+{
+	if( m_revision != CModelComponent::s_staticRevision )
+	{
+		m_revision = CModelComponent::s_staticRevision;
+
+		Rebuild( scene );
+	}
+}
+
+const std::vector<CStaticBatches::SBatch> &CStaticBatches::Batches() const
+{
+	return( m_batches );
+}
+
+void CStaticBatches::Rebuild( const CScene &scene )
+{
+	MTR_SCOPE( "GFX", "RebuildStaticBatches" );
+
+	m_batches.clear();
+
+	using TTextureKey = std::vector<std::tuple<std::string, const CTexture *, const CSampler *>>;
+
+	// material, material instance, vertex layout, mode, grid cell and textures have to match for meshes to be merged
+	using TBatchKey = std::tuple<const CMaterial *, const CMaterialInstance *, size_t, GLenum, std::array<s32, 3>, TTextureKey>;
+
+	struct SBatchPart final
+	{
+		std::shared_ptr<CModelComponent> ModelComponent;
+		glm::mat4 ModelMatrix;
+	};
+
+	// a mesh is most often shared by many entities, so read its geometry back only once
+	std::unordered_map<const CMesh *, CMesh::TGeometry> geometries;
+
+	std::map<TBatchKey, std::vector<SBatchPart>> batchParts;
+
+	scene.Each<CModelComponent>( [ &geometries, &batchParts ]( const std::shared_ptr<const CEntity> &entity )
+	{
+		const auto modelComponent = entity->Get<CModelComponent>();
+
+		modelComponent->m_batched = false;
+
+		if( !modelComponent->m_static )
+		{
+			return;
+		}
+
+		const CMesh * mesh = modelComponent->Mesh.get();
+
+		// blended meshes have to be sorted back to front, which isn't possible anymore once they are merged
+		const CMaterial * material = mesh->Material().get();
+		if( ( nullptr == material ) || material->Blending() )
+		{
+			return;
+		}
+
+		auto geometry = geometries.find( mesh );
+		if( geometry == std::end( geometries ) )
+		{
+			geometry = geometries.emplace( mesh, mesh->ReadGeometry() ).first;
+		}
+
+		const GLenum batchMode = BatchMode( std::visit( []( const auto &g ) { return( g.Mode ); }, geometry->second ) );
+		if( GL_NONE == batchMode )
+		{
+			return;
+		}
+
+		TTextureKey textures;
+		for( const auto & [ name, textureSlot ] : mesh->TextureSlots() )
+		{
+			textures.emplace_back( name, textureSlot->m_texture.get(), textureSlot->m_sampler.get() );
+		}
+		std::sort( std::begin( textures ), std::end( textures ) );
+
+		const auto &position = entity->Transform.Position;
+
+		const std::array<s32, 3> cell = {	static_cast<s32>( std::floor( position.x / CellSize ) ),
+											static_cast<s32>( std::floor( position.y / CellSize ) ),
+											static_cast<s32>( std::floor( position.z / CellSize ) ) };
+
+		batchParts[ { material, mesh->MaterialInstance().get(), geometry->second.index(), batchMode, cell, textures } ].push_back( { modelComponent, entity->Transform.ModelMatrix() } );
+	} );
+
+	u32 batchedMeshes { 0 };
+
+	for( const auto & [ key, parts ] : batchParts )
+	{
+		// merging a single mesh only costs memory
+		if( parts.size() < 2 )
+		{
+			continue;
+		}
+
+		const auto &firstMesh = parts.front().ModelComponent->Mesh;
+
+		const GLenum batchMode = std::get<3>( key );
+
+		std::visit( [ this, &parts, &geometries, &firstMesh, batchMode ]( const auto &firstGeometry )
+		{
+			using TGeometryType = std::decay_t<decltype( firstGeometry )>;
+
+			TGeometryType merged;
+			merged.Mode = batchMode;
+
+			for( const auto &part : parts )
+			{
+				AppendGeometry( merged, std::get<TGeometryType>( geometries.at( part.ModelComponent->Mesh.get() ) ), part.ModelMatrix );
+			}
+
+			// move the origin into the center of the batch, so that the bounding sphere of the mesh stays tight
+			glm::vec3 min { std::numeric_limits<f16>::max() };
+			glm::vec3 max { std::numeric_limits<f16>::lowest() };
+
+			for( const auto &vertex : merged.Vertices )
+			{
+				min = glm::min( min, vertex.Position );
+				max = glm::max( max, vertex.Position );
+			}
+
+			const glm::vec3 center = ( min + max ) / 2.0f;
+
+			for( auto &vertex : merged.Vertices )
+			{
+				vertex.Position -= center;
+			}
+
+			const auto batchMesh = std::make_shared<CMesh>( merged, firstMesh->Material(), firstMesh->TextureSlots() );
+
+			if( firstMesh->MaterialInstance() )
+			{
+				batchMesh->SetMaterialInstance( firstMesh->MaterialInstance() );
+			}
+
+			m_batches.push_back( { batchMesh, center } );
+		}, geometries.at( firstMesh.get() ) );
+
+		for( const auto &part : parts )
+		{
+			part.ModelComponent->m_batched = true;
+		}
+
+		batchedMeshes += parts.size();
+	}
+
+	logDEBUG( "merged {0} static meshes into {1} batches", batchedMeshes, m_batches.size() );
+}
\ No newline at end of file
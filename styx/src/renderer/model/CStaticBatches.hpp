@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "src/core/Types.hpp"
+
+#include "src/scene/CScene.hpp"
+
+#include "src/renderer/model/CMesh.hpp"
+
+/**	Merges the meshes of all static CModelComponents which share material, textures and vertex layout
+	into a few large pre-transformed meshes, one per cell of a coarse grid, so that they can still be culled.
+*/
+class CStaticBatches final
+{
+public:
+	struct SBatch final
+	{
+		std::shared_ptr<const CMesh> Mesh;
+
+		// the vertices of the mesh are relative to this position
+		glm::vec3 Position;
+	};
+
+	// rebuilds the batches, when a static flag changed since the last call
+	void Update( const CScene &scene );
+
+	[[nodiscard]] const std::vector<SBatch> &Batches() const;
+
+	static const f16 CellSize;
+
+private:
+	void Rebuild( const CScene &scene );
+
+	std::vector<SBatch> m_batches;
+
+	u32 m_revision { 0 };
+};
\ No newline at end of file
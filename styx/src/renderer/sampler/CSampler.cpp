@@ -9,7 +9,7 @@ CSampler::CSampler()
 
 CSampler::~CSampler()
 {
-	glDeleteSamplers( 1, &m_samplerID );
+	CGLState::DeleteSampler( m_samplerID );
 }
 
 void CSampler::Parametere( const GLenum pname, const GLenum param )
@@ -10,4 +10,11 @@ void CShader::Reset()
 	glDeleteShader( GLID );
 
 	GLID = 0;
+
+	Source.clear();
+}
+
+SMemoryUsage CShader::MemoryUsage() const
+{
+	return( SMemoryUsage { sizeof( CShader ) + Source.capacity(), 0 } );
 }
\ No newline at end of file
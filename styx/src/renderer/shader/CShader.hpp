@@ -1,6 +1,9 @@
 #pragma once
 
+#include <string>
+
 #include "src/core/Types.hpp"
+#include "src/core/SMemoryUsage.hpp"
 
 #include "src/renderer/GL.h"
 
@@ -22,5 +25,11 @@ public:
 
 	void Reset();
 
+	// the driver doesn't tell how much the compiled shader takes, so only the source is counted
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 	GLuint GLID = 0;
+
+	// the complete source as it was handed to the driver, including everything the compiler prepended
+	std::string Source;
 };
\ No newline at end of file
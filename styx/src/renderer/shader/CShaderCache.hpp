@@ -19,5 +19,15 @@ private:
 		m_shaderLoader.FromFile( resource, id );
 	}
 
+	TFinisher Decode( const std::string &id ) const override
+	{
+		return( [ this, id, body = m_shaderLoader.Decode( id ) ]( const std::shared_ptr<CShader> &resource ) { m_shaderLoader.FromDecoded( resource, id, body ); } );
+	}
+
+	void LoadPlaceholder( const std::shared_ptr<CShader> &resource, const std::string &id ) const override
+	{
+		m_shaderLoader.FromDummy( resource, id );
+	}
+
 	const CShaderLoader m_shaderLoader;
 };
@@ -1,5 +1,7 @@
 #include "CShaderCompiler.hpp"
 
+#include <algorithm>
+
 #include <glbinding-aux/Meta.h>
 
 #include "src/renderer/GLHelper.hpp"
@@ -7,6 +9,9 @@
 #include "src/logger/CLogger.hpp"
 
 const std::string CShaderCompiler::srcAdditionShaderVersion = "#version 430\n";
+const std::string CShaderCompiler::srcAdditionBlockLayout = "layout( std140 ) uniform;\n";
+
+const std::string CShaderCompiler::MaterialBlockName = "MaterialBlock";
 
 const std::map<const AttributeLocation, const SShaderInterface> CShaderCompiler::AllowedAttributes = {	{ AttributeLocation::position,		{ "position",	GLHelper::glmTypeToGLSLType<glm::vec3>() } },
 																										{ AttributeLocation::normal,		{ "normal",		GLHelper::glmTypeToGLSLType<glm::vec3>() } },
@@ -48,7 +53,8 @@ void main()
 }
 )glsl";
 
-CShaderCompiler::CShaderCompiler()
+CShaderCompiler::CShaderCompiler( const COpenGlAdapter &openGlAdapter ) :
+	m_parallelCompile { openGlAdapter.ParallelShaderCompile() }
 {
 	if( !Compile( m_dummyVertexShader, GL_VERTEX_SHADER, DummyVertexShaderBody ) )
 	{
@@ -68,13 +74,23 @@ CShaderCompiler::CShaderCompiler()
 
 void CShaderCompiler::RegisterUniformBuffer( const std::shared_ptr<const CUniformBuffer> &ubo )
 {
-	m_registeredUniformBuffers.insert( ubo );
+	if( std::end( m_registeredUniformBuffers ) == std::find( std::begin( m_registeredUniformBuffers ), std::end( m_registeredUniformBuffers ), ubo ) )
+	{
+		m_registeredUniformBuffers.push_back( ubo );
+	}
 }
 
-bool CShaderCompiler::Compile( const std::shared_ptr<CShader> &shader, const GLenum type, const std::string &body ) const
+bool CShaderCompiler::Compile( const std::shared_ptr<CShader> &shader, const GLenum type, const std::string &body, const ShaderVariant::TKeywords &keywords ) const
 {
 	std::string source = srcAdditionShaderVersion;
 
+	for( const auto &keyword : keywords )
+	{
+		source += "#define " + keyword + "\n";
+	}
+
+	source += srcAdditionBlockLayout;
+
 	switch( type )
 	{
 	case GL_VERTEX_SHADER:
@@ -135,20 +151,32 @@ bool CShaderCompiler::Compile( const std::shared_ptr<CShader> &shader, const GLe
 
 	glCompileShader( shader->GLID );
 
+	if( !m_parallelCompile && !CheckCompileStatus( *shader ) )
+	{
+		shader->Reset();
+
+		return( false );
+	}
+
+	shader->Source = std::move( source );
+
+	return( true );
+}
+
+bool CShaderCompiler::CheckCompileStatus( const CShader &shader ) const
+{
 	GLint compileResult;
-	glGetShaderiv( shader->GLID, GL_COMPILE_STATUS, &compileResult );
+	glGetShaderiv( shader.GLID, GL_COMPILE_STATUS, &compileResult );
 
 	if( compileResult != static_cast<GLint>( GL_TRUE ) )
 	{
 		int infoLogLength;
-		glGetShaderiv( shader->GLID, GL_INFO_LOG_LENGTH, &infoLogLength );
+		glGetShaderiv( shader.GLID, GL_INFO_LOG_LENGTH, &infoLogLength );
 		std::vector<char> errorMessage( infoLogLength );
-		glGetShaderInfoLog( shader->GLID, infoLogLength, nullptr, errorMessage.data() );
+		glGetShaderInfoLog( shader.GLID, infoLogLength, nullptr, errorMessage.data() );
 
 		logWARNING( "Error compiling shader: {0}", errorMessage.data() );
 
-		shader->Reset();
-
 		return( false );
 	}
 
@@ -1,24 +1,32 @@
 #pragma once
 
 #include <memory>
-#include <unordered_set>
+#include <vector>
+#include <unordered_map>
 #include <map>
 
+#include "src/renderer/COpenGlAdapter.hpp"
 #include "src/renderer/CUniformBuffer.hpp"
 #include "src/renderer/CVertexArrayObject.hpp"
 
 #include "src/renderer/shader/CShader.hpp"
 #include "src/renderer/shader/EEngineUniform.hpp"
 #include "src/renderer/shader/SShaderInterface.hpp"
+#include "src/renderer/shader/ShaderVariant.hpp"
 
 #include "src/renderer/AttributeLocation.hpp"
 
 class CShaderCompiler final
 {
 public:
-	CShaderCompiler();
+	explicit CShaderCompiler( const COpenGlAdapter &openGlAdapter );
 
-	bool Compile( const std::shared_ptr<CShader> &shader, const GLenum type, const std::string &body ) const;
+	// with parallel compilation the status is not queried here, errors will then show up when the program gets linked
+	// every keyword gets defined right after the version line, so the body can select a variant via #ifdef
+	bool Compile( const std::shared_ptr<CShader> &shader, const GLenum type, const std::string &body, const ShaderVariant::TKeywords &keywords = {} ) const;
+
+	// blocks until the shader is compiled and logs the errors if it failed
+	bool CheckCompileStatus( const CShader &shader ) const;
 
 	void RegisterUniformBuffer( const std::shared_ptr<const CUniformBuffer> &ubo );
 
@@ -26,6 +34,9 @@ public:
 
 	static const std::unordered_map<EEngineUniform, const SShaderInterface> EngineUniforms;
 
+	// all uniforms which get provided by the material have to be declared inside of a block with this name
+	static const std::string MaterialBlockName;
+
 	static const std::string DummyVertexShaderBody;
 	static const std::string DummyGeometryShaderBody;
 	static const std::string DummyFragmentShaderBody;
@@ -36,8 +47,12 @@ public:
 
 private:
 	static const std::string srcAdditionShaderVersion;
+	static const std::string srcAdditionBlockLayout;
+
+	const bool m_parallelCompile;
 	
-	std::unordered_set<std::shared_ptr<const CUniformBuffer>> m_registeredUniformBuffers;
+	// kept in registration order, so the generated source is the same on every run
+	std::vector<std::shared_ptr<const CUniformBuffer>> m_registeredUniformBuffers;
 
 	const std::shared_ptr<CShader> m_dummyVertexShader = std::make_shared<CShader>();
 	const std::shared_ptr<CShader> m_dummyGeometryShader = std::make_shared<CShader>();
@@ -4,6 +4,8 @@
 
 #include "src/core/FileExtension.hpp"
 
+#include "src/renderer/shader/ShaderVariant.hpp"
+
 CShaderLoader::CShaderLoader( const CFileSystem &p_filesystem, const CShaderCompiler &shaderCompiler ) :
 		m_filesystem { p_filesystem },
 		m_shaderCompiler { shaderCompiler }
@@ -16,8 +18,27 @@ CShaderLoader::~CShaderLoader()
 	logINFO( "shader loader is shutting down" );
 }
 
-void CShaderLoader::FromFile( const std::shared_ptr<CShader> &shader, const fs::path &path ) const
+void CShaderLoader::FromFile( const std::shared_ptr<CShader> &shader, const std::string &id ) const
 {
+	FromDecoded( shader, id, Decode( id ) );
+}
+
+std::optional<std::string> CShaderLoader::Decode( const std::string &id ) const
+{
+	const fs::path path = ShaderVariant::Path( id );
+
+	if( !path.has_filename() || !m_filesystem.Exists( path ) )
+	{
+		return( std::nullopt );
+	}
+
+	return( m_filesystem.LoadFileToString( path ) );
+}
+
+void CShaderLoader::FromDecoded( const std::shared_ptr<CShader> &shader, const std::string &id, const std::optional<std::string> &body ) const
+{
+	const fs::path path = ShaderVariant::Path( id );
+
 	if( !path.has_filename() )
 	{
 		logWARNING( "path '{0}' does not containt a filename", path.generic_string() );
@@ -36,54 +57,73 @@ void CShaderLoader::FromFile( const std::shared_ptr<CShader> &shader, const fs::
 		logWARNING( "file type '{0}' of shader file '{1}' is not supported", fileExtensionString, path.generic_string() );
 		// TODO what to do here? since we don't have a proper file extensions, we don't know what kind of shader was wanted
 	}
-	else if( !m_filesystem.Exists( path ) )
+	else if( !body )
 	{
 		logWARNING( "shader file '{0}' does not exist", path.generic_string() );
 		
-		if( fileExtensionString == FileExtension::Shader::vertex )
-		{
-			FromVertexDummy( shader );
-		}
-		else if( fileExtensionString == FileExtension::Shader::geometry )
-		{
-			FromGeometryDummy( shader );
-		}
-		else if( fileExtensionString == FileExtension::Shader::fragment )
-		{
-			FromFragmentDummy( shader );
-		}
+		FromDummy( shader, id );
 	}
 	else
 	{
-		const std::string body = m_filesystem.LoadFileToString( path );
+		ShaderVariant::TKeywords keywords;
+
+		for( const auto &keyword : ShaderVariant::Keywords( id ) )
+		{
+			if( ShaderVariant::IsValidKeyword( keyword ) )
+			{
+				keywords.insert( keyword );
+			}
+			else
+			{
+				logWARNING( "ignoring invalid keyword '{0}' for shader '{1}'", keyword, path.generic_string() );
+			}
+		}
 
 		if( fileExtensionString == FileExtension::Shader::vertex )
 		{
-			if( !m_shaderCompiler.Compile( shader, GL_VERTEX_SHADER, body ) )
+			if( !m_shaderCompiler.Compile( shader, GL_VERTEX_SHADER, *body, keywords ) )
 			{
-				logWARNING( "couldn't create vertex shader from '{0}'", path.generic_string() )
+				logWARNING( "couldn't create vertex shader from '{0}'", id )
 				FromVertexDummy( shader );
 			}
 		}
 		else if( fileExtensionString == FileExtension::Shader::geometry )
 		{
-			if( !m_shaderCompiler.Compile( shader, GL_GEOMETRY_SHADER, body ) )
+			if( !m_shaderCompiler.Compile( shader, GL_GEOMETRY_SHADER, *body, keywords ) )
 			{
-				logWARNING( "couldn't create geometry shader from '{0}'", path.generic_string() )
+				logWARNING( "couldn't create geometry shader from '{0}'", id )
 				FromGeometryDummy( shader );
 			}
 		}
 		else if( fileExtensionString == FileExtension::Shader::fragment )
 		{
-			if( !m_shaderCompiler.Compile( shader, GL_FRAGMENT_SHADER, body ) )
+			if( !m_shaderCompiler.Compile( shader, GL_FRAGMENT_SHADER, *body, keywords ) )
 			{
-				logWARNING( "couldn't create fragment shader from '{0}'", path.generic_string() )
+				logWARNING( "couldn't create fragment shader from '{0}'", id )
 				FromFragmentDummy( shader );
 			}
 		}
 	}
 }
 
+void CShaderLoader::FromDummy( const std::shared_ptr<CShader> &shader, const std::string &id ) const
+{
+	const std::string fileExtensionString = ShaderVariant::Path( id ).extension().generic_string();
+
+	if( fileExtensionString == FileExtension::Shader::vertex )
+	{
+		FromVertexDummy( shader );
+	}
+	else if( fileExtensionString == FileExtension::Shader::geometry )
+	{
+		FromGeometryDummy( shader );
+	}
+	else if( fileExtensionString == FileExtension::Shader::fragment )
+	{
+		FromFragmentDummy( shader );
+	}
+}
+
 void CShaderLoader::FromVertexDummy( const std::shared_ptr<CShader> &shader ) const
 {
 	shader->Reset();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "src/system/CFileSystem.hpp"
 
@@ -14,7 +16,17 @@ public:
 	CShaderLoader( const CFileSystem &p_filesystem, const CShaderCompiler &shaderCompiler );
 	~CShaderLoader();
 
-	void FromFile( const std::shared_ptr<CShader> &shader, const fs::path &path ) const;
+	// the id is the path of the file, optionally followed by the keywords of the variant
+	void FromFile( const std::shared_ptr<CShader> &shader, const std::string &id ) const;
+
+	// the thread safe part of FromFile, reads the source or nothing if the file doesn't exist
+	[[nodiscard]] std::optional<std::string> Decode( const std::string &id ) const;
+
+	// compiles the source which was read by Decode
+	void FromDecoded( const std::shared_ptr<CShader> &shader, const std::string &id, const std::optional<std::string> &body ) const;
+
+	// the dummy of the kind of shader the extension of the id names
+	void FromDummy( const std::shared_ptr<CShader> &shader, const std::string &id ) const;
 
 private:
 	void FromVertexDummy( const std::shared_ptr<CShader> &shader ) const;
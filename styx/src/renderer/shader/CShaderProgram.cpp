@@ -8,16 +8,7 @@ CShaderProgram::~CShaderProgram()
 {
 	if( glIsProgram( GLID ) == GL_TRUE )
 	{
-		glDetachShader( GLID, VertexShader->GLID );
-
-		if( nullptr != GeometryShader )
-		{
-			glDetachShader( GLID, GeometryShader->GLID );
-		}
-
-		glDetachShader( GLID, FragmentShader->GLID );
-
-		glDeleteProgram( GLID );
+		CGLState::DeleteProgram( GLID );
 	}
 }
 
@@ -30,7 +21,7 @@ void CShaderProgram::Reset()
 {
 	if( glIsProgram( GLID ) == GL_TRUE )
 	{
-		glDeleteProgram( GLID );
+		CGLState::DeleteProgram( GLID );
 	}
 
 	VertexShader = nullptr;
@@ -40,6 +31,22 @@ void CShaderProgram::Reset()
 	m_requiredSamplers.clear();
 	m_requiredEngineUniforms.clear();
 	m_requiredMaterialUniforms.clear();
+
+	m_materialBlockSize = 0;
+
+	m_ready = true;
+}
+
+SMemoryUsage CShaderProgram::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage;
+
+	memoryUsage.cpu =	sizeof( CShaderProgram )
+						+ m_requiredSamplers.capacity() * sizeof( decltype( m_requiredSamplers )::value_type )
+						+ m_requiredEngineUniforms.capacity() * sizeof( decltype( m_requiredEngineUniforms )::value_type )
+						+ m_requiredMaterialUniforms.capacity() * sizeof( decltype( m_requiredMaterialUniforms )::value_type );
+
+	return( memoryUsage );
 }
 
 const std::vector<std::pair<GLint, const SShaderInterface>> &CShaderProgram::RequiredSamplers() const
@@ -57,6 +64,26 @@ const std::vector<std::pair<GLint, const SShaderInterface>> &CShaderProgram::Req
 	return( m_requiredMaterialUniforms );
 }
 
+GLint CShaderProgram::MaterialBlockSize() const
+{
+	return( m_materialBlockSize );
+}
+
+void CShaderProgram::MaterialBlockSize( const GLint size )
+{
+	m_materialBlockSize = size;
+}
+
+bool CShaderProgram::Ready() const
+{
+	return( m_ready );
+}
+
+void CShaderProgram::Ready( const bool ready )
+{
+	m_ready = ready;
+}
+
 void CShaderProgram::AddRequiredSampler( const GLint location, const SShaderInterface &shaderInterface )
 {
 	m_requiredSamplers.emplace_back( std::make_pair( location, shaderInterface ) );
@@ -67,7 +94,7 @@ void CShaderProgram::AddRequiredEngineUniform( const GLint location, const EEngi
 	m_requiredEngineUniforms.emplace_back( std::make_pair( location, engineUniform ) );
 }
 
-void CShaderProgram::AddRequiredMaterialUniform( const GLint location, const SShaderInterface &shaderInterface )
+void CShaderProgram::AddRequiredMaterialUniform( const GLint offset, const SShaderInterface &shaderInterface )
 {
-	m_requiredMaterialUniforms.emplace_back( std::make_pair( location, shaderInterface ) );
+	m_requiredMaterialUniforms.emplace_back( std::make_pair( offset, shaderInterface ) );
 }
@@ -4,6 +4,8 @@
 #include <vector>
 #include <memory>
 
+#include "src/core/SMemoryUsage.hpp"
+
 #include "src/renderer/GL.h"
 
 #include "src/renderer/shader/EEngineUniform.hpp"
@@ -20,6 +22,9 @@ public:
 
 	void Reset();
 
+	// the shaders are resources of their own and the driver doesn't tell how much the linked program takes
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
 	GLuint GLID = 0;
 
 	std::shared_ptr<const CShader>	VertexShader;
@@ -28,14 +33,26 @@ public:
 
 	const std::vector<std::pair<GLint, const SShaderInterface>>	&RequiredSamplers() const;
 	const std::vector<std::pair<GLint, const EEngineUniform>>	&RequiredEngineUniforms() const;
+	// the GLint is the offset of the uniform inside of the material block
 	const std::vector<std::pair<GLint, const SShaderInterface>>	&RequiredMaterialUniforms() const;
 
+	GLint MaterialBlockSize() const;
+	void MaterialBlockSize( const GLint size );
+
+	// false while the program is still being linked in the background, it must not be used until then
+	bool Ready() const;
+	void Ready( const bool ready );
+
 	void AddRequiredSampler( const GLint location, const SShaderInterface &shaderInterface );
 	void AddRequiredEngineUniform( const GLint location, const EEngineUniform engineUniform );
-	void AddRequiredMaterialUniform( const GLint location, const SShaderInterface &shaderInterface );
+	void AddRequiredMaterialUniform( const GLint offset, const SShaderInterface &shaderInterface );
 
 private:
 	std::vector<std::pair<GLint, const SShaderInterface>>	m_requiredSamplers;
 	std::vector<std::pair<GLint, const EEngineUniform>>		m_requiredEngineUniforms;
 	std::vector<std::pair<GLint, const SShaderInterface>>	m_requiredMaterialUniforms;
+
+	GLint m_materialBlockSize { 0 };
+
+	bool m_ready { true };
 };
@@ -0,0 +1,185 @@
+#include "CShaderProgramBinaryCache.hpp"
+
+#include <cstring>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/system/CTimer.hpp"
+
+#include "src/helper/Hash.hpp"
+
+const fs::path CShaderProgramBinaryCache::Directory { "shadercache" };
+
+const u32 CShaderProgramBinaryCache::Magic { 0x43425053 }; // "SPBC"
+const u32 CShaderProgramBinaryCache::Version { 1 };
+
+CShaderProgramBinaryCache::CShaderProgramBinaryCache( const CFileSystem &filesystem ) :
+	m_filesystem { filesystem }
+{
+	GLint numBinaryFormats { 0 };
+	glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats );
+
+	if( 0 == numBinaryFormats )
+	{
+		logWARNING( "the driver doesn't support any program binary formats, shader program binary cache is disabled" );
+	}
+	else if( !m_filesystem.Exists( Directory ) && !m_filesystem.MakeDir( Directory ) )
+	{
+		logWARNING( "couldn't create '{0}' because of: {1}, shader program binary cache is disabled", Directory.generic_string(), m_filesystem.GetLastError() );
+	}
+	else
+	{
+		m_enabled = true;
+
+		// binaries are only valid for exactly the driver which produced them
+		m_driverHash = Hash::FNV1aOffsetBasis;
+
+		for( const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION } )
+		{
+			m_driverHash = Hash::FNV1a( reinterpret_cast<const char*>( glGetString( name ) ), m_driverHash );
+		}
+
+		logINFO( "shader program binary cache was initialized" );
+	}
+}
+
+CShaderProgramBinaryCache::~CShaderProgramBinaryCache()
+{
+	LogStatistics();
+}
+
+void CShaderProgramBinaryCache::LogStatistics() const
+{
+	if( m_enabled )
+	{
+		logINFO( "shader program binary cache: {0} hits, {1} misses, {2:.1f}ms of linking saved", m_hits, m_misses, m_savedTime / 1000.0f );
+	}
+}
+
+u64 CShaderProgramBinaryCache::SourceHash( const CShaderProgram &shaderProgram )
+{
+	u64 hash = Hash::FNV1a( shaderProgram.VertexShader->Source );
+
+	if( nullptr != shaderProgram.GeometryShader )
+	{
+		hash = Hash::FNV1a( shaderProgram.GeometryShader->Source, hash );
+	}
+
+	return( Hash::FNV1a( shaderProgram.FragmentShader->Source, hash ) );
+}
+
+bool CShaderProgramBinaryCache::Load( const CShaderProgram &shaderProgram, const u64 sourceHash ) const
+{
+	if( !m_enabled )
+	{
+		return( false );
+	}
+
+	const fs::path path = Path( sourceHash );
+
+	if( !m_filesystem.Exists( path ) )
+	{
+		m_misses++;
+		return( false );
+	}
+
+	const CTimer loadTimer;
+
+	const CFileSystem::FileBuffer buffer = m_filesystem.LoadFileToBuffer( path );
+
+	SHeader header;
+
+	if( buffer.size() <= sizeof( header ) )
+	{
+		logWARNING( "program binary '{0}' is truncated", path.generic_string() );
+		m_misses++;
+		return( false );
+	}
+
+	std::memcpy( &header, buffer.data(), sizeof( header ) );
+
+	if( ( Magic != header.magic )
+		||
+		( Version != header.version )
+		||
+		( sourceHash != header.sourceHash )
+		||
+		( m_driverHash != header.driverHash ) )
+	{
+		logDEBUG( "program binary '{0}' is outdated", path.generic_string() );
+		m_misses++;
+		return( false );
+	}
+
+	glProgramBinary( shaderProgram.GLID, static_cast<GLenum>( header.format ), buffer.data() + sizeof( header ), static_cast<GLsizei>( buffer.size() - sizeof( header ) ) );
+
+	GLint linkStatus;
+	glGetProgramiv( shaderProgram.GLID, GL_LINK_STATUS, &linkStatus );
+
+	if( linkStatus != static_cast<GLint>( GL_TRUE ) )
+	{
+		// happens when the driver was updated without changing its version string
+		logDEBUG( "program binary '{0}' was rejected by the driver", path.generic_string() );
+		m_misses++;
+		return( false );
+	}
+
+	const u64 loadTime = loadTimer.Time();
+
+	m_hits++;
+
+	if( header.linkTime > loadTime )
+	{
+		m_savedTime += header.linkTime - loadTime;
+	}
+
+	logDEBUG( "program binary '{0}' loaded in {1:.2f}ms instead of linking in {2:.2f}ms", path.generic_string(), loadTime / 1000.0f, header.linkTime / 1000.0f );
+
+	return( true );
+}
+
+void CShaderProgramBinaryCache::PrepareForStore( const CShaderProgram &shaderProgram ) const
+{
+	if( m_enabled )
+	{
+		glProgramParameteri( shaderProgram.GLID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, static_cast<GLint>( GL_TRUE ) );
+	}
+}
+
+void CShaderProgramBinaryCache::Store( const CShaderProgram &shaderProgram, const u64 sourceHash, const u64 linkTime ) const
+{
+	if( !m_enabled )
+	{
+		return;
+	}
+
+	GLint binaryLength { 0 };
+	glGetProgramiv( shaderProgram.GLID, GL_PROGRAM_BINARY_LENGTH, &binaryLength );
+
+	if( 0 >= binaryLength )
+	{
+		logDEBUG( "the driver didn't provide a binary for the program" );
+		return;
+	}
+
+	SHeader header { Magic, Version, m_driverHash, sourceHash, 0, 0, linkTime };
+
+	CFileSystem::FileBuffer buffer( sizeof( header ) + binaryLength );
+
+	GLenum format;
+	glGetProgramBinary( shaderProgram.GLID, binaryLength, nullptr, &format, buffer.data() + sizeof( header ) );
+
+	header.format = static_cast<u32>( format );
+
+	std::memcpy( buffer.data(), &header, sizeof( header ) );
+
+	if( !m_filesystem.SaveBufferToFile( buffer, Path( sourceHash ) ) )
+	{
+		logWARNING( "couldn't store program binary '{0}'", Path( sourceHash ).generic_string() );
+	}
+}
+
+fs::path CShaderProgramBinaryCache::Path( const u64 sourceHash ) const
+{
+	return( Directory / fmt::format( "{0:016x}.bin", sourceHash ) );
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "src/core/Types.hpp"
+
+#include "src/system/CFileSystem.hpp"
+
+#include "src/renderer/shader/CShaderProgram.hpp"
+
+/**
+ * Persists linked program binaries in the write directory.
+ * Entries are keyed by the preprocessed sources of all stages and tagged with the driver they were created by,
+ * so they get replaced automatically whenever a source or the driver changes.
+ */
+class CShaderProgramBinaryCache final
+{
+public:
+	explicit CShaderProgramBinaryCache( const CFileSystem &filesystem );
+	~CShaderProgramBinaryCache();
+
+	static u64 SourceHash( const CShaderProgram &shaderProgram );
+
+	/** loads the binary into the already created program object, the caller still has to check the link status */
+	[[nodiscard]] bool Load( const CShaderProgram &shaderProgram, const u64 sourceHash ) const;
+
+	/** has to be called before linking, else the driver may not keep the binary around */
+	void PrepareForStore( const CShaderProgram &shaderProgram ) const;
+
+	void Store( const CShaderProgram &shaderProgram, const u64 sourceHash, const u64 linkTime ) const;
+
+	void LogStatistics() const;
+
+private:
+	CShaderProgramBinaryCache( const CShaderProgramBinaryCache &rhs ) = delete;
+	CShaderProgramBinaryCache& operator = ( const CShaderProgramBinaryCache &rhs ) = delete;
+
+	static const fs::path Directory;
+
+	struct SHeader final
+	{
+		u32 magic;
+		u32 version;
+		u64 driverHash;
+		u64 sourceHash;
+		u32 format;
+		u32 padding;
+		u64 linkTime;
+	};
+
+	static const u32 Magic;
+	static const u32 Version;
+
+	fs::path Path( const u64 sourceHash ) const;
+
+	const CFileSystem &m_filesystem;
+
+	bool m_enabled { false };
+
+	u64 m_driverHash { 0 };
+
+	mutable u32 m_hits { 0 };
+	mutable u32 m_misses { 0 };
+	// sum of the link times of all programs which were loaded from the cache instead, in microseconds
+	mutable u64 m_savedTime { 0 };
+};
\ No newline at end of file
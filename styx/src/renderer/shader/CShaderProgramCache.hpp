@@ -19,6 +19,16 @@ private:
 		m_shaderProgramLoader.FromFile( resource, id );
 	}
 
+	TFinisher Decode( const std::string &id ) const override
+	{
+		return( [ this, id, shp_root = m_shaderProgramLoader.Decode( id ) ]( const std::shared_ptr<CShaderProgram> &resource ) { m_shaderProgramLoader.FromDecoded( resource, id, shp_root ); } );
+	}
+
+	void LoadPlaceholder( const std::shared_ptr<CShaderProgram> &resource, [[maybe_unused]] const std::string &id ) const override
+	{
+		m_shaderProgramLoader.FromDummy( resource );
+	}
+
 private:
 	CShaderProgramLoader	m_shaderProgramLoader;
 };
\ No newline at end of file
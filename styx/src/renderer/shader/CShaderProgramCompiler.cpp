@@ -1,16 +1,23 @@
 #include "CShaderProgramCompiler.hpp"
 
+#include <algorithm>
+
 #include <glbinding-aux/Meta.h>
 
 #include "src/logger/CLogger.hpp"
 
 #include "src/renderer/shader/CShaderCompiler.hpp"
 
+#include "src/renderer/EUniformBufferLocations.hpp"
+
 #include "src/core/StyxException.hpp"
 
 constexpr const GLint CShaderProgramCompiler::RequiredCombinedTextureImageUnits;
 
-CShaderProgramCompiler::CShaderProgramCompiler( const CShaderCompiler &shaderCompiler )
+CShaderProgramCompiler::CShaderProgramCompiler( const CFileSystem &filesystem, const COpenGlAdapter &openGlAdapter, const CShaderCompiler &shaderCompiler ) :
+	m_shaderCompiler { shaderCompiler },
+	m_parallelCompile { openGlAdapter.ParallelShaderCompile() },
+	m_binaryCache( filesystem )
 {
 	m_dummyShaderProgram->VertexShader = shaderCompiler.DummyVertexShader();
 	m_dummyShaderProgram->FragmentShader = shaderCompiler.DummyFragmentShader();
@@ -21,7 +28,153 @@ CShaderProgramCompiler::CShaderProgramCompiler( const CShaderCompiler &shaderCom
 	}
 }
 
+CShaderProgramCompiler::~CShaderProgramCompiler()
+{
+	if( !m_pendingShaderPrograms.empty() )
+	{
+		logDEBUG( "{0} shader programs were still being linked", m_pendingShaderPrograms.size() );
+	}
+}
+
 bool CShaderProgramCompiler::Compile( const std::shared_ptr<CShaderProgram> &shaderProgram ) const
+{
+	if( !Create( shaderProgram ) )
+	{
+		return( false );
+	}
+
+	const u64 sourceHash = CShaderProgramBinaryCache::SourceHash( *shaderProgram );
+
+	if( !m_binaryCache.Load( *shaderProgram, sourceHash ) )
+	{
+		const u64 linkStartTime = m_timer.Time();
+
+		Link( shaderProgram );
+
+		if( !CheckLinkStatus( shaderProgram ) )
+		{
+			shaderProgram->Reset();
+
+			return( false );
+		}
+
+		m_binaryCache.Store( *shaderProgram, sourceHash, m_timer.Time() - linkStartTime );
+	}
+
+	if( !SetupInterface( shaderProgram ) )
+	{
+		logWARNING( "unable to setup the interface" );
+
+		shaderProgram->Reset();
+		
+		return( false );
+	}
+
+	shaderProgram->Ready( true );
+
+	return( true );
+}
+
+bool CShaderProgramCompiler::CompileAsync( const std::shared_ptr<CShaderProgram> &shaderProgram ) const
+{
+	if( !m_parallelCompile )
+	{
+		return( Compile( shaderProgram ) );
+	}
+
+	if( !Create( shaderProgram ) )
+	{
+		return( false );
+	}
+
+	const u64 sourceHash = CShaderProgramBinaryCache::SourceHash( *shaderProgram );
+
+	if( m_binaryCache.Load( *shaderProgram, sourceHash ) )
+	{
+		if( !SetupInterface( shaderProgram ) )
+		{
+			logWARNING( "unable to setup the interface" );
+
+			shaderProgram->Reset();
+
+			return( false );
+		}
+
+		shaderProgram->Ready( true );
+
+		return( true );
+	}
+
+	Link( shaderProgram );
+
+	shaderProgram->Ready( false );
+
+	m_pendingShaderPrograms.push_back( { shaderProgram, sourceHash, m_timer.Time(), {} } );
+
+	return( true );
+}
+
+void CShaderProgramCompiler::OnReady( const std::shared_ptr<const CShaderProgram> &shaderProgram, const std::function<void()> &callback ) const
+{
+	const auto pendingShaderProgram = std::find_if( std::begin( m_pendingShaderPrograms ), std::end( m_pendingShaderPrograms ), [ &shaderProgram ]( const SPendingShaderProgram &pending ) { return( pending.shaderProgram == shaderProgram ); } );
+
+	if( std::end( m_pendingShaderPrograms ) == pendingShaderProgram )
+	{
+		callback();
+	}
+	else
+	{
+		pendingShaderProgram->callbacks.push_back( callback );
+	}
+}
+
+void CShaderProgramCompiler::Update() const
+{
+	if( m_pendingShaderPrograms.empty() )
+	{
+		return;
+	}
+
+	// move the finished ones out first, since their callbacks are allowed to submit new programs
+	std::vector<SPendingShaderProgram> finishedShaderPrograms;
+
+	for( auto it = std::begin( m_pendingShaderPrograms ); it != std::end( m_pendingShaderPrograms ); )
+	{
+		GLint completionStatus;
+		glGetProgramiv( it->shaderProgram->GLID, GL_COMPLETION_STATUS_KHR, &completionStatus );
+
+		if( completionStatus == static_cast<GLint>( GL_TRUE ) )
+		{
+			finishedShaderPrograms.push_back( std::move( *it ) );
+			it = m_pendingShaderPrograms.erase( it );
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	for( const auto &finishedShaderProgram : finishedShaderPrograms )
+	{
+		Complete( finishedShaderProgram );
+	}
+}
+
+void CShaderProgramCompiler::Finish() const
+{
+	while( !m_pendingShaderPrograms.empty() )
+	{
+		const auto pendingShaderPrograms = std::move( m_pendingShaderPrograms );
+		m_pendingShaderPrograms.clear();
+
+		for( const auto &pendingShaderProgram : pendingShaderPrograms )
+		{
+			Complete( pendingShaderProgram );
+		}
+	}
+}
+
+bool CShaderProgramCompiler::Create( const std::shared_ptr<CShaderProgram> &shaderProgram ) const
 {
 	if( nullptr == shaderProgram->VertexShader )
 	{
@@ -42,6 +195,13 @@ bool CShaderProgramCompiler::Compile( const std::shared_ptr<CShaderProgram> &sha
 		return( false );
 	}
 
+	return( true );
+}
+
+void CShaderProgramCompiler::Link( const std::shared_ptr<CShaderProgram> &shaderProgram ) const
+{
+	m_binaryCache.PrepareForStore( *shaderProgram );
+
 	glAttachShader( shaderProgram->GLID, shaderProgram->VertexShader->GLID );
 
 	if( nullptr != shaderProgram->GeometryShader )
@@ -53,6 +213,19 @@ bool CShaderProgramCompiler::Compile( const std::shared_ptr<CShaderProgram> &sha
 
 	glLinkProgram( shaderProgram->GLID );
 
+	// the linked program doesn't need the shader objects anymore and loading from a binary never attaches them
+	glDetachShader( shaderProgram->GLID, shaderProgram->VertexShader->GLID );
+
+	if( nullptr != shaderProgram->GeometryShader )
+	{
+		glDetachShader( shaderProgram->GLID, shaderProgram->GeometryShader->GLID );
+	}
+
+	glDetachShader( shaderProgram->GLID, shaderProgram->FragmentShader->GLID );
+}
+
+bool CShaderProgramCompiler::CheckLinkStatus( const std::shared_ptr<CShaderProgram> &shaderProgram ) const
+{
 	GLint compileResult;
 	glGetProgramiv( shaderProgram->GLID, GL_LINK_STATUS, &compileResult );
 
@@ -72,21 +245,62 @@ bool CShaderProgramCompiler::Compile( const std::shared_ptr<CShaderProgram> &sha
 			logWARNING( "Error linking program: unknown reason" );
 		}
 
-		shaderProgram->Reset();
+		// with parallel compilation the shaders were never checked, so report their errors here
+		if( m_parallelCompile )
+		{
+			m_shaderCompiler.CheckCompileStatus( *shaderProgram->VertexShader );
+
+			if( nullptr != shaderProgram->GeometryShader )
+			{
+				m_shaderCompiler.CheckCompileStatus( *shaderProgram->GeometryShader );
+			}
+
+			m_shaderCompiler.CheckCompileStatus( *shaderProgram->FragmentShader );
+		}
 
 		return( false );
 	}
 
-	if( !SetupInterface( shaderProgram ) )
+	return( true );
+}
+
+void CShaderProgramCompiler::Complete( const SPendingShaderProgram &pendingShaderProgram ) const
+{
+	const auto &shaderProgram = pendingShaderProgram.shaderProgram;
+
+	bool valid = CheckLinkStatus( shaderProgram );
+
+	if( valid )
 	{
-		logWARNING( "unable to setup the interface" );
+		// this includes the time until the completion was noticed, so it is an upper bound
+		m_binaryCache.Store( *shaderProgram, pendingShaderProgram.sourceHash, m_timer.Time() - pendingShaderProgram.submitTime );
+
+		valid = SetupInterface( shaderProgram );
+	}
+
+	if( valid )
+	{
+		shaderProgram->Ready( true );
+	}
+	else
+	{
+		logWARNING( "shader program is replaced with the dummy shader program" );
 
 		shaderProgram->Reset();
-		
-		return( false );
+
+		shaderProgram->VertexShader = m_dummyShaderProgram->VertexShader;
+		shaderProgram->FragmentShader = m_dummyShaderProgram->FragmentShader;
+
+		if( !Compile( shaderProgram ) )
+		{
+			logERROR( "couldn't even create the dummy shader program" );
+		}
 	}
 
-	return( true );
+	for( const auto &callback : pendingShaderProgram.callbacks )
+	{
+		callback();
+	}
 }
 
 bool CShaderProgramCompiler::SetupInterface( const std::shared_ptr<CShaderProgram> &shaderProgram ) const
@@ -130,23 +344,34 @@ bool CShaderProgramCompiler::SetupInterface( const std::shared_ptr<CShaderProgra
 	}
 
 	/*
-	 * active non-block uniforms
+	 * material block
+	 */
+	const GLuint materialBlockIndex = glGetProgramResourceIndex( shaderProgram->GLID, GL_UNIFORM_BLOCK, CShaderCompiler::MaterialBlockName.c_str() );
+
+	if( GL_INVALID_INDEX != materialBlockIndex )
+	{
+		static const GLenum blockProperty { GL_BUFFER_DATA_SIZE };
+
+		GLint blockSize = 0;
+		glGetProgramResourceiv( shaderProgram->GLID, GL_UNIFORM_BLOCK, materialBlockIndex, 1, &blockProperty, 1, nullptr, &blockSize );
+
+		shaderProgram->MaterialBlockSize( blockSize );
+
+		glUniformBlockBinding( shaderProgram->GLID, materialBlockIndex, static_cast<GLuint>( EUniformBufferLocation::MATERIAL ) );
+	}
+
+	/*
+	 * active uniforms
 	 */
 	GLint numActiveUniforms = 0;
 	glGetProgramInterfaceiv( shaderProgram->GLID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numActiveUniforms );
-	static const std::array<GLenum, 4> uniformProperties{ { GL_BLOCK_INDEX, GL_TYPE, GL_NAME_LENGTH, GL_LOCATION } };
+	static const std::array<GLenum, 5> uniformProperties{ { GL_BLOCK_INDEX, GL_TYPE, GL_NAME_LENGTH, GL_LOCATION, GL_OFFSET } };
 
 	for( GLint uniformIndex = 0; uniformIndex < numActiveUniforms; ++uniformIndex )
 	{
 		GLint values[ uniformProperties.size() ];
 		glGetProgramResourceiv( shaderProgram->GLID, GL_UNIFORM, uniformIndex, uniformProperties.size(), uniformProperties.data(), uniformProperties.size(), nullptr, &values[ 0 ] );
 
-		// skip any uniforms that are in a block.
-		if( values[ 0 ] != -1 )
-		{
-			continue;
-		}
-
 		std::vector<char> nameData( values[ 2 ] );
 		glGetProgramResourceName( shaderProgram->GLID, GL_UNIFORM, uniformIndex, nameData.size(), NULL, &nameData[ 0 ] );
 		const std::string uniformName( nameData.data() );
@@ -154,6 +379,30 @@ bool CShaderProgramCompiler::SetupInterface( const std::shared_ptr<CShaderProgra
 		const GLint  uniformLocation = values[ 3 ];
 		const GLenum uniformType = static_cast<GLenum>( values[ 1 ] );
 
+		if( values[ 0 ] != -1 )
+		{
+			// the members of the material block get provided by the material, all other blocks are filled by the engine
+			if( static_cast<GLuint>( values[ 0 ] ) == materialBlockIndex )
+			{
+				switch( uniformType )
+				{
+					case GL_FLOAT_VEC2:
+					case GL_FLOAT_VEC3:
+					case GL_FLOAT_VEC4:
+					case GL_UNSIGNED_INT:
+					case GL_FLOAT:
+						shaderProgram->AddRequiredMaterialUniform( values[ 4 ], SShaderInterface{ uniformName, uniformType } );
+						break;
+
+					default:
+						logERROR( "unsupported type {0} for uniform '{1}' in '{2}'", glbinding::aux::Meta::getString( uniformType ), uniformName, CShaderCompiler::MaterialBlockName );
+						return( false );
+				}
+			}
+
+			continue;
+		}
+
 		switch( uniformType )
 		{
 		case GL_SAMPLER_2D:
@@ -200,9 +449,8 @@ bool CShaderProgramCompiler::SetupInterface( const std::shared_ptr<CShaderProgra
 			}
 			else
 			{
-				// uniform gets provided by the material
-
-				shaderProgram->AddRequiredMaterialUniform( uniformLocation, SShaderInterface{ uniformName, uniformType } );
+				logERROR( "uniform '{0}' has to be declared inside of '{1}'", uniformName, CShaderCompiler::MaterialBlockName );
+				return( false );
 			}
 			break;
 		}
@@ -219,4 +467,9 @@ bool CShaderProgramCompiler::SetupInterface( const std::shared_ptr<CShaderProgra
 const std::shared_ptr<const CShaderProgram> CShaderProgramCompiler::DummyShaderProgram() const
 {
 	return( m_dummyShaderProgram );
+}
+
+const CShaderProgramBinaryCache &CShaderProgramCompiler::BinaryCache() const
+{
+	return( m_binaryCache );
 }
\ No newline at end of file
@@ -1,23 +1,72 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+#include <functional>
+
+#include "src/system/CTimer.hpp"
+
+#include "src/renderer/COpenGlAdapter.hpp"
 
 #include "src/renderer/shader/CShaderCompiler.hpp"
 #include "src/renderer/shader/CShaderProgram.hpp"
+#include "src/renderer/shader/CShaderProgramBinaryCache.hpp"
 
 class CShaderProgramCompiler final
 {
 public:
-	explicit CShaderProgramCompiler( const CShaderCompiler &shaderCompiler );
+	CShaderProgramCompiler( const CFileSystem &filesystem, const COpenGlAdapter &openGlAdapter, const CShaderCompiler &shaderCompiler );
+	~CShaderProgramCompiler();
 
+	// only returns after the program is linked and ready to use
 	bool Compile( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
 
+	/**
+	 * Submits the program to be linked in the background if the driver supports it.
+	 * The program is not Ready() until Update() or Finish() completed it, if it fails it gets replaced with the dummy shader program.
+	 */
+	bool CompileAsync( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
+
+	// calls back as soon as the program is ready, which is right away if it isn't pending
+	void OnReady( const std::shared_ptr<const CShaderProgram> &shaderProgram, const std::function<void()> &callback ) const;
+
+	// completes all programs which finished linking, without blocking
+	void Update() const;
+
+	// blocks until all pending programs are completed
+	void Finish() const;
+
 	constexpr static const GLint RequiredCombinedTextureImageUnits { 16 };
 
 	const std::shared_ptr<const CShaderProgram> DummyShaderProgram() const;
 
+	const CShaderProgramBinaryCache &BinaryCache() const;
+
 private:
+	struct SPendingShaderProgram final
+	{
+		std::shared_ptr<CShaderProgram>		shaderProgram;
+		u64									sourceHash;
+		u64									submitTime;
+		std::vector<std::function<void()>>	callbacks;
+	};
+
+	[[ nodiscard ]] bool Create( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
+	void Link( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
+	[[ nodiscard ]] bool CheckLinkStatus( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
 	[[ nodiscard ]] bool SetupInterface( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
 
+	void Complete( const SPendingShaderProgram &pendingShaderProgram ) const;
+
+	const CShaderCompiler &m_shaderCompiler;
+
+	const bool m_parallelCompile;
+
+	const CShaderProgramBinaryCache m_binaryCache;
+
+	const CTimer m_timer;
+
+	mutable std::vector<SPendingShaderProgram> m_pendingShaderPrograms;
+
 	const std::shared_ptr<CShaderProgram> m_dummyShaderProgram = std::make_shared<CShaderProgram>();
 };
\ No newline at end of file
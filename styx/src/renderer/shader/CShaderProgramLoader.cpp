@@ -7,6 +7,8 @@ using json = nlohmann::json;
 
 #include "src/core/FileExtension.hpp"
 
+#include "src/helper/Json.hpp"
+
 CShaderProgramLoader::CShaderProgramLoader( const CFileSystem &p_filesystem, CResources &resources, CShaderCompiler &shaderCompiler, CShaderProgramCompiler &shaderProgramCompiler ) :
 	m_filesystem { p_filesystem },
 	m_resources { resources },
@@ -21,8 +23,35 @@ CShaderProgramLoader::~CShaderProgramLoader()
 	logINFO( "shader program loader is shutting down" );
 }
 
-void CShaderProgramLoader::FromFile( const std::shared_ptr<CShaderProgram> &shaderProgram, const fs::path &path ) const
+void CShaderProgramLoader::FromFile( const std::shared_ptr<CShaderProgram> &shaderProgram, const std::string &id ) const
+{
+	FromDecoded( shaderProgram, id, Decode( id ) );
+}
+
+std::optional<json> CShaderProgramLoader::Decode( const std::string &id ) const
 {
+	const fs::path path = ShaderVariant::Path( id );
+
+	if( !path.has_filename() || ( path.extension().generic_string() != FileExtension::ShaderProgram::shp ) || !m_filesystem.Exists( path ) )
+	{
+		return( std::nullopt );
+	}
+
+	try
+	{
+		return( Json::Load( m_filesystem, path ) );
+	}
+	catch( json::parse_error &e )
+	{
+		logWARNING( "failed to parse '{0}' because of {1}", path.generic_string(), e.what() );
+		return( std::nullopt );
+	}
+}
+
+void CShaderProgramLoader::FromDecoded( const std::shared_ptr<CShaderProgram> &shaderProgram, const std::string &id, const std::optional<json> &shp_root ) const
+{
+	const fs::path path = ShaderVariant::Path( id );
+
 	if( !path.has_filename() )
 	{
 		logWARNING( "path '{0}' does not containt a filename", path.generic_string() );
@@ -42,42 +71,64 @@ void CShaderProgramLoader::FromFile( const std::shared_ptr<CShaderProgram> &shad
 		logWARNING( "shader program file '{0}' does not exist", path.generic_string() );
 		FromDummy( shaderProgram );
 	}
+	else if( !shp_root )
+	{
+		FromDummy( shaderProgram );
+	}
 	else
 	{
-		const std::string body = m_filesystem.LoadFileToString( path );
-
-		if( fileExtensionString == std::string( ".shp" ) )
+		try
 		{
-			try
+			if( !FromShpRoot( shaderProgram, *shp_root, path, ShaderVariant::Keywords( id ) ) )
 			{
-				if( !FromShpFile( shaderProgram, path ) )
-				{
-					FromDummy( shaderProgram );
-				}
-			}
-			catch( std::exception &e )
-			{
-				logWARNING( "error loading shader program '{0}': {1}", path.generic_string(), e.what() );
 				FromDummy( shaderProgram );
 			}
 		}
+		catch( std::exception &e )
+		{
+			logWARNING( "error loading shader program '{0}': {1}", path.generic_string(), e.what() );
+			FromDummy( shaderProgram );
+		}
 	}
 }
 
-bool CShaderProgramLoader::FromShpFile( const std::shared_ptr<CShaderProgram> &shaderProgram, const fs::path &path ) const
+bool CShaderProgramLoader::FromShpRoot( const std::shared_ptr<CShaderProgram> &shaderProgram, const json &shp_root, const fs::path &path, const ShaderVariant::TKeywords &requestedKeywords ) const
 {
-	json shp_root;
+	// only keywords which are declared by the program get passed on to the shaders
+	ShaderVariant::TKeywords declaredKeywords;
 
-	try
+	const auto shp_keywords = shp_root.find( "keywords" );
+	if( shp_keywords != shp_root.end() )
 	{
-		shp_root = json::parse( m_filesystem.LoadFileToString( path ) );
+		for( const auto &shp_keyword : *shp_keywords )
+		{
+			const auto keyword = shp_keyword.get<std::string>();
+
+			if( ShaderVariant::IsValidKeyword( keyword ) )
+			{
+				declaredKeywords.insert( keyword );
+			}
+			else
+			{
+				logWARNING( "invalid keyword '{0}' declared in '{1}'", keyword, path.generic_string() );
+			}
+		}
 	}
-	catch( json::parse_error &e )
+
+	ShaderVariant::TKeywords keywords;
+
+	for( const auto &keyword : requestedKeywords )
 	{
-		logWARNING( "failed to parse '{0}' because of {1}", path.generic_string(), e.what() );
-		return( false );
+		if( declaredKeywords.count( keyword ) > 0 )
+		{
+			keywords.insert( keyword );
+		}
+		else
+		{
+			logWARNING( "keyword '{0}' is not declared in '{1}'", keyword, path.generic_string() );
+		}
 	}
-	
+
 	const auto shader_vs = shp_root.find( "vs" );
 	if( shader_vs == shp_root.end() )
 	{
@@ -86,13 +137,13 @@ bool CShaderProgramLoader::FromShpFile( const std::shared_ptr<CShaderProgram> &s
 	}
 	else
 	{
-		shaderProgram->VertexShader = m_resources.Get<CShader>( shader_vs->get<std::string>() );
+		shaderProgram->VertexShader = m_resources.Get<CShader>( ShaderVariant::Id( shader_vs->get<std::string>(), keywords ) );
 	}
 
 	const auto shader_gs = shp_root.find( "gs" );
 	if( shader_gs != shp_root.end() )
 	{
-		shaderProgram->GeometryShader = m_resources.Get<CShader>( shader_gs->get<std::string>() );
+		shaderProgram->GeometryShader = m_resources.Get<CShader>( ShaderVariant::Id( shader_gs->get<std::string>(), keywords ) );
 	}
 
 	const auto shader_fs = shp_root.find( "fs" );
@@ -103,10 +154,11 @@ bool CShaderProgramLoader::FromShpFile( const std::shared_ptr<CShaderProgram> &s
 	}
 	else
 	{
-		shaderProgram->FragmentShader = m_resources.Get<CShader>( shader_fs->get<std::string>() );
+		shaderProgram->FragmentShader = m_resources.Get<CShader>( ShaderVariant::Id( shader_fs->get<std::string>(), keywords ) );
 	}
 
-	if( !m_shaderProgramCompiler.Compile( shaderProgram ) )
+	// is only checked for errors which show up right away, failing to link later on replaces it with the dummy
+	if( !m_shaderProgramCompiler.CompileAsync( shaderProgram ) )
 	{
 		logWARNING( "program object from '{0}' is not valid", path.generic_string() );
 		return( false );
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+
+#include "external/json/json.hpp"
 
 #include "src/system/CFileSystem.hpp"
 
@@ -10,6 +13,7 @@
 
 #include "src/renderer/shader/CShaderProgram.hpp"
 #include "src/renderer/shader/CShaderProgramCompiler.hpp"
+#include "src/renderer/shader/ShaderVariant.hpp"
 
 class CShaderProgramLoader final
 {
@@ -17,12 +21,20 @@ public:
 	CShaderProgramLoader( const CFileSystem &p_filesystem, CResources &resources, CShaderCompiler &shaderCompiler, CShaderProgramCompiler &shaderProgramCompiler );
 	~CShaderProgramLoader();
 	
-	void FromFile( const std::shared_ptr<CShaderProgram> &shaderProgram, const fs::path &path ) const;
+	// the id is the path of the .shp file, optionally followed by the keywords of the variant
+	void FromFile( const std::shared_ptr<CShaderProgram> &shaderProgram, const std::string &id ) const;
+
+	// the thread safe part of FromFile, parses the .shp file or returns nothing if that fails
+	[[nodiscard]] std::optional<nlohmann::json> Decode( const std::string &id ) const;
+
+	// gets the shaders and starts linking with what Decode parsed
+	void FromDecoded( const std::shared_ptr<CShaderProgram> &shaderProgram, const std::string &id, const std::optional<nlohmann::json> &shp_root ) const;
 
-private:
-	bool FromShpFile( const std::shared_ptr<CShaderProgram> &shaderProgram, const fs::path &path ) const;
 	void FromDummy( const std::shared_ptr<CShaderProgram> &shaderProgram ) const;
 
+private:
+	bool FromShpRoot( const std::shared_ptr<CShaderProgram> &shaderProgram, const nlohmann::json &shp_root, const fs::path &path, const ShaderVariant::TKeywords &requestedKeywords ) const;
+
 	const CFileSystem &m_filesystem;
 
 	CResources &m_resources;
@@ -0,0 +1,85 @@
+#include "ShaderVariant.hpp"
+
+#include <cctype>
+
+#include "src/resource/CResourceCacheBase.hpp"
+
+namespace ShaderVariant
+{
+	static const char KeywordSeparator = ',';
+
+	std::string Id( const fs::path &path, const TKeywords &keywords )
+	{
+		std::string id = path.generic_string();
+
+		if( !keywords.empty() )
+		{
+			id += CResourceCacheBase::VariantSeparator;
+
+			for( const auto &keyword : keywords )
+			{
+				if( keyword != *std::begin( keywords ) )
+				{
+					id += KeywordSeparator;
+				}
+
+				id += keyword;
+			}
+		}
+
+		return( id );
+	}
+
+	fs::path Path( const std::string &id )
+	{
+		return( id.substr( 0, id.find( CResourceCacheBase::VariantSeparator ) ) );
+	}
+
+	TKeywords Keywords( const std::string &id )
+	{
+		TKeywords keywords;
+
+		const auto separator = id.find( CResourceCacheBase::VariantSeparator );
+
+		if( std::string::npos != separator )
+		{
+			std::string::size_type start = separator + 1;
+
+			while( start <= id.size() )
+			{
+				auto end = id.find( KeywordSeparator, start );
+				if( std::string::npos == end )
+				{
+					end = id.size();
+				}
+
+				if( end > start )
+				{
+					keywords.insert( id.substr( start, end - start ) );
+				}
+
+				start = end + 1;
+			}
+		}
+
+		return( keywords );
+	}
+
+	bool IsValidKeyword( const std::string &keyword )
+	{
+		if( keyword.empty() || std::isdigit( static_cast<unsigned char>( keyword.front() ) ) )
+		{
+			return( false );
+		}
+
+		for( const auto c : keyword )
+		{
+			if( !std::isalnum( static_cast<unsigned char>( c ) ) && ( c != '_' ) )
+			{
+				return( false );
+			}
+		}
+
+		return( true );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <set>
+#include <string>
+
+#include "src/system/CFileSystem.hpp"
+
+/**
+ * A shader variant is identified by the path of its file plus the keywords it gets compiled with.
+ * The keywords are appended to the path like "shaders/fs/standard.frag#ANIMATED,FOG",
+ * so every variant is an own resource in the caches.
+ */
+namespace ShaderVariant
+{
+	// sorted and unique, so every combination of keywords maps to exactly one id
+	using TKeywords = std::set<std::string>;
+
+	std::string Id( const fs::path &path, const TKeywords &keywords );
+
+	fs::path Path( const std::string &id );
+	TKeywords Keywords( const std::string &id );
+
+	// keywords end up as #define in the source, so they have to be valid GLSL identifiers
+	bool IsValidKeyword( const std::string &keyword );
+}
\ No newline at end of file
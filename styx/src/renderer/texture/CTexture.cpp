@@ -1,12 +1,14 @@
 #include "CTexture.hpp"
 
+#include <algorithm>
+
 #include "src/renderer/CGLState.hpp"
 
 CTexture::~CTexture()
 {
 	if( glIsTexture( GLID ) )
 	{
-		glDeleteTextures( 1, &GLID );
+		CGLState::DeleteTexture( GLID );
 	}
 }
 
@@ -19,8 +21,70 @@ void CTexture::Reset()
 {
 	if( glIsTexture( GLID ) )
 	{
-		glDeleteTextures( 1, &GLID );
+		CGLState::DeleteTexture( GLID );
 	}
 
 	GLID = 0;
+
+	// a placeholder or dummy which replaces the texture has none of its levels
+	MipChain = {};
+	ResidentMip = 0;
+	Streamed = false;
+}
+
+void CTexture::AllocatedLevels( const CSize &size, const GLsizei depth, const GLenum internalFormat, const u32 levels, const u64 bytesPerTexel )
+{
+	MipChain.size			= size;
+	MipChain.depth			= depth;
+	MipChain.internalFormat	= internalFormat;
+
+	MipChain.levelBytes.clear();
+
+	for( u32 level = 0; level < levels; level++ )
+	{
+		const u64 width		= std::max( size.width >> level, 1u );
+		const u64 height	= std::max( size.height >> level, 1u );
+
+		MipChain.levelBytes.push_back( width * height * bytesPerTexel * static_cast<u64>( depth ) );
+	}
+}
+
+u64 CTexture::ResidentSize() const
+{
+	u64 residentSize { 0 };
+
+	for( size_t level = ResidentMip; level < MipChain.levelBytes.size(); level++ )
+	{
+		residentSize += MipChain.levelBytes[ level ];
+	}
+
+	return( residentSize );
+}
+
+SMemoryUsage CTexture::MemoryUsage() const
+{
+	return( SMemoryUsage { sizeof( CTexture ) + MipChain.levelBytes.size() * sizeof( u64 ), ResidentSize() } );
+}
+
+void CTexture::RequestMip( const u64 frame, const u8 mip ) const
+{
+	if( frame != m_requestFrame )
+	{
+		m_requestFrame = frame;
+		m_requestedMip = mip;
+	}
+	else
+	{
+		m_requestedMip = std::min( m_requestedMip, mip );
+	}
+}
+
+u8 CTexture::RequestedMip() const
+{
+	return( m_requestedMip );
+}
+
+u64 CTexture::RequestFrame() const
+{
+	return( m_requestFrame );
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <vector>
+
 #include "src/core/Types.hpp"
+#include "src/core/SMemoryUsage.hpp"
+
+#include "src/helper/CSize.hpp"
 
 #include "src/renderer/GL.h"
 
@@ -21,4 +26,37 @@ public:
 	void Reset();
 
 	GLuint GLID;
+
+	// the complete mip chain as it was allocated or streamed in, the top levels of a streamed one may have been dropped since
+	struct SMipChain final
+	{
+		CSize				size;				// of level 0
+		GLsizei				depth		{ 1 };	// faces of a cubemap or layers of an array
+		GLenum				internalFormat	{ GL_NONE };
+		std::vector<u64>	levelBytes;
+	} MipChain;
+
+	// only the levels of a streamed mip chain are dropped and restored by the streamer
+	bool Streamed { false };
+
+	// records uncompressed storage, estimated from the bytes per texel of the image because the driver may pad the texels
+	void AllocatedLevels( const CSize &size, const GLsizei depth, const GLenum internalFormat, const u32 levels, const u64 bytesPerTexel );
+
+	// first level of the mip chain which is resident in video memory, it is level 0 of the GL texture
+	u8 ResidentMip { 0 };
+
+	u64 ResidentSize() const;
+
+	// the resident levels in video memory
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
+	// called by the renderer for every draw, keeps the lowest level requested during a frame
+	void RequestMip( const u64 frame, const u8 mip ) const;
+
+	u8 RequestedMip() const;
+	u64 RequestFrame() const;
+
+private:
+	mutable u8	m_requestedMip	{ 0 };
+	mutable u64	m_requestFrame	{ 0 };
 };
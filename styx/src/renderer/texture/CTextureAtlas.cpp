@@ -0,0 +1,18 @@
+#include "CTextureAtlas.hpp"
+
+CTextureAtlas::CTextureAtlas( const std::string &name, const u32 pageSize ) :
+	Name { name },
+	PageSize { pageSize }
+{}
+
+const CTextureAtlas::SEntry * CTextureAtlas::EntryFromPath( const std::string &path ) const
+{
+	const auto it = Entries.find( path );
+
+	if( std::end( Entries ) != it )
+	{
+		return( &it->second );
+	}
+
+	return( nullptr );
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "src/core/Types.hpp"
+
+#include "src/helper/CSize.hpp"
+
+#include "src/renderer/texture/CTexture.hpp"
+
+/**	Small textures of the same format packed into the layers of one array texture.
+	Meshes using it share the texture and only differ in the layer and the rectangle they sample from.
+*/
+class CTextureAtlas final
+{
+public:
+	CTextureAtlas( const std::string &name, const u32 pageSize );
+
+	struct SEntry final
+	{
+		u16 Layer;
+
+		// xy scales and zw offsets the UVs of the whole texture into its rectangle on the layer
+		glm::vec4 UVTransform;
+
+		CSize Size;
+	};
+
+	const std::string Name;
+
+	// width and height of every layer
+	const u32 PageSize;
+
+	std::shared_ptr<CTexture> Texture = std::make_shared<CTexture>();
+
+	// returns nullptr if the texture couldn't be packed into the atlas
+	const SEntry * EntryFromPath( const std::string &path ) const;
+
+	std::unordered_map<std::string, SEntry> Entries;
+};
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "CTextureAtlasBuilder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "external/stb/stb_rect_pack.h"
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/helper/image/ImageHandler.hpp"
+
+#include "src/renderer/texture/CTextureLoader.hpp"
+
+const u32 CTextureAtlasBuilder::DefaultPageSize	{ 1024 };
+const u32 CTextureAtlasBuilder::Padding			{ 1 };
+
+const std::shared_ptr<const CTextureAtlas> CTextureAtlasBuilder::FromFiles( const std::string &name, const std::vector<fs::path> &paths, const u32 maxPageSize ) const
+{
+	/*
+	 * load the images, only those of the same format as the first one can share the texture
+	 */
+
+	std::vector<std::string> names;
+	std::vector<std::shared_ptr<const CImage>> images;
+
+	for( const auto &path : paths )
+	{
+		if( std::end( names ) != std::find( std::begin( names ), std::end( names ), path.generic_string() ) )
+		{
+			continue;
+		}
+
+		const std::shared_ptr<const CImage> image = ImageHandler::Load( m_filesystem, path, m_openGlAdapter.MaxTextureSize(), false );
+
+		if( !image )
+		{
+			logWARNING( "image '{0}' couldn't be loaded for atlas '{1}'", path.generic_string(), name );
+		}
+		else if( !images.empty() && ( image->BPP() != images.front()->BPP() ) )
+		{
+			logWARNING( "image '{0}' has {1}bpp instead of {2}bpp and is left out of atlas '{3}'", path.generic_string(), static_cast<u16>( image->BPP() ), static_cast<u16>( images.front()->BPP() ), name );
+		}
+		else if( ( image->Size().width + 2 * Padding > maxPageSize ) || ( image->Size().height + 2 * Padding > maxPageSize ) )
+		{
+			logWARNING( "image '{0}' doesn't fit into the {1}x{1} layers of atlas '{2}'", path.generic_string(), maxPageSize, name );
+		}
+		else
+		{
+			names.emplace_back( path.generic_string() );
+			images.emplace_back( image );
+		}
+	}
+
+	if( images.empty() )
+	{
+		logWARNING( "atlas '{0}' contains no images", name );
+		return( std::make_shared<CTextureAtlas>( name, maxPageSize ) );
+	}
+
+	std::vector<stbrp_rect> rects( images.size() );
+
+	u32 largestSide { 0 };
+	u64 area { 0 };
+
+	for( size_t i = 0; i < images.size(); i++ )
+	{
+		rects[ i ].id	= static_cast<int>( i );
+		rects[ i ].w	= static_cast<stbrp_coord>( images[ i ]->Size().width + 2 * Padding );
+		rects[ i ].h	= static_cast<stbrp_coord>( images[ i ]->Size().height + 2 * Padding );
+
+		largestSide	= std::max( { largestSide, static_cast<u32>( rects[ i ].w ), static_cast<u32>( rects[ i ].h ) } );
+		area		+= static_cast<u64>( rects[ i ].w ) * rects[ i ].h;
+	}
+
+	std::vector<stbrp_node> nodes( maxPageSize );
+
+	/*
+	 * the pages get the smallest power of two size which holds all images, starting at the one which could fit them at best
+	 */
+
+	u32 pageSize { 1 };
+
+	while( ( pageSize < maxPageSize ) && ( ( pageSize < largestSide ) || ( static_cast<u64>( pageSize ) * pageSize < area ) ) )
+	{
+		pageSize <<= 1;
+	}
+
+	for( ; pageSize < maxPageSize; pageSize <<= 1 )
+	{
+		std::vector<stbrp_rect> trialRects = rects;
+
+		stbrp_context context;
+		stbrp_init_target( &context, static_cast<int>( pageSize ), static_cast<int>( pageSize ), nodes.data(), static_cast<int>( nodes.size() ) );
+
+		if( stbrp_pack_rects( &context, trialRects.data(), static_cast<int>( trialRects.size() ) ) )
+		{
+			break;
+		}
+	}
+
+	pageSize = std::min( pageSize, maxPageSize );
+
+	auto atlas = std::make_shared<CTextureAtlas>( name, pageSize );
+
+	/*
+	 * pack the images page by page, until every one found its place
+	 */
+
+	std::vector<stbrp_rect> packedRects;
+
+	u16 pageCount = 0;
+
+	for( std::vector<stbrp_rect> remainingRects = rects; !remainingRects.empty(); pageCount++ )
+	{
+		stbrp_context context;
+		stbrp_init_target( &context, static_cast<int>( pageSize ), static_cast<int>( pageSize ), nodes.data(), static_cast<int>( nodes.size() ) );
+
+		stbrp_pack_rects( &context, remainingRects.data(), static_cast<int>( remainingRects.size() ) );
+
+		std::vector<stbrp_rect> unpackedRects;
+
+		for( const auto &rect : remainingRects )
+		{
+			if( rect.was_packed )
+			{
+				atlas->Entries[ names[ rect.id ] ].Layer = pageCount;
+
+				packedRects.push_back( rect );
+			}
+			else
+			{
+				unpackedRects.push_back( rect );
+			}
+		}
+
+		remainingRects.swap( unpackedRects );
+	}
+
+	/*
+	 * copy the images onto their layers and repeat their borders into the padding
+	 */
+
+	const auto &firstImage = images.front();
+
+	const u32 bytesPerPixel = firstImage->BPP() / 8;
+
+	const u32 pitch = pageSize * bytesPerPixel;
+
+	std::vector<std::unique_ptr<CImage::PixelBuffer>> pages;
+
+	for( u16 page = 0; page < pageCount; page++ )
+	{
+		pages.emplace_back( std::make_unique<CImage::PixelBuffer>( static_cast<size_t>( pitch ) * pageSize ) );
+	}
+
+	for( const auto &rect : packedRects )
+	{
+		const auto &image = images[ rect.id ];
+
+		auto &entry = atlas->Entries[ names[ rect.id ] ];
+
+		const auto &size = image->Size();
+
+		std::byte *destination = pages[ entry.Layer ]->data();
+
+		for( u32 y = 0; y < size.height + 2 * Padding; y++ )
+		{
+			const u32 sourceY = std::clamp( static_cast<s64>( y ) - Padding, static_cast<s64>( 0 ), static_cast<s64>( size.height - 1 ) );
+
+			for( u32 x = 0; x < size.width + 2 * Padding; x++ )
+			{
+				const u32 sourceX = std::clamp( static_cast<s64>( x ) - Padding, static_cast<s64>( 0 ), static_cast<s64>( size.width - 1 ) );
+
+				std::memcpy(	destination + ( rect.y + y ) * pitch + ( rect.x + x ) * bytesPerPixel,
+								image->RawPixelData() + sourceY * image->Pitch() + sourceX * bytesPerPixel,
+								bytesPerPixel );
+			}
+		}
+
+		const f16 scale = 1.0f / static_cast<f16>( pageSize );
+
+		entry.Size			= size;
+		entry.UVTransform	= glm::vec4(	size.width * scale,
+											size.height * scale,
+											( rect.x + Padding ) * scale,
+											( rect.y + Padding ) * scale );
+	}
+
+	/*
+	 * upload all layers at once
+	 */
+
+	auto &texture = atlas->Texture;
+
+	texture->Target = GL_TEXTURE_2D_ARRAY;
+
+	glCreateTextures( texture->Target, 1, &texture->GLID );
+
+	glTextureParameteri( texture->GLID, GL_TEXTURE_BASE_LEVEL, 0 );
+	glTextureParameteri( texture->GLID, GL_TEXTURE_MAX_LEVEL, 0 );
+
+	const GLenum internalFormat = CTextureLoader::PreferredInternalFormatFromImage( texture->Target, firstImage );
+
+	glTextureStorage3D( texture->GLID, 1, internalFormat, pageSize, pageSize, pageCount );
+
+	texture->AllocatedLevels( CSize( pageSize, pageSize ), pageCount, internalFormat, 1, firstImage->BPP() / 8 );
+
+	const GLenum format = CTextureLoader::FormatFromImage( firstImage );
+
+	CTextureLoader::UnpackAlignmentFromPitch( pitch );
+
+	for( u16 page = 0; page < pageCount; page++ )
+	{
+		glTextureSubImage3D( texture->GLID, 0, 0, 0, page, pageSize, pageSize, 1, format, GL_UNSIGNED_BYTE, pages[ page ]->data() );
+	}
+
+	logINFO( "packed {0} images into {1} layers of {2}x{2} of atlas '{3}'", images.size(), pageCount, pageSize, name );
+
+	return( atlas );
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "src/system/CFileSystem.hpp"
+
+#include "src/renderer/COpenGlAdapter.hpp"
+
+#include "src/renderer/texture/CTextureAtlas.hpp"
+
+class CTextureAtlasBuilder final
+{
+public:
+	CTextureAtlasBuilder( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter ) :
+		m_filesystem { p_filesystem },
+		m_openGlAdapter { openGlAdapter }
+	{}
+
+	/**	Packs the images into as many layers as needed, images which differ in their format from the first one are left out.
+		The atlas has no mipmaps, since the lower levels would blend neighbouring entries, so it is meant for textures shown at about their size.
+		The layers are as small as possible, a power of two up to the given size.
+	*/
+	[[nodiscard]] const std::shared_ptr<const CTextureAtlas> FromFiles( const std::string &name, const std::vector<fs::path> &paths, const u32 maxPageSize = DefaultPageSize ) const;
+
+	static const u32 DefaultPageSize;
+
+private:
+	// texels around every entry which repeat its border, so filtering doesn't pick up its neighbours
+	static const u32 Padding;
+
+	const CFileSystem &m_filesystem;
+
+	const COpenGlAdapter &m_openGlAdapter;
+};
\ No newline at end of file
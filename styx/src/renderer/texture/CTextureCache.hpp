@@ -8,9 +8,9 @@
 class CTextureCache final : public CResourceCache<CTexture>
 {
 public:
-	CTextureCache( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter ) :
+	CTextureCache( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter, CTextureStreamer &textureStreamer ) :
 		CResourceCache( "texture", p_filesystem ),
-		m_textureLoader( p_filesystem, openGlAdapter )
+		m_textureLoader( p_filesystem, openGlAdapter, textureStreamer )
 	{}
 
 private:
@@ -19,5 +19,11 @@ private:
 		m_textureLoader.FromFile( resource, id );
 	}
 
+	// the loader sets up the placeholder and the streamer decodes on its workers and uploads on the main thread
+	bool LoadsInBackground() const override
+	{
+		return( true );
+	}
+
 	const CTextureLoader m_textureLoader;
 };
@@ -12,14 +12,19 @@ using json = nlohmann::json;
 #include "src/logger/CLogger.hpp"
 
 #include "src/helper/image/ImageHandler.hpp"
+#include "src/helper/image/BlockCompression.hpp"
+
+#include "src/helper/Json.hpp"
 
 #include "src/renderer/GLHelper.hpp"
+#include "src/renderer/CGLState.hpp"
 
 #include "src/core/StyxException.hpp"
 
-CTextureLoader::CTextureLoader( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter ) :
+CTextureLoader::CTextureLoader( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter, CTextureStreamer &textureStreamer ) :
 	m_filesystem { p_filesystem },
 	m_openGlAdapter { openGlAdapter },
+	m_textureStreamer { textureStreamer },
 	m_dummyImage { ImageHandler::GenerateCheckerImage( CSize( 64, 64 ), CColor( 1.0f, 0.0f, 1.0f, 1.0f ), CColor( 0.0f, 0.0f, 0.0f, 1.0f ) ) }
 {
 	if( !m_dummyImage )
@@ -42,81 +47,123 @@ void CTextureLoader::FromFile( const std::shared_ptr<CTexture> &texture, const f
 		logWARNING( "path '{0}' does not contain a filename", path.generic_string() );
 	}
 
-	// TODO use libktx too?
-
 	const std::string fileExtensionString = path.extension().generic_string();
 
+	// the dummy is also the placeholder, which is shown until the texture is streamed in
+	if( fileExtensionString == std::string( ".cub" ) )
+	{
+		FromCubeDummy( texture );
+	}
+	else if( fileExtensionString == std::string( ".arr" ) )
+	{
+		From2DArrayDummy( texture );
+	}
+	else
+	{
+		FromImageDummy( texture );
+	}
+
 	if( !m_filesystem.Exists( path ) )
 	{
 		logWARNING( "texture file '{0}' does not exist", path.generic_string() );
-		
-		if( fileExtensionString == std::string( ".cub" ) )
-		{
-			FromCubeDummy( texture );
-		}
-		else if( fileExtensionString == std::string( ".arr" ) )
-		{
-			From2DArrayDummy( texture );
-		}
-		else
-		{
-			FromImageDummy( texture );
-		}
 	}
 	else
 	{
+		// the decoders run on worker threads, so they only get what they need by value and must not call into GL
+		const CFileSystem &filesystem = m_filesystem;
+
+		CWorkerPool &workerPool = m_textureStreamer.WorkerPool();
+
 		if( fileExtensionString == std::string( ".cub" ) )
 		{
-			if( !FromCubeFile( texture, path ) )
-			{
-				FromCubeDummy( texture );
-			}
+			const u32 maxSize = m_openGlAdapter.MaxCubeMapTextureSize();
+
+			m_textureStreamer.Enqueue( texture, path.generic_string(), [ &filesystem, &workerPool, path, maxSize ] { return( DecodeCubeFile( filesystem, workerPool, path, maxSize ) ); } );
 		}
 		else if( fileExtensionString == std::string( ".arr" ) )
 		{
-			if( !From2DArrayFile( texture, path ) )
-			{
-				From2DArrayDummy( texture );
-			}
+			const u32 maxSize = m_openGlAdapter.MaxTextureSize();
+
+			m_textureStreamer.Enqueue( texture, path.generic_string(), [ &filesystem, &workerPool, path, maxSize ] { return( Decode2DArrayFile( filesystem, workerPool, path, maxSize ) ); } );
+		}
+		else if( ( fileExtensionString == std::string( ".dds" ) ) || ( fileExtensionString == std::string( ".ktx2" ) ) )
+		{
+			const u32 maxSize = m_openGlAdapter.MaxTextureSize();
+
+			const bool s3tcSupported = m_openGlAdapter.TextureCompressionS3TC();
+
+			m_textureStreamer.Enqueue( texture, path.generic_string(), [ &filesystem, path, maxSize, s3tcSupported ] { return( DecodeCompressedFile( filesystem, path, maxSize, s3tcSupported ) ); } );
 		}
 		else
 		{
-			if( !FromImageFile( texture, path ) )
-			{
-				FromImageDummy( texture );
-			}
+			const u32 maxSize = m_openGlAdapter.MaxTextureSize();
+
+			m_textureStreamer.Enqueue( texture, path.generic_string(), [ &filesystem, path, maxSize ] { return( DecodeImageFile( filesystem, path, maxSize ) ); } );
 		}
 	}
 }
 
-bool CTextureLoader::FromImageFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const
+std::unique_ptr<const CTextureStreamer::SDecodedTexture> CTextureLoader::DecodeImageFile( const CFileSystem &filesystem, const fs::path &path, const u32 maxSize )
 {
-	const std::shared_ptr<const CImage> image = ImageHandler::Load( m_filesystem, path, m_openGlAdapter.MaxTextureSize(), false );
+	// the mip chain is filtered here on the worker thread, so the render thread only uploads it
+	std::vector<std::shared_ptr<const CImage>> mipChain;
+
+	const std::shared_ptr<const CImage> image = ImageHandler::LoadWithMipChain( filesystem, path, maxSize, mipChain );
 
 	if( !image )
 	{
 		logWARNING( "image '{0}' couldn't be loaded", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
-	else
+
+	return( std::make_unique<const CTextureStreamer::SDecodedTexture>( CTextureStreamer::SDecodedTexture { GL_TEXTURE_2D, { image }, true, nullptr, std::move( mipChain ) } ) );
+}
+
+std::unique_ptr<const CTextureStreamer::SDecodedTexture> CTextureLoader::DecodeCompressedFile( const CFileSystem &filesystem, const fs::path &path, const u32 maxSize, const bool s3tcSupported )
+{
+	const std::shared_ptr<const CCompressedImage> compressedImage = ImageHandler::LoadCompressed( filesystem, path, maxSize, false );
+
+	if( !compressedImage )
 	{
-		FromImage( texture, image );
-		return( true );
+		logWARNING( "compressed image '{0}' couldn't be loaded", path.generic_string() );
+		return( nullptr );
+	}
+
+	const auto compression = compressedImage->Compression();
+
+	const bool s3tc = ( CCompressedImage::ECompression::BC1 == compression ) || ( CCompressedImage::ECompression::BC3 == compression );
+
+	if( s3tc && !s3tcSupported )
+	{
+		// the stored levels are lost, so the chain gets generated again from the decompressed image
+		logINFO( "{0} is not supported by the driver, decompressing '{1}'", CCompressedImage::CompressionName( compression ), path.generic_string() );
+
+		const std::shared_ptr<const CImage> image = BlockCompression::Decompress( *compressedImage );
+
+		if( !image )
+		{
+			logWARNING( "image '{0}' couldn't be decompressed", path.generic_string() );
+			return( nullptr );
+		}
+
+		return( std::make_unique<const CTextureStreamer::SDecodedTexture>( CTextureStreamer::SDecodedTexture { GL_TEXTURE_2D, { image }, true } ) );
 	}
+
+	return( std::make_unique<const CTextureStreamer::SDecodedTexture>( CTextureStreamer::SDecodedTexture { GL_TEXTURE_2D, {}, false, compressedImage } ) );
 }
 
-bool CTextureLoader::FromCubeFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const
+std::unique_ptr<const CTextureStreamer::SDecodedTexture> CTextureLoader::DecodeCubeFile( const CFileSystem &filesystem, CWorkerPool &workerPool, const fs::path &path, const u32 maxSize )
 {
 	json root;
 
 	try
 	{
-		root = json::parse( m_filesystem.LoadFileToString( path ) );
+		root = Json::Load( filesystem, path );
 	}
 	catch( json::parse_error &e )
 	{
 		logWARNING( "failed to parse '{0}' because of {1}", path.generic_string(), e.what() );
-		return( false );
+		return( nullptr );
 	}
 
 	const auto json_faces = root.find( "faces" );
@@ -124,65 +171,78 @@ bool CTextureLoader::FromCubeFile( const std::shared_ptr<CTexture> &texture, con
 	if( json_faces == root.end() )
 	{
 		logWARNING( "no faces defined in '{0}'", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 	else if( json_faces->size() < CCubemapData::cubemapFaceCount )
 	{
 		logWARNING( "there are only {0} faces defined in '{1}'", json_faces->size(), path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 	else if( json_faces->size() > CCubemapData::cubemapFaceCount )
 	{
 		logWARNING( "there are too many ( {0} ) faces defined in '{1}'", json_faces->size(), path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 
 	const auto directoryOfFaces = path.parent_path();
 
+	std::array<fs::path, CCubemapData::cubemapFaceCount> pathsOfFaces;
+
+	for( u8 faceNum = 0; faceNum < CCubemapData::cubemapFaceCount; ++faceNum )
+	{
+		pathsOfFaces[ faceNum ] = directoryOfFaces / (*json_faces)[ faceNum ].get<std::string>();
+	}
+
+	// the faces are independent of each other, so they get decoded in parallel and are assembled in order afterwards
+	std::array<std::shared_ptr<const CImage>, CCubemapData::cubemapFaceCount> images;
+
+	workerPool.ParallelFor( images.size(), [ & ]( const size_t faceNum )
+	{
+		images[ faceNum ] = ImageHandler::Load( filesystem, pathsOfFaces[ faceNum ], maxSize, true );
+	} );
+
 	CCubemapData cubemapData;
 
 	for( u8 faceNum = 0; faceNum < CCubemapData::cubemapFaceCount; ++faceNum )
 	{
-		const auto pathOfFace = directoryOfFaces / (*json_faces)[ faceNum ].get<std::string>();
-		const std::shared_ptr<const CImage> image = ImageHandler::Load( m_filesystem, pathOfFace, m_openGlAdapter.MaxCubeMapTextureSize(), true );
-		if( nullptr == image )
+		if( nullptr == images[ faceNum ] )
 		{
-			logWARNING( "failed to load image '{0}' for cubemap '{1}'", pathOfFace.generic_string(), path.generic_string() );
-			return( false );
+			logWARNING( "failed to load image '{0}' for cubemap '{1}'", pathsOfFaces[ faceNum ].generic_string(), path.generic_string() );
+			return( nullptr );
 		}
 		else
 		{
-			if( !cubemapData.SetFace( faceNum, image ) )
+			if( !cubemapData.SetFace( faceNum, images[ faceNum ] ) )
 			{
 				logWARNING( "failed to add face '{0}' for cubemap '{1}'", (*json_faces)[ faceNum ].get<std::string>(), path.generic_string() );
-				return( false );
+				return( nullptr );
 			}
 		}
 	}
 
-	if( FromCubemapData( texture, cubemapData ) )
-	{
-		return( true );
-	}
-	else
+	if( !cubemapData.isComplete() )
 	{
 		logWARNING( "unable to load cubemap for '{0}'", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
+
+	const auto &faces = cubemapData.getFaces();
+
+	return( std::make_unique<const CTextureStreamer::SDecodedTexture>( CTextureStreamer::SDecodedTexture { GL_TEXTURE_CUBE_MAP, std::vector<std::shared_ptr<const CImage>>( std::cbegin( faces ), std::cend( faces ) ), false } ) );
 }
 
-bool CTextureLoader::From2DArrayFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const
+std::unique_ptr<const CTextureStreamer::SDecodedTexture> CTextureLoader::Decode2DArrayFile( const CFileSystem &filesystem, CWorkerPool &workerPool, const fs::path &path, const u32 maxSize )
 {
 	json root;
 
 	try
 	{
-		root = json::parse( m_filesystem.LoadFileToString( path ) );
+		root = Json::Load( filesystem, path );
 	}
 	catch( json::parse_error &e )
 	{
 		logWARNING( "failed to parse '{0}' because of {1}", path.generic_string(), e.what() );
-		return( false );
+		return( nullptr );
 	}
 
 	const auto json_layers = root.find( "layers" );
@@ -190,48 +250,57 @@ bool CTextureLoader::From2DArrayFile( const std::shared_ptr<CTexture> &texture,
 	if( json_layers == root.end() )
 	{
 		logWARNING( "no layers defined in '{0}'", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 	else if( json_layers->size() > std::numeric_limits<u8>::max() )
 	{
 		logWARNING( "more than the maximum of {0} layers defined in '{1}'", std::numeric_limits<u8>::max(), path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
 
 	const auto directoryOfLayers = path.parent_path();
 
-	C2DArrayData arrayData;
+	std::vector<fs::path> pathsOfLayers;
 
 	for( const auto &layer : (*json_layers) )
 	{
-		const auto pathOfLayer = directoryOfLayers / layer.get<std::string>();
+		pathsOfLayers.push_back( directoryOfLayers / layer.get<std::string>() );
+	}
+
+	// the layers are independent of each other, so they get decoded in parallel and are assembled in order afterwards
+	std::vector<std::shared_ptr<const CImage>> images( pathsOfLayers.size() );
 
-		const std::shared_ptr<const CImage> image = ImageHandler::Load( m_filesystem, pathOfLayer, m_openGlAdapter.MaxTextureSize(), false );
+	workerPool.ParallelFor( images.size(), [ & ]( const size_t layerNum )
+	{
+		images[ layerNum ] = ImageHandler::Load( filesystem, pathsOfLayers[ layerNum ], maxSize, false );
+	} );
 
-		if( nullptr == image )
+	C2DArrayData arrayData;
+
+	for( size_t layerNum = 0; layerNum < images.size(); ++layerNum )
+	{
+		if( nullptr == images[ layerNum ] )
 		{
-			logWARNING( "failed to load image '{0}' for array texture '{1}'", pathOfLayer.generic_string(), path.generic_string() );
-			return( false );
+			logWARNING( "failed to load image '{0}' for array texture '{1}'", pathsOfLayers[ layerNum ].generic_string(), path.generic_string() );
+			return( nullptr );
 		}
 		else
 		{
-			if( !arrayData.AddLayer( image ) )
+			if( !arrayData.AddLayer( images[ layerNum ] ) )
 			{
-				logWARNING( "failed to add layer '{0}' for array texture '{1}'", layer.get<std::string>(), path.generic_string() );
-				return( false );
+				logWARNING( "failed to add layer '{0}' for array texture '{1}'", pathsOfLayers[ layerNum ].filename().generic_string(), path.generic_string() );
+				return( nullptr );
 			}
 		}
 	}
 
-	if( From2DArrayData( texture, arrayData ) )
-	{
-		return( true );
-	}
-	else
+	if( arrayData.getLayers().empty() )
 	{
 		logWARNING( "unable to load 2D array for '{0}'", path.generic_string() );
-		return( false );
+		return( nullptr );
 	}
+
+	return( std::make_unique<const CTextureStreamer::SDecodedTexture>( CTextureStreamer::SDecodedTexture { GL_TEXTURE_2D_ARRAY, arrayData.getLayers(), true } ) );
 }
 
 void CTextureLoader::FromImage( const std::shared_ptr<CTexture> &texture, const std::shared_ptr<const CImage> &image )
@@ -246,12 +315,18 @@ void CTextureLoader::FromImage( const std::shared_ptr<CTexture> &texture, const
 	glTextureParameteri( texture->GLID, GL_TEXTURE_BASE_LEVEL, 0 );
 	glTextureParameteri( texture->GLID, GL_TEXTURE_MAX_LEVEL, maxMipLevel );
 
+	const GLenum internalFormat = PreferredInternalFormatFromImage( texture->Target, image );
+
 	glTextureStorage2D( texture->GLID,
 						maxMipLevel,
-						PreferredInternalFormatFromImage( texture->Target, image ),
+						internalFormat,
 						size.width,
 						size.height );
 
+	texture->AllocatedLevels( size, 1, internalFormat, static_cast<u32>( maxMipLevel ), image->BPP() / 8 );
+
+	UnpackAlignmentFromPitch( image->Pitch() );
+
 	glTextureSubImage2D(	texture->GLID,
 							0, // level
 							0, // xoffset
@@ -280,15 +355,21 @@ bool CTextureLoader::FromCubemapData( const std::shared_ptr<CTexture> &texture,
 
 		const auto &size = faces[ 0 ]->Size();
 
+		const GLenum internalFormat = PreferredInternalFormatFromImage( texture->Target, faces[ 0 ] );
+
 		glTextureStorage2D( texture->GLID,
 							1, // levels
-							PreferredInternalFormatFromImage( texture->Target, faces[ 0 ] ),
+							internalFormat,
 							size.width,
 							size.height );
 
+		texture->AllocatedLevels( size, static_cast<GLsizei>( faces.size() ), internalFormat, 1, faces[ 0 ]->BPP() / 8 );
+
 		u8 faceNum = 0;
 		for( const auto &face : faces )
 		{
+			UnpackAlignmentFromPitch( face->Pitch() );
+
 			glTextureSubImage3D(	texture->GLID,
 									0, // level
 									0, // xoffset
@@ -327,16 +408,22 @@ bool CTextureLoader::From2DArrayData( const std::shared_ptr<CTexture> &texture,
 		glTextureParameteri( texture->GLID, GL_TEXTURE_BASE_LEVEL, 0 );
 		glTextureParameteri( texture->GLID, GL_TEXTURE_MAX_LEVEL, maxMipLevel );
 
+		const GLenum internalFormat = PreferredInternalFormatFromImage( texture->Target, layers[ 0 ] );
+
 		glTextureStorage3D( texture->GLID,
 							maxMipLevel,
-							PreferredInternalFormatFromImage( texture->Target, layers[ 0 ] ),
+							internalFormat,
 							size.width,
 							size.height,
 							layers.size() );
 
+		texture->AllocatedLevels( size, static_cast<GLsizei>( layers.size() ), internalFormat, static_cast<u32>( maxMipLevel ), layers[ 0 ]->BPP() / 8 );
+
 		u8 layerNum = 0;
 		for( const auto &layer : layers )
 		{
+			UnpackAlignmentFromPitch( layer->Pitch() );
+
 			glTextureSubImage3D(	texture->GLID,
 									0, // level
 									0, // xoffset
@@ -438,6 +525,35 @@ GLenum CTextureLoader::PreferredInternalFormatFromImage( const GLenum target, co
 	return( static_cast<GLenum>( m_preferredInternalTextureFormat ) );
 }
 
+GLenum CTextureLoader::InternalFormatFromCompression( const CCompressedImage::ECompression compression )
+{
+	switch( compression )
+	{
+		case CCompressedImage::ECompression::BC1:
+			return( GL_COMPRESSED_RGBA_S3TC_DXT1_EXT );
+
+		case CCompressedImage::ECompression::BC3:
+			return( GL_COMPRESSED_RGBA_S3TC_DXT5_EXT );
+
+		case CCompressedImage::ECompression::BC4:
+			return( GL_COMPRESSED_RED_RGTC1 );
+
+		case CCompressedImage::ECompression::BC5:
+			return( GL_COMPRESSED_RG_RGTC2 );
+
+		case CCompressedImage::ECompression::BC7:
+			return( GL_COMPRESSED_RGBA_BPTC_UNORM );
+
+		default:
+			throw std::runtime_error( fmt::format( "no GL format for compression '{0}'", CCompressedImage::CompressionName( compression ) ) );
+	}
+}
+
+void CTextureLoader::UnpackAlignmentFromPitch( const u32 pitch )
+{
+	CGLState::UnpackAlignment( ( 0 == pitch % 8 ) ? 8 : ( 0 == pitch % 4 ) ? 4 : ( 0 == pitch % 2 ) ? 2 : 1 );
+}
+
 GLenum CTextureLoader::FormatFromImage( const std::shared_ptr<const CImage> &image )
 {
 	switch( image->BPP() )
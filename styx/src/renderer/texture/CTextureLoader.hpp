@@ -5,6 +5,7 @@
 #include "src/core/Types.hpp"
 
 #include "src/helper/image/CImage.hpp"
+#include "src/helper/image/CCompressedImage.hpp"
 
 #include "src/system/CFileSystem.hpp"
 
@@ -14,21 +15,34 @@
 
 #include "src/renderer/texture/CCubemapData.hpp"
 #include "src/renderer/texture/C2DArrayData.hpp"
+#include "src/renderer/texture/CTextureStreamer.hpp"
 
 class CTextureLoader final
 {
 public:
-	CTextureLoader( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter );
+	CTextureLoader( const CFileSystem &p_filesystem, const COpenGlAdapter &openGlAdapter, CTextureStreamer &textureStreamer );
 	~CTextureLoader();
 
+	// sets up the placeholder right away and hands the file over to the streamer
 	void FromFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const;
 	
 	static void FromImage( const std::shared_ptr<CTexture> &texture, const std::shared_ptr<const CImage> &image );
 
+	static GLenum PreferredInternalFormatFromImage( const GLenum target, const std::shared_ptr<const CImage> &image );
+	static GLenum FormatFromImage( const std::shared_ptr<const CImage> &image );
+	static GLenum InternalFormatFromCompression( const CCompressedImage::ECompression compression );
+
+	// rows of 8 and 16bpp images and of small levels are often not 4 byte aligned, has to be called before uploading pixels
+	static void UnpackAlignmentFromPitch( const u32 pitch );
+
+	// the decoders don't call into GL, the faces and layers are spread over the worker pool
+	static std::unique_ptr<const CTextureStreamer::SDecodedTexture> DecodeImageFile( const CFileSystem &filesystem, const fs::path &path, const u32 maxSize );
+	// DDS and KTX2, the blocks are decompressed if the driver can't sample them
+	static std::unique_ptr<const CTextureStreamer::SDecodedTexture> DecodeCompressedFile( const CFileSystem &filesystem, const fs::path &path, const u32 maxSize, const bool s3tcSupported );
+	static std::unique_ptr<const CTextureStreamer::SDecodedTexture> DecodeCubeFile( const CFileSystem &filesystem, CWorkerPool &workerPool, const fs::path &path, const u32 maxSize );
+	static std::unique_ptr<const CTextureStreamer::SDecodedTexture> Decode2DArrayFile( const CFileSystem &filesystem, CWorkerPool &workerPool, const fs::path &path, const u32 maxSize );
+
 private:
-	bool FromImageFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const;
-	bool FromCubeFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const;
-	bool From2DArrayFile( const std::shared_ptr<CTexture> &texture, const fs::path &path ) const;
 
 	bool FromCubemapData( const std::shared_ptr<CTexture> &texture, const CCubemapData &cubemapData ) const;
 	bool From2DArrayData( const std::shared_ptr<CTexture> &texture, const C2DArrayData &arrayData ) const;
@@ -36,13 +50,12 @@ private:
 	void FromImageDummy( const std::shared_ptr<CTexture> &texture ) const;
 	void FromCubeDummy( const std::shared_ptr<CTexture> &texture ) const;
 	void From2DArrayDummy( const std::shared_ptr<CTexture> &texture ) const;
-	
-	static GLenum PreferredInternalFormatFromImage( const GLenum target, const std::shared_ptr<const CImage> &image );
-	static GLenum FormatFromImage( const std::shared_ptr<const CImage> &image );
 
 	const CFileSystem &m_filesystem;
 
 	const COpenGlAdapter &m_openGlAdapter;
 
+	CTextureStreamer &m_textureStreamer;
+
 	const std::shared_ptr<const CImage> m_dummyImage;
 };
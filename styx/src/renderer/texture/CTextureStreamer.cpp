@@ -0,0 +1,636 @@
+#include "CTextureStreamer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/renderer/CGLState.hpp"
+
+#include "src/renderer/texture/CTextureLoader.hpp"
+
+CTextureStreamer::CTextureStreamer( const CSettings &settings ) :
+	m_uploadBudget { std::max( static_cast<u64>( settings.renderer.textures.upload_budget ) * 1024, static_cast<u64>( 1 ) ) },
+	m_memoryBudget { static_cast<u64>( settings.renderer.textures.memory_budget ) * 1024 * 1024 },
+	m_workerPool( "texture decoder", CWorkerPool::DefaultWorkerCount() )
+{
+	glCreateBuffers( PixelBufferRingSize, m_pixelBuffers.data() );
+
+	m_pixelBufferSizes.fill( 0 );
+
+	m_statistics.budget = m_memoryBudget;
+
+	logINFO( "texture streamer was initialized with an upload budget of {0} KiB per frame", settings.renderer.textures.upload_budget );
+
+	if( 0 == m_memoryBudget )
+	{
+		logINFO( "texture memory is unlimited" );
+	}
+	else
+	{
+		logINFO( "texture memory is limited to {0} MiB", settings.renderer.textures.memory_budget );
+	}
+}
+
+CTextureStreamer::~CTextureStreamer()
+{
+	logINFO( "texture streamer is shutting down" );
+
+	for( const auto &upload : m_uploads )
+	{
+		if( 0 != upload.stagingGLID )
+		{
+			CGLState::DeleteTexture( upload.stagingGLID );
+		}
+	}
+
+	for( const auto pixelBuffer : m_pixelBuffers )
+	{
+		CGLState::DeleteBuffer( pixelBuffer );
+	}
+}
+
+void CTextureStreamer::Enqueue( const std::shared_ptr<CTexture> &texture, const std::string &name, TDecoder decoder )
+{
+	auto &resident = m_residents[ texture.get() ];
+	resident.texture		= texture;
+	resident.name			= name;
+	resident.decoder		= decoder;
+	resident.wantedMip		= 0;
+	resident.wantedFrame	= m_frame;
+
+	Submit( texture, name, decoder, 0 );
+}
+
+void CTextureStreamer::Submit( const std::shared_ptr<CTexture> &texture, const std::string &name, TDecoder decoder, const u8 firstMip )
+{
+	const u64 ticket = m_nextTicket++;
+
+	m_latestTickets[ texture.get() ] = ticket;
+
+	m_pendingTextures++;
+
+	const std::weak_ptr<CTexture> weakTexture = texture;
+
+	m_workerPool.Submit( [ this, weakTexture, name, ticket, firstMip, decoder ]
+	{
+		SUpload upload;
+		upload.texture	= weakTexture;
+		upload.name		= name;
+		upload.ticket	= ticket;
+		upload.firstMip	= firstMip;
+
+		try
+		{
+			upload.decodedTexture = decoder();
+		}
+		catch( std::exception &e )
+		{
+			logWARNING( "decoding texture '{0}' failed: {1}", name, e.what() );
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock( m_decodedMutex );
+
+			m_decoded.push_back( std::move( upload ) );
+		}
+
+		m_decodedCondition.notify_all();
+	} );
+}
+
+void CTextureStreamer::Update()
+{
+	m_frame++;
+
+	Upload( m_uploadBudget );
+
+	ManageResidency();
+}
+
+void CTextureStreamer::Finish()
+{
+	while( m_pendingTextures > 0 )
+	{
+		Upload( std::numeric_limits<u64>::max() );
+
+		if( m_pendingTextures > 0 )
+		{
+			std::unique_lock<std::mutex> lock( m_decodedMutex );
+
+			m_decodedCondition.wait( lock, [ this ] { return( !m_decoded.empty() ); } );
+		}
+	}
+}
+
+u32 CTextureStreamer::PendingTextures() const
+{
+	return( m_pendingTextures );
+}
+
+CWorkerPool &CTextureStreamer::WorkerPool()
+{
+	return( m_workerPool );
+}
+
+u64 CTextureStreamer::Frame() const
+{
+	return( m_frame );
+}
+
+const CTextureStreamer::SStatistics &CTextureStreamer::Statistics() const
+{
+	return( m_statistics );
+}
+
+void CTextureStreamer::LogResidency() const
+{
+	logINFO( "texture memory: {0} KiB of {1} KiB resident in {2} textures, {3} reduced", m_statistics.residentSize / 1024, m_statistics.budget / 1024, m_statistics.textures, m_statistics.reducedTextures );
+
+	for( const auto & [ key, resident ] : m_residents )
+	{
+		if( const auto texture = resident.texture.lock(); texture )
+		{
+			logINFO( "\t{0}: {1} KiB, levels {2}-{3}, wanted from {4}", resident.name, texture->ResidentSize() / 1024, static_cast<u16>( texture->ResidentMip ), texture->MipChain.levelBytes.size() - 1, static_cast<u16>( resident.wantedMip ) );
+		}
+	}
+}
+
+void CTextureStreamer::Upload( const u64 budget )
+{
+	{
+		const std::lock_guard<std::mutex> lock( m_decodedMutex );
+
+		std::move( std::begin( m_decoded ), std::end( m_decoded ), std::back_inserter( m_uploads ) );
+
+		m_decoded.clear();
+	}
+
+	u64 uploadedBytes { 0 };
+
+	while( !m_uploads.empty() && ( uploadedBytes < budget ) )
+	{
+		auto &upload = m_uploads.front();
+
+		const auto texture = upload.texture.lock();
+
+		if( Discard( upload, texture ) )
+		{
+			logDEBUG( "discarding outdated upload of texture '{0}'", upload.name );
+		}
+		else if( !upload.decodedTexture || ( 0 == upload.decodedTexture->UploadCount() ) )
+		{
+			logWARNING( "texture '{0}' couldn't be decoded, keeping the placeholder", upload.name );
+		}
+		else
+		{
+			const auto &decodedTexture = *upload.decodedTexture;
+
+			if( 0 == upload.stagingGLID )
+			{
+				upload.stagingGLID = CreateStorage( decodedTexture );
+			}
+
+			if( decodedTexture.compressedImage )
+			{
+				uploadedBytes += UploadCompressedLevel( upload.stagingGLID, static_cast<GLint>( upload.nextUpload ), *decodedTexture.compressedImage );
+			}
+			else if( upload.nextUpload < decodedTexture.images.size() )
+			{
+				uploadedBytes += UploadImage( upload.stagingGLID, decodedTexture.target, 0, static_cast<GLint>( upload.nextUpload ), decodedTexture.images[ upload.nextUpload ] );
+			}
+			else
+			{
+				const size_t mipIndex = upload.nextUpload - decodedTexture.images.size();
+
+				uploadedBytes += UploadImage( upload.stagingGLID, decodedTexture.target, static_cast<GLint>( mipIndex + 1 ), 0, decodedTexture.mipLevels[ mipIndex ] );
+			}
+
+			if( ++upload.nextUpload < decodedTexture.UploadCount() )
+			{
+				continue;
+			}
+
+			if( decodedTexture.mipmaps && decodedTexture.mipLevels.empty() )
+			{
+				glGenerateTextureMipmap( upload.stagingGLID );
+			}
+
+			// replaces the placeholder
+			texture->Reset();
+			texture->Target	= decodedTexture.target;
+			texture->GLID	= upload.stagingGLID;
+
+			upload.stagingGLID = 0;
+
+			FillMipChain( *texture, decodedTexture );
+
+			const u8 coarsestMip = static_cast<u8>( texture->MipChain.levelBytes.size() - 1 );
+
+			if( upload.firstMip > 0 )
+			{
+				DropMips( *texture, std::min( upload.firstMip, coarsestMip ) );
+			}
+
+			logDEBUG( "texture '{0}' was streamed in", upload.name );
+		}
+
+		if( 0 != upload.stagingGLID )
+		{
+			CGLState::DeleteTexture( upload.stagingGLID );
+		}
+
+		if( texture )
+		{
+			if( const auto it = m_latestTickets.find( texture.get() ); ( std::end( m_latestTickets ) != it ) && ( it->second == upload.ticket ) )
+			{
+				m_latestTickets.erase( it );
+			}
+		}
+
+		m_uploads.pop_front();
+
+		m_pendingTextures--;
+	}
+
+	CGLState::BindPixelUnpackBuffer( 0 );
+}
+
+void CTextureStreamer::ManageResidency()
+{
+	struct SCandidate final
+	{
+		SResident					*resident;
+		std::shared_ptr<CTexture>	texture;
+		u8							coarsestMip;
+		u8							targetMip;
+	};
+
+	std::vector<SCandidate> candidates;
+	candidates.reserve( m_residents.size() );
+
+	u64 residentSize { 0 };
+
+	for( auto it = std::begin( m_residents ); it != std::end( m_residents ); )
+	{
+		auto &resident = it->second;
+
+		const auto texture = resident.texture.lock();
+
+		if( !texture )
+		{
+			it = m_residents.erase( it );
+			continue;
+		}
+
+		++it;
+
+		// still shows its placeholder
+		if( !texture->Streamed )
+		{
+			continue;
+		}
+
+		const u8 coarsestMip = static_cast<u8>( texture->MipChain.levelBytes.size() - 1 );
+
+		// the requests were made while rendering the last frame
+		if( ( texture->RequestFrame() + 1 ) >= m_frame )
+		{
+			// a finer level is taken at once, a coarser one only after the finer one wasn't needed for a while
+			if( ( texture->RequestedMip() <= resident.wantedMip ) || ( ( m_frame - resident.wantedFrame ) > UsageFrames ) )
+			{
+				resident.wantedMip		= texture->RequestedMip();
+				resident.wantedFrame	= m_frame;
+			}
+		}
+		else if( ( m_frame - resident.wantedFrame ) > UsageFrames )
+		{
+			resident.wantedMip = coarsestMip;
+		}
+
+		residentSize += texture->ResidentSize();
+
+		candidates.push_back( { &resident, texture, coarsestMip, texture->ResidentMip } );
+	}
+
+	// the least important first, those which weren't needed for the longest time and then those which need the coarsest level
+	std::sort( std::begin( candidates ), std::end( candidates ), []( const SCandidate &a, const SCandidate &b )
+	{
+		if( a.resident->wantedFrame != b.resident->wantedFrame )
+		{
+			return( a.resident->wantedFrame < b.resident->wantedFrame );
+		}
+
+		return( a.resident->wantedMip > b.resident->wantedMip );
+	} );
+
+	if( ( 0 != m_memoryBudget ) && ( residentSize > m_memoryBudget ) )
+	{
+		// first drop the levels which are finer than needed
+		for( auto &candidate : candidates )
+		{
+			while( ( residentSize > m_memoryBudget ) && ( candidate.targetMip < candidate.resident->wantedMip ) )
+			{
+				residentSize -= candidate.texture->MipChain.levelBytes[ candidate.targetMip++ ];
+			}
+		}
+
+		// then take one level at a time from every texture, so the loss of detail is spread
+		bool dropped { true };
+
+		while( ( residentSize > m_memoryBudget ) && dropped )
+		{
+			dropped = false;
+
+			for( auto &candidate : candidates )
+			{
+				if( ( residentSize > m_memoryBudget ) && ( candidate.targetMip < candidate.coarsestMip ) )
+				{
+					residentSize -= candidate.texture->MipChain.levelBytes[ candidate.targetMip++ ];
+
+					dropped = true;
+				}
+			}
+		}
+
+		if( residentSize > m_memoryBudget )
+		{
+			logWARNING( "texture memory budget of {0} KiB is exceeded even with only the coarsest levels resident", m_memoryBudget / 1024 );
+		}
+
+		for( const auto &candidate : candidates )
+		{
+			if( candidate.targetMip > candidate.texture->ResidentMip )
+			{
+				logDEBUG( "dropping mip levels of texture '{0}' above level {1}", candidate.resident->name, static_cast<u16>( candidate.targetMip ) );
+
+				DropMips( *candidate.texture, candidate.targetMip );
+			}
+		}
+	}
+	else
+	{
+		// stream the most important texture missing needed levels in again, one per frame so it doesn't compete with new textures
+		for( auto it = candidates.rbegin(); it != candidates.rend(); ++it )
+		{
+			const auto &texture = it->texture;
+
+			const u8 wantedMip = it->resident->wantedMip;
+
+			if( ( texture->ResidentMip <= wantedMip ) || ( std::end( m_latestTickets ) != m_latestTickets.find( texture.get() ) ) )
+			{
+				continue;
+			}
+
+			u64 missingSize { 0 };
+
+			for( u8 level = wantedMip; level < texture->ResidentMip; level++ )
+			{
+				missingSize += texture->MipChain.levelBytes[ level ];
+			}
+
+			if( ( 0 == m_memoryBudget ) || ( ( residentSize + missingSize ) <= m_memoryBudget ) )
+			{
+				logDEBUG( "streaming texture '{0}' in again from level {1}", it->resident->name, static_cast<u16>( wantedMip ) );
+
+				Submit( texture, it->resident->name, it->resident->decoder, wantedMip );
+
+				break;
+			}
+		}
+	}
+
+	m_statistics.residentSize		= 0;
+	m_statistics.textures			= static_cast<u32>( candidates.size() );
+	m_statistics.reducedTextures	= 0;
+
+	for( const auto &candidate : candidates )
+	{
+		m_statistics.residentSize += candidate.texture->ResidentSize();
+
+		if( candidate.texture->ResidentMip > 0 )
+		{
+			m_statistics.reducedTextures++;
+		}
+	}
+}
+
+bool CTextureStreamer::Discard( const SUpload &upload, const std::shared_ptr<CTexture> &texture ) const
+{
+	if( nullptr == texture )
+	{
+		return( true );
+	}
+
+	const auto it = m_latestTickets.find( texture.get() );
+
+	return( ( std::end( m_latestTickets ) == it ) || ( it->second != upload.ticket ) );
+}
+
+size_t CTextureStreamer::SDecodedTexture::UploadCount() const
+{
+	return( compressedImage ? compressedImage->Levels().size() : ( images.size() + mipLevels.size() ) );
+}
+
+GLuint CTextureStreamer::CreateStorage( const SDecodedTexture &decodedTexture )
+{
+	if( decodedTexture.compressedImage )
+	{
+		const auto &compressedImage = *decodedTexture.compressedImage;
+
+		const GLsizei levels = static_cast<GLsizei>( compressedImage.Levels().size() );
+
+		GLuint GLID;
+
+		glCreateTextures( decodedTexture.target, 1, &GLID );
+
+		glTextureParameteri( GLID, GL_TEXTURE_BASE_LEVEL, 0 );
+		glTextureParameteri( GLID, GL_TEXTURE_MAX_LEVEL, levels - 1 );
+
+		glTextureStorage2D( GLID, levels, CTextureLoader::InternalFormatFromCompression( compressedImage.Compression() ), compressedImage.Size().width, compressedImage.Size().height );
+
+		return( GLID );
+	}
+
+	const auto &firstImage = decodedTexture.images.front();
+
+	const auto &size = firstImage->Size();
+
+	const GLsizei levels = decodedTexture.mipmaps ? static_cast<GLsizei>( floor( log2( std::max( size.width, size.height ) ) ) ) + 1 : 1;
+
+	GLuint GLID;
+
+	glCreateTextures( decodedTexture.target, 1, &GLID );
+
+	glTextureParameteri( GLID, GL_TEXTURE_BASE_LEVEL, 0 );
+	glTextureParameteri( GLID, GL_TEXTURE_MAX_LEVEL, levels - 1 );
+
+	const GLenum internalFormat = CTextureLoader::PreferredInternalFormatFromImage( decodedTexture.target, firstImage );
+
+	if( GL_TEXTURE_2D_ARRAY == decodedTexture.target )
+	{
+		glTextureStorage3D( GLID, levels, internalFormat, size.width, size.height, static_cast<GLsizei>( decodedTexture.images.size() ) );
+	}
+	else
+	{
+		// a cubemap allocates all of its faces at once
+		glTextureStorage2D( GLID, levels, internalFormat, size.width, size.height );
+	}
+
+	return( GLID );
+}
+
+void CTextureStreamer::FillMipChain( CTexture &texture, const SDecodedTexture &decodedTexture )
+{
+	auto &mipChain = texture.MipChain;
+
+	mipChain.levelBytes.clear();
+
+	texture.ResidentMip = 0;
+	texture.Streamed = true;
+
+	if( decodedTexture.compressedImage )
+	{
+		const auto &compressedImage = *decodedTexture.compressedImage;
+
+		mipChain.size			= compressedImage.Size();
+		mipChain.depth			= 1;
+		mipChain.internalFormat	= CTextureLoader::InternalFormatFromCompression( compressedImage.Compression() );
+
+		for( const auto &level : compressedImage.Levels() )
+		{
+			mipChain.levelBytes.push_back( static_cast<u64>( level.data.size() ) );
+		}
+
+		return;
+	}
+
+	const auto &firstImage = decodedTexture.images.front();
+
+	const auto &size = firstImage->Size();
+
+	const u32 levels = decodedTexture.mipmaps ? static_cast<u32>( floor( log2( std::max( size.width, size.height ) ) ) ) + 1 : 1;
+
+	texture.AllocatedLevels( size, static_cast<GLsizei>( decodedTexture.images.size() ), CTextureLoader::PreferredInternalFormatFromImage( decodedTexture.target, firstImage ), levels, firstImage->BPP() / 8 );
+}
+
+void CTextureStreamer::DropMips( CTexture &texture, const u8 mip )
+{
+	const auto &mipChain = texture.MipChain;
+
+	const GLsizei levels = static_cast<GLsizei>( mipChain.levelBytes.size() ) - mip;
+
+	const GLsizei width		= static_cast<GLsizei>( std::max( mipChain.size.width >> mip, 1u ) );
+	const GLsizei height	= static_cast<GLsizei>( std::max( mipChain.size.height >> mip, 1u ) );
+
+	GLuint GLID;
+
+	glCreateTextures( texture.Target, 1, &GLID );
+
+	glTextureParameteri( GLID, GL_TEXTURE_BASE_LEVEL, 0 );
+	glTextureParameteri( GLID, GL_TEXTURE_MAX_LEVEL, levels - 1 );
+
+	if( GL_TEXTURE_2D_ARRAY == texture.Target )
+	{
+		glTextureStorage3D( GLID, levels, mipChain.internalFormat, width, height, mipChain.depth );
+	}
+	else
+	{
+		glTextureStorage2D( GLID, levels, mipChain.internalFormat, width, height );
+	}
+
+	// the remaining levels are copied on the GPU, so nothing has to be decoded again
+	const GLint levelOffset = mip - texture.ResidentMip;
+
+	for( GLint level = 0; level < levels; level++ )
+	{
+		const GLsizei levelWidth	= std::max( width >> level, 1 );
+		const GLsizei levelHeight	= std::max( height >> level, 1 );
+
+		glCopyImageSubData(	texture.GLID, texture.Target, level + levelOffset, 0, 0, 0,
+							GLID, texture.Target, level, 0, 0, 0,
+							levelWidth, levelHeight, mipChain.depth );
+	}
+
+	// the mip chain stays, only the levels above mip are gone
+	CGLState::DeleteTexture( texture.GLID );
+	texture.GLID = GLID;
+
+	texture.ResidentMip = mip;
+}
+
+u64 CTextureStreamer::UploadImage( const GLuint GLID, const GLenum target, const GLint level, const GLint layer, const std::shared_ptr<const CImage> &image )
+{
+	const auto &size = image->Size();
+
+	const GLsizeiptr byteCount = static_cast<GLsizeiptr>( image->Pitch() ) * size.height;
+
+	const GLenum format = CTextureLoader::FormatFromImage( image );
+
+	const void *pixels = Stage( image->RawPixelData(), byteCount );
+
+	CTextureLoader::UnpackAlignmentFromPitch( image->Pitch() );
+
+	if( GL_TEXTURE_2D == target )
+	{
+		glTextureSubImage2D( GLID, level, 0, 0, size.width, size.height, format, GL_UNSIGNED_BYTE, pixels );
+	}
+	else
+	{
+		// faces of a cubemap are addressed like layers with DSA
+		glTextureSubImage3D( GLID, level, 0, 0, layer, size.width, size.height, 1, format, GL_UNSIGNED_BYTE, pixels );
+	}
+
+	return( static_cast<u64>( byteCount ) );
+}
+
+u64 CTextureStreamer::UploadCompressedLevel( const GLuint GLID, const GLint level, const CCompressedImage &compressedImage )
+{
+	const auto &compressedLevel = compressedImage.Levels()[ level ];
+
+	const GLsizeiptr byteCount = static_cast<GLsizeiptr>( compressedLevel.data.size() );
+
+	const void *blocks = Stage( compressedLevel.data.data(), byteCount );
+
+	glCompressedTextureSubImage2D( GLID, level, 0, 0, compressedLevel.size.width, compressedLevel.size.height, CTextureLoader::InternalFormatFromCompression( compressedImage.Compression() ), static_cast<GLsizei>( byteCount ), blocks );
+
+	return( static_cast<u64>( byteCount ) );
+}
+
+const void *CTextureStreamer::Stage( const std::byte *data, const GLsizeiptr byteCount )
+{
+	const GLuint pixelBuffer = m_pixelBuffers[ m_nextPixelBuffer ];
+
+	auto &pixelBufferSize = m_pixelBufferSizes[ m_nextPixelBuffer ];
+
+	// cycling through the ring leaves the previous uploads time to finish before their buffer gets written again
+	m_nextPixelBuffer = ( m_nextPixelBuffer + 1 ) % PixelBufferRingSize;
+
+	if( byteCount > pixelBufferSize )
+	{
+		glNamedBufferData( pixelBuffer, byteCount, nullptr, GL_STREAM_DRAW );
+		pixelBufferSize = byteCount;
+	}
+
+	// invalidating lets the driver hand out fresh memory instead of waiting for a pending upload out of this buffer
+	void *mappedBuffer = glMapNamedBufferRange( pixelBuffer, 0, byteCount, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT );
+
+	if( nullptr == mappedBuffer )
+	{
+		logWARNING( "mapping the pixel unpack buffer failed, uploading directly" );
+
+		CGLState::BindPixelUnpackBuffer( 0 );
+
+		return( data );
+	}
+
+	std::copy( data, data + byteCount, static_cast<std::byte *>( mappedBuffer ) );
+
+	glUnmapNamedBuffer( pixelBuffer );
+
+	CGLState::BindPixelUnpackBuffer( pixelBuffer );
+
+	// the offset into the bound buffer
+	return( nullptr );
+}
\ No newline at end of file
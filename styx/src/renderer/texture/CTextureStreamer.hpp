@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/core/Types.hpp"
+
+#include "src/renderer/GL.h"
+
+#include "src/helper/image/CImage.hpp"
+#include "src/helper/image/CCompressedImage.hpp"
+
+#include "src/system/CSettings.hpp"
+#include "src/system/CWorkerPool.hpp"
+
+#include "src/renderer/texture/CTexture.hpp"
+
+/**
+ * Decodes textures on worker threads and uploads them through a ring of pixel unpack buffers.
+ * Only a limited amount of bytes gets uploaded per frame, so loading big textures doesn't stall the frame.
+ * The texture keeps its placeholder until every image was uploaded, then the real one is swapped in.
+ *
+ * When the streamed textures exceed the memory budget, the top mip levels of the least important ones are dropped.
+ * They are streamed in again by running their decoder anew, as soon as they are needed and fit into the budget.
+ */
+class CTextureStreamer final
+{
+public:
+	struct SDecodedTexture final
+	{
+		GLenum target;
+
+		// one image per face of a cubemap or layer of an array
+		std::vector<std::shared_ptr<const CImage>> images;
+
+		bool mipmaps;
+
+		// when set, its stored levels are uploaded instead of the images
+		std::shared_ptr<const CCompressedImage> compressedImage { nullptr };
+
+		// the levels below a single image, filtered on the worker thread so the driver doesn't have to generate them
+		std::vector<std::shared_ptr<const CImage>> mipLevels {};
+
+		// the images and mip levels or the levels of the compressed image
+		size_t UploadCount() const;
+	};
+
+	// runs on a worker thread, so it must not call into GL, returns nullptr on failure
+	using TDecoder = std::function<std::unique_ptr<const SDecodedTexture>()>;
+
+	struct SStatistics final
+	{
+		// in bytes, 0 means unlimited
+		u64 budget			{ 0 };
+		u64 residentSize	{ 0 };
+
+		u32 textures		{ 0 };
+		// textures which miss some of their top mip levels
+		u32 reducedTextures	{ 0 };
+	};
+
+	explicit CTextureStreamer( const CSettings &settings );
+	~CTextureStreamer();
+
+	// the texture has to hold its placeholder already
+	void Enqueue( const std::shared_ptr<CTexture> &texture, const std::string &name, TDecoder decoder );
+
+	// uploads as much as the budget per frame allows, swaps in the finished textures and keeps them inside the memory budget
+	void Update();
+
+	// blocks until every queued texture is uploaded
+	void Finish();
+
+	u32 PendingTextures() const;
+
+	// the renderer tags the mip requests of the textures with it
+	u64 Frame() const;
+
+	const SStatistics &Statistics() const;
+
+	// logs the resident size of every streamed texture
+	void LogResidency() const;
+
+	// decoders can spread their work over the same workers
+	CWorkerPool &WorkerPool();
+
+private:
+	CTextureStreamer( const CTextureStreamer &rhs ) = delete;
+	CTextureStreamer& operator = ( const CTextureStreamer &rhs ) = delete;
+
+	struct SUpload final
+	{
+		std::weak_ptr<CTexture> texture;
+
+		std::string name;
+
+		u64 ticket;
+
+		// the levels above get dropped right after the texture was swapped in
+		u8 firstMip { 0 };
+
+		std::unique_ptr<const SDecodedTexture> decodedTexture;
+
+		// the texture the images are uploaded to, until it replaces the placeholder
+		GLuint stagingGLID { 0 };
+
+		size_t nextUpload { 0 };
+	};
+
+	// the decoder is kept, so the texture can be streamed in again after its top mip levels were dropped
+	struct SResident final
+	{
+		std::weak_ptr<CTexture> texture;
+
+		std::string name;
+
+		TDecoder decoder;
+
+		// finest level the texture was needed at lately
+		u8	wantedMip	{ 0 };
+		u64	wantedFrame	{ 0 };
+	};
+
+	void Submit( const std::shared_ptr<CTexture> &texture, const std::string &name, TDecoder decoder, const u8 firstMip );
+
+	void Upload( const u64 budget );
+
+	void ManageResidency();
+
+	bool Discard( const SUpload &upload, const std::shared_ptr<CTexture> &texture ) const;
+
+	static GLuint CreateStorage( const SDecodedTexture &decodedTexture );
+
+	static void FillMipChain( CTexture &texture, const SDecodedTexture &decodedTexture );
+
+	// replaces the texture with one which starts at the given level of its mip chain
+	static void DropMips( CTexture &texture, const u8 mip );
+
+	u64 UploadImage( const GLuint GLID, const GLenum target, const GLint level, const GLint layer, const std::shared_ptr<const CImage> &image );
+	u64 UploadCompressedLevel( const GLuint GLID, const GLint level, const CCompressedImage &compressedImage );
+
+	// copies the data into the next buffer of the ring and returns what has to be passed as pointer to the upload
+	const void *Stage( const std::byte *data, const GLsizeiptr byteCount );
+
+	static constexpr u8 PixelBufferRingSize { 3 };
+
+	// how long the finest requested level of a texture is still wanted after it was drawn with it the last time
+	static constexpr u64 UsageFrames { 120 };
+
+	// in bytes
+	const u64 m_uploadBudget;
+	const u64 m_memoryBudget;
+
+	u64 m_frame { 0 };
+
+	SStatistics m_statistics;
+
+	std::unordered_map<const CTexture *, SResident> m_residents;
+
+	std::array<GLuint, PixelBufferRingSize>		m_pixelBuffers;
+	std::array<GLsizeiptr, PixelBufferRingSize>	m_pixelBufferSizes;
+
+	u8 m_nextPixelBuffer { 0 };
+
+	u64 m_nextTicket { 0 };
+
+	// only the upload of the newest request for a texture is allowed to replace it, older ones get discarded
+	std::unordered_map<const CTexture *, u64> m_latestTickets;
+
+	u32 m_pendingTextures { 0 };
+
+	std::deque<SUpload> m_uploads;
+
+	// filled by the workers
+	std::mutex				m_decodedMutex;
+	std::condition_variable	m_decodedCondition;
+	std::deque<SUpload>		m_decoded;
+
+	// destroyed first, so no worker is still running when the rest goes away
+	CWorkerPool m_workerPool;
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include "TextureDecodeBenchmark.hpp"
+
+#include <chrono>
+#include <limits>
+#include <vector>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/system/CWorkerPool.hpp"
+
+#include "src/renderer/texture/CTextureLoader.hpp"
+
+namespace TextureDecodeBenchmark
+{
+	void Run( const CFileSystem &filesystem, const fs::path &directory, const u8 maxThreads )
+	{
+		std::vector<fs::path> texturePaths;
+
+		for( const auto &path : filesystem.ListFiles( directory ) )
+		{
+			const std::string fileExtensionString = path.extension().generic_string();
+
+			if( ( fileExtensionString == std::string( ".cub" ) ) || ( fileExtensionString == std::string( ".arr" ) ) )
+			{
+				texturePaths.push_back( path );
+			}
+		}
+
+		if( texturePaths.empty() )
+		{
+			logWARNING( "there are no cubemaps or array textures in '{0}'", directory.generic_string() );
+			return;
+		}
+
+		// there is no GL context, so nothing gets scaled down
+		const u32 maxSize = std::numeric_limits<u32>::max();
+
+		// the times with a single thread are the baseline for the speedup
+		std::vector<f32> singleThreadedTimes( texturePaths.size(), 0.0 );
+
+		for( u16 threadCount = 1; threadCount <= maxThreads; threadCount++ )
+		{
+			// the calling thread decodes too
+			CWorkerPool workerPool( "texture decode benchmark", static_cast<u8>( threadCount - 1 ) );
+
+			f32 totalTime { 0.0 };
+			f32 totalSingleThreadedTime { 0.0 };
+
+			for( size_t i = 0; i < texturePaths.size(); i++ )
+			{
+				const auto &path = texturePaths[ i ];
+
+				const auto start = std::chrono::steady_clock::now();
+
+				const auto decodedTexture = ( path.extension().generic_string() == std::string( ".cub" ) ) ? CTextureLoader::DecodeCubeFile( filesystem, workerPool, path, maxSize ) : CTextureLoader::Decode2DArrayFile( filesystem, workerPool, path, maxSize );
+
+				const f32 time = std::chrono::duration<f32, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+				if( !decodedTexture )
+				{
+					logWARNING( "decoding '{0}' failed", path.generic_string() );
+					continue;
+				}
+
+				if( 1 == threadCount )
+				{
+					singleThreadedTimes[ i ] = time;
+				}
+
+				totalTime += time;
+				totalSingleThreadedTime += singleThreadedTimes[ i ];
+
+				logINFO( "{0:2} threads : {1:8.2f} ms ( {2:5.2f}x ) for {3} images of '{4}'", threadCount, time, singleThreadedTimes[ i ] / time, decodedTexture->images.size(), path.generic_string() );
+			}
+
+			logINFO( "{0:2} threads : {1:8.2f} ms ( {2:5.2f}x ) in total", threadCount, totalTime, totalSingleThreadedTime / totalTime );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "src/core/Types.hpp"
+
+#include "src/system/CFileSystem.hpp"
+
+namespace TextureDecodeBenchmark
+{
+	// decodes every cubemap and array texture below the directory with 1 up to maxThreads threads and logs the timings
+	void Run( const CFileSystem &filesystem, const fs::path &directory, const u8 maxThreads );
+}
\ No newline at end of file
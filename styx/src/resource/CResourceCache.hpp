@@ -1,12 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <memory>
-#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "src/core/Types.hpp"
 
+#include "src/helper/CFlatHashMap.hpp"
+
 #include "src/resource/CResourceCacheBase.hpp"
+#include "src/resource/CResourceHandle.hpp"
+#include "src/resource/CResourceId.hpp"
+#include "src/resource/CResourceLoadQueue.hpp"
 
 #include "src/logger/CLogger.hpp"
 
@@ -31,14 +39,14 @@ protected:
 	virtual ~CResourceCache()
 	{
 		#ifdef STYX_DEBUG
-		if( !m_resources.empty() )
+		if( !m_resources.Empty() )
 		{
-			logERROR( "there are still '{0}' resources in '{1}' cache", m_resources.size(), m_name );
+			logERROR( "there are still '{0}' resources in '{1}' cache", m_resources.Size(), m_name );
 
-			for( const auto & [ path, resourceInfo ] : m_resources )
+			m_resources.ForEach( []( const u64, const sResourceInfo &resourceInfo )
 			{
-				logWARNING( "\t{0}: {1}", path, resourceInfo.resource.use_count() - 1 );
-			}
+				logWARNING( "\t{0}: {1}", resourceInfo.path, resourceInfo.resource.use_count() - 1 );
+			} );
 		}
 		#endif
 	}
@@ -46,77 +54,358 @@ protected:
 public:
 	[[nodiscard]] const std::shared_ptr<const T> Get( const std::string &path )
 	{
-		const auto it = m_resources.find( path );
-		
-		if( std::end( m_resources ) != it )
+		return( Get( CResourceId( path ), path ) );
+	}
+
+	// the id has to be the one of the path, it only saves hashing the path again
+	[[nodiscard]] const std::shared_ptr<const T> Get( const CResourceId &id, const std::string &path )
+	{
+		if( const auto resourceInfo = m_resources.Find( id.Hash() ) )
 		{
-			return( it->second.resource );
+			#ifdef STYX_DEBUG
+				if( resourceInfo->path != path )
+				{
+					logERROR( "the ids of '{0}' and '{1}' collide in '{2}' cache", resourceInfo->path, path, m_name );
+				}
+			#endif
+
+			resourceInfo->lastUsed = m_sweepPass;
+
+			// the caller expects it to be loaded, so it doesn't wait for the asynchronous load any longer
+			if( 0 != resourceInfo->loadTicket )
+			{
+				resourceInfo->loadTicket = 0;
+
+				// loading may add resources to this cache
+				const auto resource = resourceInfo->resource;
+
+				resource->Reset();
+
+				const CResourceDependencies::CLoadScope loadScope( m_dependencies, { this, id.Hash() } );
+
+				Load( resource, path );
+
+				return( resource );
+			}
+
+			return( resourceInfo->resource );
 		}
 
 		auto newResource = std::make_shared<T>();
 
-		Load( newResource, path );
+		{
+			const CResourceDependencies::CLoadScope loadScope( m_dependencies, { this, id.Hash() } );
 
-		auto &resourceInfo = m_resources[ path ];
+			Load( newResource, path );
+		}
 
-		resourceInfo.resource = newResource;
-		resourceInfo.mtime    = GetMtime( path );
+		auto &resourceInfo = m_resources[ id.Hash() ];
+
+		resourceInfo.resource	= newResource;
+		resourceInfo.path		= path;
+		resourceInfo.mtime		= GetMtime( path );
+		resourceInfo.lastUsed	= m_sweepPass;
 
 		return( newResource );
 	}
 
+	/**	Returns right away with the placeholder, the decoding runs on a worker and the rest of the loading on the main thread.
+		The resource is loaded in place, so everybody who got it sees the loaded one afterwards.
+		A path which is already loaded or loading is shared, so it gets only loaded once.
+	*/
+	[[nodiscard]] CResourceHandle<T> GetAsync( const CResourceId &id, const std::string &path, CResourceLoadQueue &loadQueue )
+	{
+		if( LoadsInBackground() )
+		{
+			return( CResourceHandle<T>( id, Get( id, path ) ) );
+		}
+
+		// a pending load is shared as well, without waiting for it like Get does
+		if( const auto resourceInfo = m_resources.Find( id.Hash() ) )
+		{
+			resourceInfo->lastUsed = m_sweepPass;
+
+			return( CResourceHandle<T>( id, resourceInfo->resource ) );
+		}
+
+		auto newResource = std::make_shared<T>();
+
+		LoadPlaceholder( newResource, path );
+
+		const u64 loadTicket = ++m_lastLoadTicket;
+
+		auto &resourceInfo = m_resources[ id.Hash() ];
+
+		resourceInfo.resource	= newResource;
+		resourceInfo.path		= path;
+		resourceInfo.mtime		= GetMtime( path );
+		resourceInfo.loadTicket	= loadTicket;
+		resourceInfo.lastUsed	= m_sweepPass;
+
+		loadQueue.Submit( [ this, id, path, loadTicket ]() -> CResourceLoadQueue::TCompletion
+		{
+			TFinisher finisher = Decode( path );
+
+			return( [ this, id, loadTicket, finisher ] { FinishLoad( id, loadTicket, finisher ); } );
+		} );
+
+		return( CResourceHandle<T>( id, newResource ) );
+	}
+
+	[[nodiscard]] CResourceHandle<T> Handle( const std::string &path )
+	{
+		const CResourceId id( path );
+
+		return( CResourceHandle<T>( id, Get( id, path ) ) );
+	}
+
+	// only resources which are already loaded are found, nullptr otherwise
+	[[nodiscard]] const std::shared_ptr<const T> Find( const CResourceId &id ) const
+	{
+		if( const auto resourceInfo = m_resources.Find( id.Hash() ) )
+		{
+			return( resourceInfo->resource );
+		}
+
+		return( nullptr );
+	}
+
+	[[nodiscard]] std::shared_ptr<const void> Preload( const std::string &path, CResourceLoadQueue &loadQueue ) override final
+	{
+		return( GetAsync( CResourceId( path ), path, loadQueue ).Get() );
+	}
+
+	[[nodiscard]] bool IsLoading( const CResourceId &id ) const override final
+	{
+		const auto resourceInfo = m_resources.Find( id.Hash() );
+
+		return( ( nullptr != resourceInfo ) && ( 0 != resourceInfo->loadTicket ) );
+	}
+
+	[[nodiscard]] SMemoryUsage MemoryUsage() const override final
+	{
+		SMemoryUsage memoryUsage;
+
+		m_resources.ForEach( [ &memoryUsage ]( const u64, const sResourceInfo &resourceInfo )
+		{
+			memoryUsage += resourceInfo.resource->MemoryUsage();
+		} );
+
+		return( memoryUsage );
+	}
+
+	[[nodiscard]] std::vector<SResourceMemoryUsage> ResourceMemoryUsage() const override final
+	{
+		std::vector<SResourceMemoryUsage> resourceMemoryUsage;
+
+		resourceMemoryUsage.reserve( m_resources.Size() );
+
+		m_resources.ForEach( [ &resourceMemoryUsage ]( const u64, const sResourceInfo &resourceInfo )
+		{
+			resourceMemoryUsage.push_back( { resourceInfo.path, resourceInfo.resource->MemoryUsage(), resourceInfo.resource.unique() } );
+		} );
+
+		return( resourceMemoryUsage );
+	}
+
+	[[nodiscard]] SResourceUse ResourceUse( const u64 id ) const override final
+	{
+		if( const auto resourceInfo = m_resources.Find( id ) )
+		{
+			return( SResourceUse { resourceInfo->resource->MemoryUsage().Total(), resourceInfo->resource.use_count() - 1 } );
+		}
+
+		return {};
+	}
+
 	void CollectGarbage() override final
 	{
-		for( auto it = std::cbegin( m_resources ); it != std::cend( m_resources ); )
+		m_resources.EraseIf( []( const u64, const sResourceInfo &resourceInfo ) { return( resourceInfo.resource.unique() ); } );
+
+		m_unusedResources.clear();
+		m_unusedSize	= 0;
+		m_sweepSlot		= 0;
+	}
+
+	void SweepGarbage( const size_t slots ) override final
+	{
+		m_sweepSlot = m_resources.ForEachInSlots( m_sweepSlot, slots, [ this ]( const u64 key, sResourceInfo &resourceInfo )
 		{
-			if( it->second.resource.unique() )
+			if( resourceInfo.resource.unique() )
 			{
-				m_resources.erase( it++ );
+				// what only it keeps alive in the other caches would be unused without it, so a small resource can't hold on to large ones beyond the budget
+				const u64 size = resourceInfo.resource->MemoryUsage().Total() + ( m_dependencies ? m_dependencies->PinnedSize( { this, key } ) : 0 );
+
+				m_unusedResources.push_back( { key, resourceInfo.lastUsed, size } );
+
+				m_unusedSize += size;
 			}
 			else
 			{
-				++it;
+				resourceInfo.lastUsed = m_sweepPass;
 			}
+		} );
+
+		// the pass is not complete yet
+		if( 0 != m_sweepSlot )
+		{
+			return;
 		}
+
+		if( m_unusedSize > m_budget )
+		{
+			std::sort( std::begin( m_unusedResources ), std::end( m_unusedResources ), []( const sUnusedResource &a, const sUnusedResource &b ) { return( a.lastUsed < b.lastUsed ); } );
+
+			for( const auto &unusedResource : m_unusedResources )
+			{
+				if( m_unusedSize <= m_budget )
+				{
+					break;
+				}
+
+				// it may have been requested again since it was looked at
+				if( const auto resourceInfo = m_resources.Find( unusedResource.key ); resourceInfo && resourceInfo->resource.unique() )
+				{
+					m_resources.Erase( unusedResource.key );
+				}
+
+				m_unusedSize -= unusedResource.size;
+			}
+		}
+
+		m_unusedResources.clear();
+		m_unusedSize = 0;
+
+		++m_sweepPass;
 	}
 
-	void Reload() override final
+	[[nodiscard]] std::vector<u64> Modified() override final
 	{
-		logINFO( "reloading cache: {0}", m_name );
+		std::vector<u64> modifiedResources;
 
-		for( auto & [ path, resourceInfo ] : m_resources )
+		m_resources.ForEach( [ this, &modifiedResources ]( const u64 key, const sResourceInfo &resourceInfo )
 		{
-			const auto currentMtime = GetMtime( path );
-			if( currentMtime > resourceInfo.mtime )
+			if( GetMtime( resourceInfo.path ) > resourceInfo.mtime )
 			{
-				logINFO( "\t{0}", path );
+				modifiedResources.push_back( key );
+			}
+		} );
 
-				resourceInfo.resource->Reset();
+		return( modifiedResources );
+	}
 
-				Load( resourceInfo.resource, path );
+	bool Reload( const u64 id ) override final
+	{
+		const auto resourceInfo = m_resources.Find( id );
 
-				resourceInfo.mtime = currentMtime;
-			}
+		if( nullptr == resourceInfo )
+		{
+			return( false );
 		}
+
+		logINFO( "reloading {0}: {1}", m_name, resourceInfo->path );
+
+		// a pending asynchronous load would bring back the old state
+		resourceInfo->mtime			= GetMtime( resourceInfo->path );
+		resourceInfo->loadTicket	= 0;
+
+		// loading may add resources to this cache
+		const auto resource	= resourceInfo->resource;
+		const auto path		= resourceInfo->path;
+
+		resource->Reset();
+
+		const CResourceDependencies::CLoadScope loadScope( m_dependencies, { this, id } );
+
+		Load( resource, path );
+
+		return( true );
 	}
 
 
 protected:
+	// finishes loading on the main thread what Decode started, the resource was reset before
+	using TFinisher = std::function<void( const std::shared_ptr<T> &resource )>;
+
 	const CFileSystem &m_filesystem;
 
 private:
 	virtual void Load( const std::shared_ptr<T> &resource, const std::string &path ) const = 0;
+
+	// the thread safe stage of loading, it runs on a worker so it must neither touch GL or AL nor any resources
+	virtual TFinisher Decode( const std::string &path ) const
+	{
+		// without a split everything is loaded on the main thread
+		return( [ this, path ]( const std::shared_ptr<T> &resource ) { Load( resource, path ); } );
+	}
+
+	// what is shown until an asynchronous load is finished, the default constructed resource if not overridden
+	virtual void LoadPlaceholder( [[maybe_unused]] const std::shared_ptr<T> &resource, [[maybe_unused]] const std::string &path ) const
+	{
+	}
+
+	// the loader already streams on its own, so GetAsync just loads like Get
+	virtual bool LoadsInBackground() const
+	{
+		return( false );
+	}
+
+	void FinishLoad( const CResourceId &id, const u64 loadTicket, const TFinisher &finisher )
+	{
+		const auto resourceInfo = m_resources.Find( id.Hash() );
+
+		// it was collected in the meantime or loaded by Get or Reload
+		if( ( nullptr == resourceInfo ) || ( resourceInfo->loadTicket != loadTicket ) )
+		{
+			return;
+		}
+
+		resourceInfo->loadTicket = 0;
+
+		// the finisher may add resources to this cache
+		const auto resource = resourceInfo->resource;
+
+		resource->Reset();
+
+		const CResourceDependencies::CLoadScope loadScope( m_dependencies, { this, id.Hash() } );
+
+		finisher( resource );
+	}
 	
 	virtual s64 GetMtime( const std::string &path ) final
 	{
-		return( m_filesystem.GetLastModTime( path ) );
+		// all variants of a resource share the file and so its modification time
+		return( m_filesystem.GetLastModTime( path.substr( 0, path.find( VariantSeparator ) ) ) );
 	}
 	
 	struct sResourceInfo
 	{
 		std::shared_ptr<T>	resource;
+		std::string			path;
 		s64					mtime = 0;
+		// not 0 while an asynchronous load is pending, only the latest one may finish
+		u64					loadTicket = 0;
+		// the last sweep pass during which it was used or requested
+		u64					lastUsed = 0;
+	};
+
+	struct sUnusedResource
+	{
+		u64	key;
+		u64	lastUsed;
+		u64	size;
 	};
 
-	std::map<std::string, sResourceInfo> m_resources;
+	// keyed by the hashes of the paths
+	CFlatHashMap<sResourceInfo> m_resources;
+
+	u64 m_lastLoadTicket { 0 };
+
+	// the passes of the sweep are the clock of the least recently used order
+	u64		m_sweepPass { 0 };
+	size_t	m_sweepSlot { 0 };
+
+	// what the current pass found so far
+	std::vector<sUnusedResource>	m_unusedResources;
+	u64								m_unusedSize { 0 };
 };
@@ -17,3 +17,18 @@ const std::string & CResourceCacheBase::Name() const
 {
 	return( m_name );
 }
+
+void CResourceCacheBase::Budget( const u64 budget )
+{
+	m_budget = budget;
+}
+
+u64 CResourceCacheBase::Budget() const
+{
+	return( m_budget );
+}
+
+void CResourceCacheBase::Dependencies( CResourceDependencies *dependencies )
+{
+	m_dependencies = dependencies;
+}
@@ -2,6 +2,15 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+
+#include "src/core/Types.hpp"
+#include "src/core/SMemoryUsage.hpp"
+
+#include "src/resource/CResourceDependencies.hpp"
+#include "src/resource/CResourceId.hpp"
+
+class CResourceLoadQueue;
 
 class CResourceCacheBase
 {
@@ -14,11 +23,63 @@ protected:
 	virtual ~CResourceCacheBase();
 
 public:
+	// drops every resource which is not used anymore right away
 	virtual void CollectGarbage() = 0;
-	virtual void Reload() = 0;
+
+	// looks at the given number of slots, once a pass over the cache is complete the least recently used unused resources are dropped until the budget is met
+	virtual void SweepGarbage( const size_t slots ) = 0;
+
+	// the resources whose files were modified after they were loaded
+	[[nodiscard]] virtual std::vector<u64> Modified() = 0;
+
+	// resets the resource and loads it again in place, false if it is not in the cache anymore
+	virtual bool Reload( const u64 id ) = 0;
+
+	// starts loading the resource like GetAsync, the returned pointer keeps it alive
+	[[nodiscard]] virtual std::shared_ptr<const void> Preload( const std::string &path, CResourceLoadQueue &loadQueue ) = 0;
+
+	// whether an asynchronous load of the resource is still pending
+	[[nodiscard]] virtual bool IsLoading( const CResourceId &id ) const = 0;
+
+	struct SResourceMemoryUsage final
+	{
+		std::string		path;
+		SMemoryUsage	memoryUsage;
+		// whether it is only kept by the cache
+		bool			unused;
+	};
+
+	// of every resource in the cache, including the unused ones which are kept within the budget
+	[[nodiscard]] virtual SMemoryUsage MemoryUsage() const = 0;
+
+	[[nodiscard]] virtual std::vector<SResourceMemoryUsage> ResourceMemoryUsage() const = 0;
+
+	struct SResourceUse final
+	{
+		u64		size	{ 0 };
+		// besides the cache
+		long	owners	{ 0 };
+	};
+
+	// of a single resource, empty if it is not in the cache
+	[[nodiscard]] virtual SResourceUse ResourceUse( const u64 id ) const = 0;
 
 	const std::string &Name() const;
 
+	// in bytes of unused resources which are kept in case they are needed again
+	void Budget( const u64 budget );
+	[[nodiscard]] u64 Budget() const;
+
+	// where the loads of the cache are recorded
+	void Dependencies( CResourceDependencies *dependencies );
+
+	// everything after this in an id selects a variant of the resource file in front of it
+	static const char VariantSeparator = '#';
+
 protected:
 	const std::string m_name;
+
+	u64 m_budget { 0 };
+
+	CResourceDependencies *m_dependencies { nullptr };
 };
@@ -0,0 +1,242 @@
+#include "CResourceDependencies.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+#include "src/resource/CResourceCacheBase.hpp"
+
+CResourceDependencies::CLoadScope::CLoadScope( CResourceDependencies *dependencies, const SNode &node ) :
+	m_dependencies { dependencies }
+{
+	if( m_dependencies )
+	{
+		m_dependencies->BeginLoad( node );
+	}
+}
+
+CResourceDependencies::CLoadScope::~CLoadScope()
+{
+	if( m_dependencies )
+	{
+		m_dependencies->EndLoad();
+	}
+}
+
+void CResourceDependencies::Requested( const SNode &node, const std::string &path )
+{
+	AddUnique( m_files[ path.substr( 0, path.find( CResourceCacheBase::VariantSeparator ) ) ], node );
+
+	if( !m_loading.empty() && !( m_loading.back() == node ) )
+	{
+		AddEdge( node, m_loading.back() );
+	}
+}
+
+std::vector<CResourceDependencies::SNode> CResourceDependencies::FromFile( const std::string &file ) const
+{
+	const auto it = m_files.find( file );
+
+	return( ( std::end( m_files ) != it ) ? it->second : TNodes() );
+}
+
+std::vector<CResourceDependencies::SNode> CResourceDependencies::WithDependents( const std::vector<SNode> &nodes ) const
+{
+	// everything which is reachable from the nodes
+	std::unordered_set<SNode, SNodeHash> affected;
+
+	TNodes open = nodes;
+
+	while( !open.empty() )
+	{
+		const SNode node = open.back();
+		open.pop_back();
+
+		if( !affected.insert( node ).second )
+		{
+			continue;
+		}
+
+		if( const auto it = m_dependents.find( node ); std::end( m_dependents ) != it )
+		{
+			open.insert( std::end( open ), std::cbegin( it->second ), std::cend( it->second ) );
+		}
+	}
+
+	// a node is ready once all of its affected dependencies are ordered
+	std::unordered_map<SNode, size_t, SNodeHash> waitingFor;
+
+	for( const auto &node : affected )
+	{
+		size_t count { 0 };
+
+		if( const auto it = m_dependencies.find( node ); std::end( m_dependencies ) != it )
+		{
+			count = std::count_if( std::cbegin( it->second ), std::cend( it->second ), [ &affected ]( const SNode &dependency ) { return( affected.count( dependency ) > 0 ); } );
+		}
+
+		waitingFor[ node ] = count;
+
+		if( 0 == count )
+		{
+			open.push_back( node );
+		}
+	}
+
+	TNodes ordered;
+
+	ordered.reserve( affected.size() );
+
+	while( !open.empty() )
+	{
+		const SNode node = open.back();
+		open.pop_back();
+
+		ordered.push_back( node );
+
+		if( const auto it = m_dependents.find( node ); std::end( m_dependents ) != it )
+		{
+			for( const auto &dependent : it->second )
+			{
+				if( 0 == --waitingFor[ dependent ] )
+				{
+					open.push_back( dependent );
+				}
+			}
+		}
+	}
+
+	// nodes in a cycle are never ready, they are appended so they get reloaded nevertheless
+	if( ordered.size() < affected.size() )
+	{
+		for( const auto & [ node, count ] : waitingFor )
+		{
+			if( count > 0 )
+			{
+				ordered.push_back( node );
+			}
+		}
+	}
+
+	return( ordered );
+}
+
+u64 CResourceDependencies::PinnedSize( const SNode &node ) const
+{
+	std::unordered_set<SNode, SNodeHash> visited { node };
+
+	TNodes open { node };
+
+	u64 size { 0 };
+
+	while( !open.empty() )
+	{
+		const SNode pinning = open.back();
+		open.pop_back();
+
+		const auto it = m_dependencies.find( pinning );
+
+		if( std::end( m_dependencies ) == it )
+		{
+			continue;
+		}
+
+		for( const auto &dependency : it->second )
+		{
+			if( !visited.insert( dependency ).second )
+			{
+				continue;
+			}
+
+			// dropping the node would leave the dependency to its cache alone
+			if( const auto resourceUse = dependency.cache->ResourceUse( dependency.id ); 1 == resourceUse.owners )
+			{
+				size += resourceUse.size;
+
+				open.push_back( dependency );
+			}
+		}
+	}
+
+	return( size );
+}
+
+void CResourceDependencies::Remove( const CResourceCacheBase *cache )
+{
+	const auto isOfCache = [ cache ]( const SNode &node ) { return( node.cache == cache ); };
+
+	for( auto it = std::begin( m_dependencies ); it != std::end( m_dependencies ); )
+	{
+		it = isOfCache( it->first ) ? m_dependencies.erase( it ) : std::next( it );
+	}
+
+	for( auto it = std::begin( m_dependents ); it != std::end( m_dependents ); )
+	{
+		it = isOfCache( it->first ) ? m_dependents.erase( it ) : std::next( it );
+	}
+
+	for( auto &nodeMap : { &m_dependencies, &m_dependents } )
+	{
+		for( auto & [ node, edges ] : *nodeMap )
+		{
+			edges.erase( std::remove_if( std::begin( edges ), std::end( edges ), isOfCache ), std::end( edges ) );
+		}
+	}
+
+	for( auto & [ file, fileNodes ] : m_files )
+	{
+		fileNodes.erase( std::remove_if( std::begin( fileNodes ), std::end( fileNodes ), isOfCache ), std::end( fileNodes ) );
+	}
+}
+
+void CResourceDependencies::BeginLoad( const SNode &node )
+{
+	// it may depend on something else after it was changed
+	RemoveDependencies( node );
+
+	m_loading.push_back( node );
+}
+
+void CResourceDependencies::EndLoad()
+{
+	m_loading.pop_back();
+}
+
+void CResourceDependencies::AddEdge( const SNode &dependency, const SNode &dependent )
+{
+	AddUnique( m_dependencies[ dependent ], dependency );
+	AddUnique( m_dependents[ dependency ], dependent );
+}
+
+void CResourceDependencies::RemoveDependencies( const SNode &dependent )
+{
+	const auto it = m_dependencies.find( dependent );
+
+	if( std::end( m_dependencies ) == it )
+	{
+		return;
+	}
+
+	for( const auto &dependency : it->second )
+	{
+		if( const auto itDependents = m_dependents.find( dependency ); std::end( m_dependents ) != itDependents )
+		{
+			EraseNode( itDependents->second, dependent );
+		}
+	}
+
+	m_dependencies.erase( it );
+}
+
+void CResourceDependencies::AddUnique( TNodes &nodes, const SNode &node )
+{
+	if( std::end( nodes ) == std::find( std::begin( nodes ), std::end( nodes ), node ) )
+	{
+		nodes.push_back( node );
+	}
+}
+
+void CResourceDependencies::EraseNode( TNodes &nodes, const SNode &node )
+{
+	nodes.erase( std::remove( std::begin( nodes ), std::end( nodes ), node ), std::end( nodes ) );
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/core/Types.hpp"
+
+class CResourceCacheBase;
+
+/**
+ * Which resources were requested while another one was loading, like the shader program of a material and the shaders of the program.
+ * The caches tell when they load a resource and CResources tells about every request, so the loaders don't have to record anything themselves.
+ * Everything has to be called by the main thread.
+ */
+class CResourceDependencies final
+{
+public:
+	struct SNode final
+	{
+		CResourceCacheBase	*cache;
+		u64					id;
+
+		bool operator == ( const SNode &rhs ) const
+		{
+			return( ( cache == rhs.cache ) && ( id == rhs.id ) );
+		}
+	};
+
+	// whatever is requested while the scope exists is a dependency of the node, the previous dependencies are forgotten
+	class CLoadScope final
+	{
+	public:
+		CLoadScope( CResourceDependencies *dependencies, const SNode &node );
+		~CLoadScope();
+
+	private:
+		CLoadScope( const CLoadScope &rhs ) = delete;
+		CLoadScope& operator = ( const CLoadScope &rhs ) = delete;
+
+		CResourceDependencies *m_dependencies;
+	};
+
+	// the path may contain a variant, the node is known by the file in front of it
+	void Requested( const SNode &node, const std::string &path );
+
+	// the nodes which were loaded from the file
+	[[nodiscard]] std::vector<SNode> FromFile( const std::string &file ) const;
+
+	// the nodes and everything which depends on them, ordered so that every node comes after its dependencies
+	[[nodiscard]] std::vector<SNode> WithDependents( const std::vector<SNode> &nodes ) const;
+
+	// of the dependencies which are kept alive by nothing but the node or the dependencies it keeps alive itself
+	[[nodiscard]] u64 PinnedSize( const SNode &node ) const;
+
+	// has to be called before the cache is removed
+	void Remove( const CResourceCacheBase *cache );
+
+private:
+	struct SNodeHash final
+	{
+		size_t operator()( const SNode &node ) const
+		{
+			// the id already is a hash, the caches only have to be told apart
+			return( static_cast<size_t>( node.id ) ^ std::hash<const void*>()( node.cache ) );
+		}
+	};
+
+	using TNodes = std::vector<SNode>;
+
+	// the nodes which are loading right now, the innermost last
+	TNodes m_loading;
+
+	std::unordered_map<SNode, TNodes, SNodeHash> m_dependencies;
+	std::unordered_map<SNode, TNodes, SNodeHash> m_dependents;
+
+	std::unordered_map<std::string, TNodes> m_files;
+
+	void BeginLoad( const SNode &node );
+	void EndLoad();
+
+	void AddEdge( const SNode &dependency, const SNode &dependent );
+	void RemoveDependencies( const SNode &dependent );
+
+	static void AddUnique( TNodes &nodes, const SNode &node );
+	static void EraseNode( TNodes &nodes, const SNode &node );
+};
\ No newline at end of file
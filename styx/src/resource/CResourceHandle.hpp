@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+
+#include "src/resource/CResourceId.hpp"
+
+template<typename T>
+class CResourceCache;
+
+/**
+ * A typed reference to a resource which is resolved without any lookup.
+ * Reloading a resource resets and loads the same object again, so a stored handle always points to its current state.
+ * Like every other reference it keeps the resource from being collected.
+ */
+template<typename T>
+class CResourceHandle final
+{
+	friend class CResourceCache<T>;
+
+public:
+	CResourceHandle() = default;
+
+	[[nodiscard]] const CResourceId &Id() const
+	{
+		return( m_id );
+	}
+
+	[[nodiscard]] const std::shared_ptr<const T> &Get() const
+	{
+		return( m_resource );
+	}
+
+	const T *operator -> () const
+	{
+		return( m_resource.get() );
+	}
+
+	explicit operator bool() const
+	{
+		return( static_cast<bool>( m_resource ) );
+	}
+
+	bool operator == ( const CResourceHandle &rhs ) const
+	{
+		return( m_id == rhs.m_id );
+	}
+
+	bool operator != ( const CResourceHandle &rhs ) const
+	{
+		return( m_id != rhs.m_id );
+	}
+
+private:
+	CResourceHandle( const CResourceId &id, std::shared_ptr<const T> resource ) :
+		m_id { id },
+		m_resource { std::move( resource ) }
+	{}
+
+	CResourceId					m_id;
+	std::shared_ptr<const T>	m_resource;
+};
\ No newline at end of file
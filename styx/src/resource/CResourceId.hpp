@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string_view>
+
+#include "src/core/Types.hpp"
+
+#include "src/helper/Hash.hpp"
+
+/**
+ * The hash of the path of a resource, variant included.
+ * It is computed once, at compile time for literal paths, so looking a resource up never has to compare strings.
+ */
+class CResourceId final
+{
+public:
+	constexpr CResourceId() = default;
+
+	constexpr explicit CResourceId( const std::string_view path ) :
+		m_hash { Hash::FNV1a( path ) }
+	{}
+
+	[[nodiscard]] constexpr u64 Hash() const
+	{
+		return( m_hash );
+	}
+
+	constexpr bool operator == ( const CResourceId &rhs ) const
+	{
+		return( m_hash == rhs.m_hash );
+	}
+
+	constexpr bool operator != ( const CResourceId &rhs ) const
+	{
+		return( m_hash != rhs.m_hash );
+	}
+
+private:
+	u64 m_hash { 0 };
+};
\ No newline at end of file
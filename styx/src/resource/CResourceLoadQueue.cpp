@@ -0,0 +1,89 @@
+#include "CResourceLoadQueue.hpp"
+
+#include "src/logger/CLogger.hpp"
+
+CResourceLoadQueue::CResourceLoadQueue() :
+	m_workerPool( "resource loading", CWorkerPool::DefaultWorkerCount() )
+{
+	logINFO( "resource load queue was initialized" );
+}
+
+CResourceLoadQueue::~CResourceLoadQueue()
+{
+	if( m_pending > 0 )
+	{
+		logWARNING( "resource load queue drops {0} pending loads", m_pending );
+	}
+
+	logINFO( "resource load queue is shutting down" );
+}
+
+void CResourceLoadQueue::Submit( TJob job )
+{
+	m_pending++;
+
+	m_workerPool.Submit( [ this, job = std::move( job ) ]
+	{
+		TCompletion completion;
+
+		try
+		{
+			completion = job();
+		}
+		catch( const std::exception &e )
+		{
+			logWARNING( "loading a resource failed: {0}", e.what() );
+		}
+
+		{
+			const std::lock_guard<std::mutex> lock( m_completedMutex );
+
+			m_completed.push_back( std::move( completion ) );
+		}
+
+		m_completedCondition.notify_one();
+	} );
+}
+
+void CResourceLoadQueue::Update()
+{
+	std::deque<TCompletion> completed;
+
+	{
+		const std::lock_guard<std::mutex> lock( m_completedMutex );
+
+		std::swap( completed, m_completed );
+	}
+
+	// completions may submit new jobs, so the lock isn't held while they run
+	for( const auto &completion : completed )
+	{
+		if( completion )
+		{
+			completion();
+		}
+
+		m_pending--;
+	}
+}
+
+void CResourceLoadQueue::Finish()
+{
+	Update();
+
+	while( m_pending > 0 )
+	{
+		{
+			std::unique_lock<std::mutex> lock( m_completedMutex );
+
+			m_completedCondition.wait( lock, [ this ] { return( !m_completed.empty() ); } );
+		}
+
+		Update();
+	}
+}
+
+u32 CResourceLoadQueue::Pending() const
+{
+	return( m_pending );
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "src/core/Types.hpp"
+
+#include "src/system/CWorkerPool.hpp"
+
+/**
+ * Runs the thread safe stage of loading resources on worker threads and hands what is left of it to the main thread.
+ * The completions run in Update(), so everything touching GL or AL stays on the main thread.
+ */
+class CResourceLoadQueue final
+{
+public:
+	// runs on the main thread
+	using TCompletion = std::function<void()>;
+
+	// runs on a worker and returns what has to be done on the main thread, which may be nothing
+	using TJob = std::function<TCompletion()>;
+
+	CResourceLoadQueue();
+	~CResourceLoadQueue();
+
+	void Submit( TJob job );
+
+	// runs the completions of all jobs which are done
+	void Update();
+
+	// blocks until every submitted job is completed
+	void Finish();
+
+	// jobs which are submitted but not completed yet
+	u32 Pending() const;
+
+private:
+	CResourceLoadQueue( const CResourceLoadQueue &rhs ) = delete;
+	CResourceLoadQueue& operator = ( const CResourceLoadQueue &rhs ) = delete;
+
+	std::atomic<u32> m_pending { 0 };
+
+	// filled by the workers
+	std::mutex					m_completedMutex;
+	std::condition_variable		m_completedCondition;
+	std::deque<TCompletion>		m_completed;
+
+	// destroyed first, so no worker is still running when the rest goes away
+	CWorkerPool m_workerPool;
+};
\ No newline at end of file
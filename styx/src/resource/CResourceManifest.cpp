@@ -0,0 +1,97 @@
+#include "CResourceManifest.hpp"
+
+#include <algorithm>
+
+#include "src/helper/Json.hpp"
+
+#include "src/logger/CLogger.hpp"
+
+using json = nlohmann::json;
+
+fs::path CResourceManifest::Path( const std::string &stateName )
+{
+	std::string fileName = stateName;
+
+	std::replace( std::begin( fileName ), std::end( fileName ), ' ', '_' );
+
+	return( Directory / ( fileName + ".json" ) );
+}
+
+CResourceManifest CResourceManifest::FromFile( const CFileSystem &filesystem, const fs::path &path )
+{
+	CResourceManifest manifest;
+
+	if( !filesystem.Exists( path ) )
+	{
+		return( manifest );
+	}
+
+	try
+	{
+		const json root = Json::Load( filesystem, path );
+
+		for( const auto & [ cacheName, ids ] : root.items() )
+		{
+			for( const auto &id : ids )
+			{
+				manifest.Add( cacheName, id.get<std::string>() );
+			}
+		}
+	}
+	catch( json::exception &e )
+	{
+		logWARNING( "failed to parse manifest '{0}' because of {1}", path.generic_string(), e.what() );
+		return( CResourceManifest() );
+	}
+
+	return( manifest );
+}
+
+bool CResourceManifest::Save( const CFileSystem &filesystem, const fs::path &path ) const
+{
+	if( !filesystem.Exists( path.parent_path() ) && !filesystem.MakeDir( path.parent_path() ) )
+	{
+		logWARNING( "couldn't create directory '{0}'", path.parent_path().generic_string() );
+		return( false );
+	}
+
+	json root = json::object();
+
+	for( const auto & [ cacheName, ids ] : m_entries )
+	{
+		root[ cacheName ] = ids;
+	}
+
+	const std::string text = root.dump( 4 );
+
+	const auto begin = reinterpret_cast<const std::byte*>( text.data() );
+
+	return( filesystem.SaveBufferToFile( CFileSystem::FileBuffer( begin, begin + text.size() ), path ) );
+}
+
+void CResourceManifest::Add( const std::string &cacheName, const std::string &id )
+{
+	m_entries[ cacheName ].insert( id );
+}
+
+const CResourceManifest::TEntries &CResourceManifest::Entries() const
+{
+	return( m_entries );
+}
+
+size_t CResourceManifest::Size() const
+{
+	size_t size { 0 };
+
+	for( const auto & [ cacheName, ids ] : m_entries )
+	{
+		size += ids.size();
+	}
+
+	return( size );
+}
+
+bool CResourceManifest::Empty() const
+{
+	return( m_entries.empty() );
+}
\ No newline at end of file
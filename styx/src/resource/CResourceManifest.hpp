@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+#include "src/system/CFileSystem.hpp"
+
+/**
+ * The resources a state needs, grouped by the names of the caches they live in.
+ * Stored as JSON, e.g. { "material": [ "materials/standard.mat" ], "texture": [ "textures/menu/title.png" ] }
+ */
+class CResourceManifest final
+{
+public:
+	using TEntries = std::map<std::string, std::set<std::string>>;
+
+	// where the manifest of the state with this name is stored
+	[[nodiscard]] static fs::path Path( const std::string &stateName );
+
+	// an empty manifest if the file doesn't exist or is broken
+	[[nodiscard]] static CResourceManifest FromFile( const CFileSystem &filesystem, const fs::path &path );
+
+	// the file is written into the write-dir, so it wins over the one in the assets
+	bool Save( const CFileSystem &filesystem, const fs::path &path ) const;
+
+	void Add( const std::string &cacheName, const std::string &id );
+
+	[[nodiscard]] const TEntries &Entries() const;
+
+	[[nodiscard]] size_t Size() const;
+
+	[[nodiscard]] bool Empty() const;
+
+	static inline const fs::path Directory { "manifests" };
+
+private:
+	TEntries m_entries;
+};
\ No newline at end of file
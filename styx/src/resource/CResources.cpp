@@ -14,12 +14,12 @@ CResources::~CResources()
 	logINFO( "resource cache manager is shutting down" );
 
 	#ifdef STYX_DEBUG
-	if( !m_resourceCacheMap.empty() )
+	if( !m_resourceCachesOrdered.empty() )
 	{
-		logWARNING( "there are still '{0}' registered caches", m_resourceCacheMap.size() );
-		for( const auto &cache : m_resourceCacheMap )
+		logWARNING( "there are still '{0}' registered caches", m_resourceCachesOrdered.size() );
+		for( const auto &cache : m_resourceCachesOrdered )
 		{
-			logDEBUG( "\t{0}", cache.second->Name() );
+			logDEBUG( "\t{0}", cache->Name() );
 		}
 	}
 	#endif
@@ -27,15 +27,28 @@ CResources::~CResources()
 
 void CResources::RemoveCache( const std::shared_ptr<CResourceCacheBase> &resourceCache )
 {
-	const auto itMap = std::find_if( std::cbegin( m_resourceCacheMap ), std::cend( m_resourceCacheMap ), [&] ( auto &x ) { return( x.second == resourceCache ); } );
+	// the pending loads of the cache must not outlive it
+	m_loadQueue.Finish();
 
-	if( itMap == std::cend( m_resourceCacheMap ) )
+	const auto itSlot = std::find( std::begin( m_resourceCaches ), std::end( m_resourceCaches ), resourceCache );
+
+	if( itSlot == std::end( m_resourceCaches ) )
 	{
 		logWARNING( "resource cache '{0}' not found", resourceCache->Name() )
 	}
 	else
 	{
-		m_resourceCacheMap.erase( itMap );
+		// preloaded resources of the cache must not outlive it either
+		for( auto & [ name, preloadedResources ] : m_preloads )
+		{
+			preloadedResources.erase( std::remove_if( std::begin( preloadedResources ), std::end( preloadedResources ), [ & ]( const auto &preloadedResource ) { return( preloadedResource.cache.lock() == resourceCache ); } ), std::end( preloadedResources ) );
+		}
+
+		m_dependencies.Remove( resourceCache.get() );
+
+		resourceCache->Dependencies( nullptr );
+
+		itSlot->reset();
 
 		const auto itVec = std::find_if( std::cbegin( m_resourceCachesOrdered ), std::cend( m_resourceCachesOrdered ), [ & ]( auto &x ) { return( x == resourceCache ); } );
 
@@ -43,6 +56,13 @@ void CResources::RemoveCache( const std::shared_ptr<CResourceCacheBase> &resourc
 	}
 }
 
+size_t CResources::NextTypeSlot()
+{
+	static std::atomic<size_t> typeSlotCount { 0 };
+
+	return( typeSlotCount++ );
+}
+
 void CResources::CollectGarbage()
 {
 	for( auto it = m_resourceCachesOrdered.rbegin(); it != m_resourceCachesOrdered.rend(); ++it )
@@ -51,11 +71,198 @@ void CResources::CollectGarbage()
 	}
 }
 
+void CResources::SweepGarbage()
+{
+	for( auto it = m_resourceCachesOrdered.rbegin(); it != m_resourceCachesOrdered.rend(); ++it )
+	{
+		(*it)->SweepGarbage( SweepSlots );
+	}
+}
+
+void CResources::SetCacheBudget( const u64 budget )
+{
+	m_cacheBudget = budget;
+
+	for( auto &resourceCache : m_resourceCachesOrdered )
+	{
+		resourceCache->Budget( budget );
+	}
+}
+
 
 void CResources::Reload()
 {
-	for( auto &resourceCache : m_resourceCachesOrdered )
+	std::vector<CResourceDependencies::SNode> nodes;
+
+	for( const auto &resourceCache : m_resourceCachesOrdered )
+	{
+		for( const u64 id : resourceCache->Modified() )
+		{
+			nodes.push_back( { resourceCache.get(), id } );
+		}
+	}
+
+	Reload( nodes );
+}
+
+void CResources::Reload( const std::vector<fs::path> &changedFiles )
+{
+	std::vector<CResourceDependencies::SNode> nodes;
+
+	for( const auto &changedFile : changedFiles )
+	{
+		const auto fileNodes = m_dependencies.FromFile( changedFile.generic_string() );
+
+		nodes.insert( std::end( nodes ), std::cbegin( fileNodes ), std::cend( fileNodes ) );
+	}
+
+	Reload( nodes );
+}
+
+void CResources::Reload( const std::vector<CResourceDependencies::SNode> &nodes )
+{
+	if( nodes.empty() )
+	{
+		return;
+	}
+
+	// the dependencies are reloaded first, so the dependents load with their new state
+	for( const auto &node : m_dependencies.WithDependents( nodes ) )
+	{
+		node.cache->Reload( node.id );
+	}
+}
+
+
+void CResources::Update()
+{
+	m_loadQueue.Update();
+}
+
+void CResources::FinishLoads()
+{
+	m_loadQueue.Finish();
+}
+
+u32 CResources::PendingLoads() const
+{
+	return( m_loadQueue.Pending() );
+}
+
+void CResources::StartRecording( const std::string &name )
+{
+	m_recordings[ name ] = CResourceManifest();
+}
+
+CResourceManifest CResources::StopRecording( const std::string &name )
+{
+	const auto it = m_recordings.find( name );
+
+	if( it == std::end( m_recordings ) )
+	{
+		logWARNING( "there is no recording for '{0}'", name );
+		return( CResourceManifest() );
+	}
+
+	CResourceManifest manifest = std::move( it->second );
+
+	m_recordings.erase( it );
+
+	return( manifest );
+}
+
+void CResources::Requested( CResourceCacheBase &cache, const CResourceId &resourceId, const std::string &id )
+{
+	m_dependencies.Requested( { &cache, resourceId.Hash() }, id );
+
+	for( auto & [ name, manifest ] : m_recordings )
+	{
+		manifest.Add( cache.Name(), id );
+	}
+}
+
+void CResources::Preload( const std::string &name, const CResourceManifest &manifest )
+{
+	std::vector<SPreloadedResource> preloadedResources;
+
+	preloadedResources.reserve( manifest.Size() );
+
+	for( const auto & [ cacheName, ids ] : manifest.Entries() )
 	{
-		resourceCache->Reload();
+		const auto itCache = std::find_if( std::cbegin( m_resourceCachesOrdered ), std::cend( m_resourceCachesOrdered ), [ &cacheName = cacheName ]( const auto &cache ) { return( cache->Name() == cacheName ); } );
+
+		if( itCache == std::cend( m_resourceCachesOrdered ) )
+		{
+			logWARNING( "preload '{0}' needs unknown resource cache '{1}'", name, cacheName );
+			continue;
+		}
+
+		const auto &cache = *itCache;
+
+		for( const auto &id : ids )
+		{
+			m_dependencies.Requested( { cache.get(), CResourceId( id ).Hash() }, id );
+
+			preloadedResources.push_back( { cache, CResourceId( id ), cache->Preload( id, m_loadQueue ) } );
+		}
 	}
+
+	logINFO( "preloading {0} resources for '{1}'", preloadedResources.size(), name );
+
+	m_preloads[ name ] = std::move( preloadedResources );
 }
+
+void CResources::ReleasePreload( const std::string &name )
+{
+	m_preloads.erase( name );
+}
+
+void CResources::ReleasePreloads()
+{
+	m_preloads.clear();
+}
+
+f16 CResources::PreloadProgress() const
+{
+	size_t total { 0 };
+	size_t loaded { 0 };
+
+	for( const auto & [ name, preloadedResources ] : m_preloads )
+	{
+		for( const auto &preloadedResource : preloadedResources )
+		{
+			const auto cache = preloadedResource.cache.lock();
+
+			if( !cache || !cache->IsLoading( preloadedResource.id ) )
+			{
+				++loaded;
+			}
+		}
+
+		total += preloadedResources.size();
+	}
+
+	if( 0 == total )
+	{
+		return( 1.0f );
+	}
+
+	return( static_cast<f16>( loaded ) / static_cast<f16>( total ) );
+}
+
+SMemoryUsage CResources::MemoryUsage() const
+{
+	SMemoryUsage memoryUsage;
+
+	for( const auto &resourceCache : m_resourceCachesOrdered )
+	{
+		memoryUsage += resourceCache->MemoryUsage();
+	}
+
+	return( memoryUsage );
+}
+
+const std::vector<std::shared_ptr<CResourceCacheBase>> &CResources::Caches() const
+{
+	return( m_resourceCachesOrdered );
+}
\ No newline at end of file
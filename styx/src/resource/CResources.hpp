@@ -1,13 +1,13 @@
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <map>
 #include <vector>
 
-#include <typeindex>
-
 #include <memory>
 
 #include "src/resource/CResourceCache.hpp"
+#include "src/resource/CResourceManifest.hpp"
 
 class CResources final
 {
@@ -22,13 +22,19 @@ public:
 	template<typename T>
 	void AddCache( const std::shared_ptr<CResourceCacheBase> &resourceCache )
 	{
-		auto type_index = std::type_index( typeid( T ) );
+		const size_t typeSlot = TypeSlot<T>();
 
-		const auto it = m_resourceCacheMap.find( type_index );
+		if( typeSlot >= m_resourceCaches.size() )
+		{
+			m_resourceCaches.resize( typeSlot + 1 );
+		}
 
-		if( it == std::cend( m_resourceCacheMap ) )
+		if( !m_resourceCaches[ typeSlot ] )
 		{
-			m_resourceCacheMap.insert( std::make_pair( type_index, resourceCache ) );
+			resourceCache->Budget( m_cacheBudget );
+			resourceCache->Dependencies( &m_dependencies );
+
+			m_resourceCaches[ typeSlot ] = resourceCache;
 
 			m_resourceCachesOrdered.emplace_back( resourceCache );
 		}
@@ -40,16 +46,112 @@ public:
 
 	void RemoveCache( const std::shared_ptr<CResourceCacheBase> &resourceCache );
 
+	// drops every resource which is not used anymore right away
 	void CollectGarbage();
+
+	// sweeps a bounded number of resources of every cache, has to be called once per frame
+	void SweepGarbage();
+
+	// in bytes of unused resources which every cache keeps
+	void SetCacheBudget( const u64 budget );
+
+	// reloads the resources whose files were modified, together with everything which depends on them
 	void Reload();
 
+	// reloads the resources which were loaded from the files, together with everything which depends on them
+	void Reload( const std::vector<fs::path> &changedFiles );
+
+	// finishes the asynchronous loads on the main thread, has to be called once per frame
+	void Update();
+
+	// blocks until every asynchronous load is finished
+	void FinishLoads();
+
+	u32 PendingLoads() const;
+
+	// every resource which is requested from now on gets recorded into the manifest with this name
+	void StartRecording( const std::string &name );
+
+	// what was requested since StartRecording with this name
+	[[nodiscard]] CResourceManifest StopRecording( const std::string &name );
+
+	// starts loading the resources of the manifest in the background, they stay loaded until the preload is released
+	void Preload( const std::string &name, const CResourceManifest &manifest );
+
+	void ReleasePreload( const std::string &name );
+
+	void ReleasePreloads();
+
+	// how much of all preloads which were not released yet is loaded, from 0 to 1
+	[[nodiscard]] f16 PreloadProgress() const;
+
+	// of all caches together
+	[[nodiscard]] SMemoryUsage MemoryUsage() const;
+
+	// in the order they were added
+	[[nodiscard]] const std::vector<std::shared_ptr<CResourceCacheBase>> &Caches() const;
+
 	template<typename T>
 	const std::shared_ptr<const T> Get( const std::string &id )
 	{
-		#ifdef STYX_DEBUG
-			const auto it = m_resourceCacheMap.find( std::type_index( typeid( T ) ) );
+		auto &cache = Cache<T>();
+
+		const CResourceId resourceId( id );
+
+		Requested( cache, resourceId, id );
+
+		return( cache.Get( resourceId, id ) );
+	}
+
+	// returns the placeholder right away, see CResourceCache::GetAsync
+	template<typename T>
+	CResourceHandle<T> GetAsync( const std::string &id )
+	{
+		auto &cache = Cache<T>();
+
+		const CResourceId resourceId( id );
+
+		Requested( cache, resourceId, id );
+
+		return( cache.GetAsync( resourceId, id, m_loadQueue ) );
+	}
+
+	template<typename T>
+	CResourceHandle<T> Handle( const std::string &id )
+	{
+		auto &cache = Cache<T>();
+
+		Requested( cache, CResourceId( id ), id );
+
+		return( cache.Handle( id ) );
+	}
+
+	// only resources which are already loaded are found, nullptr otherwise
+	template<typename T>
+	const std::shared_ptr<const T> Find( const CResourceId &id )
+	{
+		return( Cache<T>().Find( id ) );
+	}
+
+private:
+	// every type gets its own slot the first time it is used, so finding its cache is a plain index
+	static size_t NextTypeSlot();
+
+	template<typename T>
+	static size_t TypeSlot()
+	{
+		static const size_t typeSlot = NextTypeSlot();
+
+		return( typeSlot );
+	}
 
-			if( std::cend( m_resourceCacheMap ) == it )
+	template<typename T>
+	CResourceCache<T> &Cache()
+	{
+		const size_t typeSlot = TypeSlot<T>();
+
+		#ifdef STYX_DEBUG
+			if( ( typeSlot >= m_resourceCaches.size() ) || !m_resourceCaches[ typeSlot ] )
 			{
 				const std::string msg = fmt::format( "no resource cache registered for type '{0}'", typeid( T ).name() );
 				logERROR( msg );
@@ -57,13 +159,36 @@ public:
 			}
 		#endif
 
-		auto resourceCache = std::static_pointer_cast<CResourceCache<T>>( m_resourceCacheMap[ std::type_index( typeid( T ) ) ] );
-
-		return( resourceCache->Get( id ) );
+		return( static_cast<CResourceCache<T>&>( *m_resourceCaches[ typeSlot ] ) );
 	}
 
-private:
-	std::unordered_map<std::type_index, const std::shared_ptr<CResourceCacheBase>> m_resourceCacheMap;
+	// records the request into the running recordings and the dependencies
+	void Requested( CResourceCacheBase &cache, const CResourceId &resourceId, const std::string &id );
+
+	void Reload( const std::vector<CResourceDependencies::SNode> &nodes );
+
+	// indexed by the type slots
+	std::vector<std::shared_ptr<CResourceCacheBase>> m_resourceCaches;
 
 	std::vector<std::shared_ptr<CResourceCacheBase>> m_resourceCachesOrdered;
-};
+
+	// how many slots of every cache are looked at per sweep
+	static const size_t SweepSlots = 64;
+
+	u64 m_cacheBudget { 0 };
+
+	std::map<std::string, CResourceManifest> m_recordings;
+
+	CResourceDependencies m_dependencies;
+
+	struct SPreloadedResource final
+	{
+		std::weak_ptr<const CResourceCacheBase>	cache;
+		CResourceId								id;
+		std::shared_ptr<const void>				resource;
+	};
+
+	std::map<std::string, std::vector<SPreloadedResource>> m_preloads;
+
+	CResourceLoadQueue m_loadQueue;
+};
\ No newline at end of file
@@ -1,11 +1,16 @@
 #include "CState.hpp"
 
+#include <cmath>
+
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "external/minitrace/minitrace.h"
 
 #include "src/renderer/components/CModelComponent.hpp"
 #include "src/renderer/components/CGuiModelComponent.hpp"
+#include "src/renderer/components/CImpostorComponent.hpp"
+
+#include "src/logger/CLogger.hpp"
 
 CState::CState( const std::string &name, const CFileSystem &filesystem, const CSettings &settings, CEngineInterface &engineInterface ) :
 		m_name { name },
@@ -13,14 +18,36 @@ CState::CState( const std::string &name, const CFileSystem &filesystem, const CS
 		m_filesystem { filesystem },
 		m_settings { settings },
 		m_engineInterface { engineInterface }
-{}
+{
+	m_engineInterface.Resources.StartRecording( m_name );
+}
+
+CState::~CState()
+{
+	// the constructor didn't finish or the state never got updated
+	if( m_recordingManifest )
+	{
+		[[maybe_unused]] const auto manifest = m_engineInterface.Resources.StopRecording( m_name );
+	}
+}
 
 std::shared_ptr<CState> CState::Update()
 {
 	switch( m_status )
 	{
 		case eStatus::RUNNING:
-			return( OnUpdate() );
+		{
+			if( m_recordingManifest )
+			{
+				SaveManifest();
+			}
+
+			const auto nextState = OnUpdate();
+
+			m_staticBatches.Update( m_scene );
+
+			return( nextState );
+		}
 
 		case eStatus::PAUSED:
 			return( shared_from_this() );
@@ -54,6 +81,23 @@ void CState::Resume()
 	};
 }
 
+void CState::SaveManifest()
+{
+	m_recordingManifest = false;
+
+	auto &resources = m_engineInterface.Resources;
+
+	const CResourceManifest manifest = resources.StopRecording( m_name );
+
+	// the state holds on to everything it needs by now
+	resources.ReleasePreload( m_name );
+
+	if( !manifest.Empty() && !manifest.Save( m_filesystem, CResourceManifest::Path( m_name ) ) )
+	{
+		logWARNING( "couldn't save the resource manifest of state '{0}'", m_name );
+	}
+}
+
 const std::string &CState::Name() const
 {
 	return( m_name );
@@ -106,20 +150,57 @@ RenderPackage CState::CreateRenderPackage() const
 
 		const auto &cameraPosition = cameraEntity->Transform.Position;
 
-		m_scene.Each<CModelComponent>( [ &cameraFrustum, &cameraPosition, &renderLayer ]( const std::shared_ptr<const CEntity> &entity )
+		const f16 projectionScale = renderLayer.ProjectionScale();
+
+		m_scene.Each<CModelComponent>( [ &cameraFrustum, &cameraPosition, &renderLayer, projectionScale ]( const std::shared_ptr<const CEntity> &entity )
 		{
-			const auto &mesh = entity->Get<CModelComponent>()->Mesh.get();
+			const auto &modelComponent = entity->Get<CModelComponent>();
+
+			// already drawn as part of a static batch
+			if( modelComponent->Batched() )
+			{
+				return;
+			}
+
+			const CMesh * mesh = modelComponent->Mesh.get();
 
 			const auto &transform = entity->Transform;
 
+			const f16 boundingSphereRadius = glm::length( mesh->BoundingSphereRadiusVector * transform.Scale );
+
 			// TODO use Octree here
-			if( cameraFrustum.IsSphereInside( transform.Position, glm::length( mesh->BoundingSphereRadiusVector * transform.Scale ) ) )
+			if( cameraFrustum.IsSphereInside( transform.Position, boundingSphereRadius ) )
 			{
+				const f16 viewDepth = glm::length2( transform.Position - cameraPosition );
+
+				if( entity->HasComponents<CImpostorComponent>() && ( viewDepth > 0.0f ) )
+				{
+					const auto &impostorComponent = entity->Get<CImpostorComponent>();
+
+					// fraction of the viewport height which is covered by the bounding sphere
+					const f16 screenSize = ( boundingSphereRadius * projectionScale ) / std::sqrt( viewDepth );
+
+					if( screenSize < impostorComponent->ScreenSize )
+					{
+						mesh = impostorComponent->Impostor->Mesh.get();
+					}
+				}
+
 				const CMaterial * material = mesh->Material().get();
 
-				renderLayer.drawCommands.emplace_back( material->Blending(), mesh, material, material->ShaderProgram().get(), transform.ModelMatrix(), glm::length2( transform.Position - cameraPosition ) );
+				renderLayer.drawCommands.emplace_back( material->Blending(), mesh, material, mesh->MaterialInstance().get(), material->ShaderProgram().get(), transform.ModelMatrix(), viewDepth );
 			}
 		} );
+
+		for( const auto & [ batchMesh, batchPosition ] : m_staticBatches.Batches() )
+		{
+			if( cameraFrustum.IsSphereInside( batchPosition, glm::length( batchMesh->BoundingSphereRadiusVector ) ) )
+			{
+				const CMaterial * material = batchMesh->Material().get();
+
+				renderLayer.drawCommands.emplace_back( material->Blending(), batchMesh.get(), material, batchMesh->MaterialInstance().get(), material->ShaderProgram().get(), glm::translate( glm::mat4( 1.0f ), batchPosition ), glm::length2( batchPosition - cameraPosition ) );
+			}
+		}
 		
 		MTR_END( "GFX", "fill draw drawCommands for camera" );
 	}
@@ -152,7 +233,7 @@ RenderPackage CState::CreateRenderPackage() const
 
 			const CMaterial * material = guiMesh->Material().get();
 
-			renderLayer.drawCommands.emplace_back( material->Blending(), guiMesh, material, material->ShaderProgram().get(), transform.ModelMatrix(), glm::length2( transform.Position ) );
+			renderLayer.drawCommands.emplace_back( material->Blending(), guiMesh, material, guiMesh->MaterialInstance().get(), material->ShaderProgram().get(), transform.ModelMatrix(), glm::length2( transform.Position ) );
 		} );
 	}
 
@@ -9,6 +9,7 @@
 
 #include "src/renderer/CFrameBuffer.hpp"
 #include "src/renderer/RenderPackage.hpp"
+#include "src/renderer/model/CStaticBatches.hpp"
 
 #include "src/scene/CScene.hpp"
 
@@ -23,7 +24,7 @@ private:
 
 protected:
 	CState( const std::string &name, const CFileSystem &filesystem, const CSettings &settings, CEngineInterface &engineInterface );
-	virtual ~CState() {};
+	virtual ~CState();
 
 public:
 	[[nodiscard]] virtual std::shared_ptr<CState> Update() final;
@@ -53,6 +54,8 @@ protected:
 
 	CScene m_scene;
 
+	CStaticBatches m_staticBatches;
+
 	CEngineInterface &m_engineInterface;
 
 private:
@@ -63,4 +66,9 @@ private:
 	};
 
 	eStatus m_status = eStatus::RUNNING;
+
+	// the resources which the constructor requests are recorded into the manifest of the state until the first update
+	bool m_recordingManifest { true };
+
+	void SaveManifest();
 };
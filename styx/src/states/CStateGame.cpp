@@ -9,6 +9,7 @@
 #include "src/scene/components/camera/CCameraFreeComponent.hpp"
 #include "src/renderer/components/CModelComponent.hpp"
 #include "src/renderer/components/CGuiModelComponent.hpp"
+#include "src/renderer/components/CImpostorComponent.hpp"
 
 #include "src/states/CStatePause.hpp"
 
@@ -68,6 +69,7 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 		const auto floorEntity = m_scene.CreateEntity( "floor" );
 		floorEntity->Transform.Rotate( -90.0f, 0.0f, 0.0f );
 		floorEntity->Add<CModelComponent>( floorMesh );
+		floorEntity->Get<CModelComponent>()->Static( true );
 	}
 
 	//auto material2 = resources.Get<CMaterial>( "materials/flames.mat" );
@@ -131,6 +133,8 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 		{
 			const auto superBoxMesh = std::make_shared<CMesh>( GeometryPrefabs::CubePNU0( 4.0f ), materialSuperBox, superBoxMeshTextureSlots );
 
+			const auto superBoxImpostor = m_engineInterface.ImpostorBuilder.Create( superBoxMesh );
+
 			const u16 cubeSize { 14 };
 
 			for( u16 i = 0; i < cubeSize; i++ )
@@ -142,6 +146,11 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 						const auto superBoxEntity = m_scene.CreateEntity( "cube" );
 						superBoxEntity->Transform.Position = { 20.0f + i * 4.0f, ( 0.0f + j * 4.0f ) + 2, 50.0f + k * 4.0f };
 						superBoxEntity->Add<CModelComponent>( superBoxMesh );
+
+						if( superBoxImpostor )
+						{
+							superBoxEntity->Add<CImpostorComponent>( superBoxImpostor, 0.02f );
+						}
 					}
 				}
 			}
@@ -180,6 +189,9 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 						{
 							cubeEntity->Add<CModelComponent>( cubeMeshTransparent );
 						}
+
+						// those cubes never move, so they can be merged into static batches
+						cubeEntity->Get<CModelComponent>()->Static( true );
 					}
 				}
 			}
@@ -207,6 +219,9 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 						{
 							cubeEntity->Add<CModelComponent>( cubeMeshTransparent );
 						}
+
+						// those cubes never move, so they can be merged into static batches
+						cubeEntity->Get<CModelComponent>()->Static( true );
 					}
 				}
 			}
@@ -226,9 +241,12 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 	}
 
 	{
-		const auto greenMaterial = resources.Get<CMaterial>( "materials/green.mat" );
+		// only differs in the color from the red block, so it gets sorted next to it and uses the same render state
+		const auto greenMaterialInstance = std::make_shared<CMaterialInstance>( resources.Get<CMaterial>( "materials/red.mat" ) );
+		greenMaterialInstance->OverrideMaterialUniform<CMaterialUniformFLOATVEC4>( "mainColor", glm::vec4( 0.0f, 1.0f, 0.0f, 1.0f ) );
 
-		const auto blockMesh = std::make_shared<CMesh>( GeometryPrefabs::CuboidP( 4.0f, 4.0f, 2.0f ), greenMaterial );
+		const auto blockMesh = std::make_shared<CMesh>( GeometryPrefabs::CuboidP( 4.0f, 4.0f, 2.0f ), greenMaterialInstance->Parent() );
+		blockMesh->SetMaterialInstance( greenMaterialInstance );
 
 		const auto blockEntity = m_scene.CreateEntity( "green_block" );
 		blockEntity->Transform.Position = { -4.0f, 10.0f, 1.0f };
@@ -321,6 +339,19 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 		firebalEntity->Transform.Position = { 140.0f, 10.0f, 1.0f };
 		firebalEntity->Add<CModelComponent>( fireballMesh );
 	}
+
+	{
+		const auto planetMaterial = resources.Get<CMaterial>( "materials/standard.mat" );
+
+		// block compressed, so it is uploaded without decoding it
+		const CMesh::TMeshTextureSlots planetMeshTextureSlots = { { "diffuseTexture", std::make_shared<CMeshTextureSlot>( resources.Get<CTexture>( "textures/texpack_1/planet.dds" ), samplerManager.GetFromType( CSampler::SamplerType::REPEAT_2D ) ) } };
+
+		const auto planetMesh = std::make_shared<CMesh>( GeometryPrefabs::SpherePU0( 40, 32, 10.0f ), planetMaterial, planetMeshTextureSlots );
+
+		const auto planetEntity = m_scene.CreateEntity( "planet" );
+		planetEntity->Transform.Position = { 170.0f, 10.0f, 1.0f };
+		planetEntity->Add<CModelComponent>( planetMesh );
+	}
 	
 	{ // font test
 		
@@ -435,13 +466,34 @@ CStateGame::CStateGame( const CFileSystem &filesystem, const CSettings &settings
 	{
 		auto crosshairGeometry = GeometryPrefabs::QuadPU0( 64.0f );
 
-		const auto material = resources.Get<CMaterial>( "materials/standard_blend.mat" );
+		const std::string crosshairPassivePath	= "textures/crosshair/crosshair037.png";
+		const std::string crosshairActivePath	= "textures/crosshair/crosshair038.png";
+
+		// both crosshairs share one texture and material and only differ in their material instance
+		const auto crosshairAtlas = m_engineInterface.TextureAtlasBuilder.FromFiles( "crosshairs", { crosshairPassivePath, crosshairActivePath } );
+
+		const auto material = resources.Get<CMaterial>( "materials/atlas_blend.mat" );
+
+		const CMesh::TMeshTextureSlots crosshairTextureSlots = { { "diffuseTexture", std::make_shared<CMeshTextureSlot>( crosshairAtlas->Texture, samplerManager.GetFromType( CSampler::SamplerType::EDGE_2D ) ) } };
+
+		const auto crosshairMaterialInstance = [ &crosshairAtlas, &material ]( const std::string &path )
+		{
+			auto materialInstance = std::make_shared<CMaterialInstance>( material );
+
+			if( const auto entry = crosshairAtlas->EntryFromPath( path ); nullptr != entry )
+			{
+				materialInstance->OverrideMaterialUniform<CMaterialUniformFLOATVEC4>( "atlasTransform", entry->UVTransform );
+				materialInstance->OverrideMaterialUniform<CMaterialUniformUINT>( "atlasLayer", entry->Layer );
+			}
+
+			return( materialInstance );
+		};
 
-		const CMesh::TMeshTextureSlots crosshairPassiveTextureSlots = { { "diffuseTexture", std::make_shared<CMeshTextureSlot>( resources.Get<CTexture>( "textures/crosshair/crosshair037.png" ), samplerManager.GetFromType( CSampler::SamplerType::EDGE_2D ) ) } };
-		const CMesh::TMeshTextureSlots crosshairActiveTextureSlots = { { "diffuseTexture", std::make_shared<CMeshTextureSlot>( resources.Get<CTexture>( "textures/crosshair/crosshair038.png" ), samplerManager.GetFromType( CSampler::SamplerType::EDGE_2D ) ) } };
+		m_crosshairPassiveMesh = std::make_shared<CMesh>( crosshairGeometry, material, crosshairTextureSlots );
+		m_crosshairPassiveMesh->SetMaterialInstance( crosshairMaterialInstance( crosshairPassivePath ) );
 
-		m_crosshairPassiveMesh = std::make_shared<CMesh>( crosshairGeometry, material, crosshairPassiveTextureSlots );
-		m_crosshairActiveMesh = std::make_shared<CMesh>( crosshairGeometry, material, crosshairActiveTextureSlots );
+		m_crosshairActiveMesh = std::make_shared<CMesh>( crosshairGeometry, material, crosshairTextureSlots );
+		m_crosshairActiveMesh->SetMaterialInstance( crosshairMaterialInstance( crosshairActivePath ) );
 
 		m_crosshairEntity = m_scene.CreateEntity( "crosshair" );
 		m_crosshairEntity->Transform.Position = { m_settings.renderer.window.size.width / 2, m_settings.renderer.window.size.height / 2, -20.0f };
@@ -697,6 +749,8 @@ std::shared_ptr<CState> CStateGame::OnUpdate()
 	if( input.KeyDown( SDL_SCANCODE_F1 ) )
 	{
 		logINFO( "frame-time is {0}ms", ( m_engineInterface.Stats.frameTime / 1000.0f ) );
+		logINFO( "GL calls: {0} issued, {1} avoided", m_engineInterface.Stats.glCallsIssued, m_engineInterface.Stats.glCallsAvoided );
+		logINFO( "texture memory: {0} KiB resident, {1} KiB budget, {2} textures reduced", m_engineInterface.Stats.textureMemoryResident / 1024, m_engineInterface.Stats.textureMemoryBudget / 1024, m_engineInterface.Stats.texturesReduced );
 	}
 
 	if( !input.MouseStillDown( SDL_BUTTON_LEFT) )
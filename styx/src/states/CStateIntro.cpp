@@ -63,6 +63,36 @@ CStateIntro::CStateIntro( const CFileSystem &filesystem, const CSettings &settin
 		entity->Add<CGuiModelComponent>( text->Mesh() );
 	}
 
+	// the following states find their resources already loaded, as far as the intro takes long enough
+	for( const std::string stateName : { "main menu", "game" } )
+	{
+		const auto manifest = CResourceManifest::FromFile( filesystem, CResourceManifest::Path( stateName ) );
+
+		if( !manifest.Empty() )
+		{
+			resources.Preload( stateName, manifest );
+		}
+	}
+
+	{
+		const auto fontSize = windowSize.height / 60;
+
+		const auto font = fontbuilder.FromFile( "Comfortaa", "fonts/Comfortaa/Regular.ttf", "fonts/Comfortaa/Bold.ttf", fontSize, CGlyphRange::Default() );
+
+		STextOptions textOptions;
+		textOptions.Color = TangoColors::Aluminium();
+		textOptions.HorizontalAnchor = EHorizontalAnchor::RIGHT;
+		textOptions.VerticalAnchor = EVerticalAnchor::BOTTOM;
+		textOptions.HorizontalAlign = EHorizontalAlign::RIGHT;
+		textOptions.RichText = false;
+
+		m_preloadText = engineInterface.TextBuilder.Create( font, textOptions, "" );
+
+		const auto entity = m_scene.CreateEntity( "preload progress" );
+		entity->Transform.Position = { static_cast<f16>( windowSize.width - fontSize ), static_cast<f16>( fontSize ), 0.0f };
+		entity->Add<CGuiModelComponent>( m_preloadText->Mesh() );
+	}
+
 	m_introSound->Play();
 	m_introSound->SetRelativePositioning( true );
 }
@@ -83,6 +113,14 @@ std::shared_ptr<CState> CStateIntro::OnUpdate()
 	const f16 colorComponent = ( fadeDuration - elapsedTime ) / fadeDuration;
 	m_scene.ClearColor( CColor( colorComponent, colorComponent, colorComponent, colorComponent ) );
 
+	// the text has to be built again every time, so it is only changed when it shows something new
+	if( const u8 preloadPercent = static_cast<u8>( m_engineInterface.Resources.PreloadProgress() * 100 ); preloadPercent != m_preloadPercent )
+	{
+		m_preloadPercent = preloadPercent;
+
+		m_preloadText->Text( ( preloadPercent < 100 ) ? fmt::format( "loading {0}%", preloadPercent ) : "" );
+	}
+
 	if( ( elapsedTime > m_introDuration )
 		||
 		m_engineInterface.Input.KeyDown( SDL_SCANCODE_ESCAPE )
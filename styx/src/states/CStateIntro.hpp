@@ -25,4 +25,7 @@ private:
 	const f16 m_introDuration;
 
 	std::shared_ptr<CEntity> m_logoEntity;
+
+	std::shared_ptr<CText> m_preloadText;
+	u8 m_preloadPercent { 100 };
 };
@@ -0,0 +1,256 @@
+#include "AssetCooker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/core/FileExtension.hpp"
+
+#include "src/helper/Json.hpp"
+#include "src/helper/image/ImageHandler.hpp"
+
+#include "src/system/AssetPack.hpp"
+
+namespace AssetCooker
+{
+	struct SCookedFile final
+	{
+		std::string				name;
+		AssetPack::EEntryKind	kind;
+		std::vector<std::byte>	data;
+		s64						modTime;
+	};
+
+	static u64 Align( const u64 value )
+	{
+		return( ( value + AssetPack::Alignment - 1 ) & ~( AssetPack::Alignment - 1 ) );
+	}
+
+	static bool IsImage( const std::string &fileExtensionString )
+	{
+		return(	( fileExtensionString == std::string( ".png" ) )
+				||
+				( fileExtensionString == std::string( ".jpg" ) )
+				||
+				( fileExtensionString == std::string( ".jpeg" ) )
+				||
+				( fileExtensionString == std::string( ".tga" ) )
+				||
+				( fileExtensionString == std::string( ".bmp" ) ) );
+	}
+
+	static bool IsJson( const std::string &fileExtensionString )
+	{
+		return(	( fileExtensionString == FileExtension::Material::mat )
+				||
+				( fileExtensionString == FileExtension::ShaderProgram::shp )
+				||
+				( fileExtensionString == std::string( ".cub" ) )
+				||
+				( fileExtensionString == std::string( ".arr" ) ) );
+	}
+
+	static bool CookJson( const CFileSystem &filesystem, const fs::path &path, std::vector<std::byte> &data )
+	{
+		try
+		{
+			const auto cbor = nlohmann::json::to_cbor( Json::Load( filesystem, path ) );
+
+			data.resize( cbor.size() );
+
+			std::memcpy( data.data(), cbor.data(), cbor.size() );
+
+			return( true );
+		}
+		catch( const nlohmann::json::parse_error &e )
+		{
+			logWARNING( "'{0}' is no valid JSON, it is stored unchanged: {1}", path.generic_string(), e.what() );
+			return( false );
+		}
+	}
+
+	// the whole mip chain is stored, so loading the texture is only a matter of mapping it
+	static bool CookTexture( const CFileSystem &filesystem, const fs::path &path, std::vector<std::byte> &data )
+	{
+		std::vector<std::shared_ptr<const CImage>> mipChain;
+
+		const std::shared_ptr<const CImage> image = ImageHandler::LoadWithMipChain( filesystem, path, std::numeric_limits<u32>::max(), mipChain );
+
+		if( !image )
+		{
+			logWARNING( "'{0}' couldn't be decoded, it is stored unchanged", path.generic_string() );
+			return( false );
+		}
+
+		mipChain.insert( std::begin( mipChain ), image );
+
+		if( mipChain.size() > AssetPack::MaxTextureLevels )
+		{
+			logWARNING( "'{0}' has more than {1} levels, it is stored unchanged", path.generic_string(), AssetPack::MaxTextureLevels );
+			return( false );
+		}
+
+		AssetPack::STextureHeader header {};
+		header.width		= image->Size().width;
+		header.height		= image->Size().height;
+		header.bpp			= image->BPP();
+		header.levelCount	= static_cast<u8>( mipChain.size() );
+
+		u64 offset = Align( sizeof( header ) );
+
+		for( u8 level = 0; level < header.levelCount; level++ )
+		{
+			header.levelOffsets[ level ] = static_cast<u32>( offset );
+
+			offset = Align( offset + static_cast<u64>( mipChain[ level ]->Pitch() ) * mipChain[ level ]->Size().height );
+		}
+
+		data.assign( offset, std::byte { 0 } );
+
+		std::memcpy( data.data(), &header, sizeof( header ) );
+
+		for( u8 level = 0; level < header.levelCount; level++ )
+		{
+			const auto &levelImage = mipChain[ level ];
+
+			std::memcpy( data.data() + header.levelOffsets[ level ], levelImage->RawPixelData(), static_cast<size_t>( levelImage->Pitch() ) * levelImage->Size().height );
+		}
+
+		return( true );
+	}
+
+	bool Cook( const CFileSystem &filesystem, const fs::path &packPath )
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		std::vector<SCookedFile> cookedFiles;
+
+		u32 jsonCount		= 0;
+		u32 textureCount	= 0;
+
+		for( const auto &path : filesystem.ListAssetFiles() )
+		{
+			const std::string fileExtensionString = path.extension().generic_string();
+
+			// packs which are lying around in the asset paths are never packed again
+			if( fileExtensionString == FileExtension::AssetPack::pack )
+			{
+				continue;
+			}
+
+			SCookedFile cookedFile { path.generic_string(), AssetPack::EEntryKind::RAW, {}, filesystem.GetLastModTime( path ) };
+
+			if( IsJson( fileExtensionString ) && CookJson( filesystem, path, cookedFile.data ) )
+			{
+				cookedFile.kind = AssetPack::EEntryKind::JSON;
+				jsonCount++;
+			}
+			else if( IsImage( fileExtensionString ) && CookTexture( filesystem, path, cookedFile.data ) )
+			{
+				cookedFile.kind = AssetPack::EEntryKind::TEXTURE;
+				textureCount++;
+			}
+			else
+			{
+				cookedFile.data = filesystem.LoadFileToBuffer( path );
+			}
+
+			cookedFiles.push_back( std::move( cookedFile ) );
+		}
+
+		if( cookedFiles.empty() )
+		{
+			logWARNING( "there are no asset files to cook" );
+			return( false );
+		}
+
+		// the blobs follow the header in the order of the names, the table of contents is sorted by hash for the lookups, colliding hashes end up next to each other
+		std::vector<AssetPack::STocEntry> toc;
+
+		std::string names;
+
+		u64 offset = Align( sizeof( AssetPack::SHeader ) );
+
+		for( const auto &cookedFile : cookedFiles )
+		{
+			if( cookedFile.name.size() > std::numeric_limits<u16>::max() )
+			{
+				logWARNING( "the name of '{0}' is too long", cookedFile.name );
+				return( false );
+			}
+
+			AssetPack::STocEntry entry {};
+			entry.hash			= AssetPack::HashPath( cookedFile.name );
+			entry.offset		= offset;
+			entry.size			= cookedFile.data.size();
+			entry.modTime		= cookedFile.modTime;
+			entry.nameOffset	= static_cast<u32>( names.size() );
+			entry.nameLength	= static_cast<u16>( cookedFile.name.size() );
+			entry.kind			= cookedFile.kind;
+
+			toc.push_back( entry );
+
+			names += cookedFile.name;
+
+			offset = Align( offset + cookedFile.data.size() );
+		}
+
+		std::sort( std::begin( toc ), std::end( toc ), []( const auto &a, const auto &b ) { return( a.hash < b.hash ); } );
+
+		AssetPack::SHeader header {};
+		header.magic		= AssetPack::Magic;
+		header.version		= AssetPack::Version;
+		header.entryCount	= static_cast<u32>( toc.size() );
+		header.tocOffset	= offset;
+		header.namesOffset	= offset + toc.size() * sizeof( AssetPack::STocEntry );
+		header.namesSize	= names.size();
+
+		std::ofstream packFile( packPath, std::ios::binary | std::ios::trunc );
+
+		if( !packFile )
+		{
+			logWARNING( "'{0}' can't be opened for writing", packPath.generic_string() );
+			return( false );
+		}
+
+		static const std::array<char, AssetPack::Alignment> padding {};
+
+		auto Pad = [ &packFile ]
+		{
+			const u64 position = static_cast<u64>( packFile.tellp() );
+
+			packFile.write( padding.data(), static_cast<std::streamsize>( Align( position ) - position ) );
+		};
+
+		packFile.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+
+		for( const auto &cookedFile : cookedFiles )
+		{
+			Pad();
+
+			packFile.write( reinterpret_cast<const char*>( cookedFile.data.data() ), static_cast<std::streamsize>( cookedFile.data.size() ) );
+		}
+
+		Pad();
+
+		packFile.write( reinterpret_cast<const char*>( toc.data() ), static_cast<std::streamsize>( toc.size() * sizeof( AssetPack::STocEntry ) ) );
+		packFile.write( names.data(), static_cast<std::streamsize>( names.size() ) );
+
+		packFile.close();
+
+		if( !packFile )
+		{
+			logWARNING( "'{0}' couldn't be written", packPath.generic_string() );
+			return( false );
+		}
+
+		logINFO( "cooked {0} files ( {1} JSON / {2} textures / {3} raw ) into '{4}' with {5:.1f} MiB in {6:.0f} ms", cookedFiles.size(), jsonCount, textureCount, cookedFiles.size() - jsonCount - textureCount, packPath.generic_string(), ( header.namesOffset + header.namesSize ) / 1048576.0, std::chrono::duration<f32, std::milli>( std::chrono::steady_clock::now() - start ).count() );
+
+		return( true );
+	}
+}
\ No newline at end of file
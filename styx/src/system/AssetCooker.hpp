@@ -0,0 +1,9 @@
+#pragma once
+
+#include "src/system/CFileSystem.hpp"
+
+namespace AssetCooker
+{
+	// cooks every asset file into one pack at the native path and logs what was done, false if the pack couldn't be written
+	bool Cook( const CFileSystem &filesystem, const fs::path &packPath );
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+#include "src/core/Types.hpp"
+
+#include "src/helper/Hash.hpp"
+
+/**	Layout of the asset packs written by the cooker.
+	All values are little endian and every blob starts at a multiple of Alignment, so the pack can be used straight from a mapping.
+	[ SHeader ][ blobs ... ][ STocEntry * entryCount, sorted by hash ][ names ]
+*/
+namespace AssetPack
+{
+	constexpr std::array<char, 8> Magic { 'S', 'T', 'Y', 'X', 'P', 'A', 'C', 'K' };
+
+	// packs of another version are refused, they have to be cooked again
+	constexpr u32 Version { 1 };
+
+	constexpr u64 Alignment { 64 };
+
+	enum class EEntryKind : u8
+	{
+		// the unchanged content of the file
+		RAW,
+		// the JSON document stored as CBOR
+		JSON,
+		// a decoded image with its whole mip chain, see STextureHeader
+		TEXTURE
+	};
+
+	struct SHeader final
+	{
+		std::array<char, 8>	magic;
+		u32					version;
+		u32					entryCount;
+		u64					tocOffset;
+		u64					namesOffset;
+		u64					namesSize;
+		u8					reserved[ 24 ];
+	};
+
+	struct STocEntry final
+	{
+		u64			hash;
+		u64			offset;
+		u64			size;
+		s64			modTime;
+		u32			nameOffset;
+		u16			nameLength;
+		EEntryKind	kind;
+		u8			reserved;
+	};
+
+	constexpr u8 MaxTextureLevels { 16 };
+
+	// level 0 is the full image, each following level halves both sides down to 1x1
+	struct STextureHeader final
+	{
+		u32	width;
+		u32	height;
+		u8	bpp;
+		u8	levelCount;
+		u16	reserved;
+		// relative to the start of the entry, each a multiple of Alignment
+		u32	levelOffsets[ MaxTextureLevels ];
+	};
+
+	static_assert( sizeof( SHeader ) == 64 );
+	static_assert( sizeof( STocEntry ) == 40 );
+	static_assert( sizeof( STextureHeader ) == 76 );
+
+	// over the path as it is used as key in the file index
+	constexpr u64 HashPath( const std::string_view path )
+	{
+		return( Hash::FNV1a( path ) );
+	}
+}
@@ -0,0 +1,116 @@
+#include "CAssetPack.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "src/logger/CLogger.hpp"
+
+CAssetPack::CAssetPack( const fs::path &nativePath, CFileView file ) :
+	m_nativePath { nativePath },
+	m_file { std::move( file ) }
+{
+}
+
+std::shared_ptr<const CAssetPack> CAssetPack::Open( const fs::path &nativePath )
+{
+	CFileView file = CFileView::Map( nativePath );
+
+	if( file.Size() < sizeof( AssetPack::SHeader ) )
+	{
+		logWARNING( "asset pack '{0}' couldn't be mapped or is too small", nativePath.generic_string() );
+		return( nullptr );
+	}
+
+	AssetPack::SHeader header;
+	std::memcpy( &header, file.Data(), sizeof( header ) );
+
+	if( header.magic != AssetPack::Magic )
+	{
+		logWARNING( "'{0}' is no asset pack", nativePath.generic_string() );
+		return( nullptr );
+	}
+
+	if( header.version != AssetPack::Version )
+	{
+		logWARNING( "asset pack '{0}' has version {1} instead of {2} and has to be cooked again", nativePath.generic_string(), header.version, AssetPack::Version );
+		return( nullptr );
+	}
+
+	if(	( header.tocOffset + static_cast<u64>( header.entryCount ) * sizeof( AssetPack::STocEntry ) > file.Size() )
+		||
+		( header.namesOffset + header.namesSize > file.Size() ) )
+	{
+		logWARNING( "the table of contents of asset pack '{0}' is truncated", nativePath.generic_string() );
+		return( nullptr );
+	}
+
+	// the constructor is private, so make_shared can't be used
+	std::shared_ptr<CAssetPack> pack( new CAssetPack( nativePath, std::move( file ) ) );
+
+	const std::byte *base = pack->m_file.Data();
+
+	const char *names = reinterpret_cast<const char*>( base + header.namesOffset );
+
+	pack->m_entries.reserve( header.entryCount );
+	pack->m_hashes.reserve( header.entryCount );
+
+	for( u32 i = 0; i < header.entryCount; i++ )
+	{
+		AssetPack::STocEntry tocEntry;
+		std::memcpy( &tocEntry, base + header.tocOffset + i * sizeof( AssetPack::STocEntry ), sizeof( tocEntry ) );
+
+		if(	( tocEntry.offset + tocEntry.size > pack->m_file.Size() )
+			||
+			( static_cast<u64>( tocEntry.nameOffset ) + tocEntry.nameLength > header.namesSize ) )
+		{
+			logWARNING( "entry {0} of asset pack '{1}' lies outside of the pack", i, nativePath.generic_string() );
+			return( nullptr );
+		}
+
+		pack->m_entries.push_back( { std::string_view( names + tocEntry.nameOffset, tocEntry.nameLength ), tocEntry.kind, base + tocEntry.offset, tocEntry.size, tocEntry.modTime } );
+		pack->m_hashes.push_back( tocEntry.hash );
+	}
+
+	if( !std::is_sorted( std::cbegin( pack->m_hashes ), std::cend( pack->m_hashes ) ) )
+	{
+		logWARNING( "the table of contents of asset pack '{0}' is not sorted", nativePath.generic_string() );
+		return( nullptr );
+	}
+
+	logINFO( "opened asset pack '{0}' with {1} entries", nativePath.generic_string(), pack->m_entries.size() );
+
+	return( pack );
+}
+
+const std::vector<CAssetPack::SEntry> &CAssetPack::Entries() const
+{
+	return( m_entries );
+}
+
+const CAssetPack::SEntry *CAssetPack::Find( const std::string_view name ) const
+{
+	const u64 hash = AssetPack::HashPath( name );
+
+	// entries with colliding hashes are next to each other
+	for( auto it = std::lower_bound( std::cbegin( m_hashes ), std::cend( m_hashes ), hash ); ( std::cend( m_hashes ) != it ) && ( *it == hash ); ++it )
+	{
+		const auto &entry = m_entries[ static_cast<size_t>( std::distance( std::cbegin( m_hashes ), it ) ) ];
+
+		if( entry.name == name )
+		{
+			return( &entry );
+		}
+	}
+
+	return( nullptr );
+}
+
+CFileView CAssetPack::View( const SEntry &entry ) const
+{
+	return( CFileView( shared_from_this(), entry.data, static_cast<size_t>( entry.size ) ) );
+}
+
+const fs::path &CAssetPack::NativePath() const
+{
+	return( m_nativePath );
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+#include "src/core/Types.hpp"
+
+#include "src/system/AssetPack.hpp"
+#include "src/system/CFileView.hpp"
+
+/**
+ * A cooked asset pack, mapped into memory as a whole.
+ * Views of its entries keep the pack alive, so it can be dropped by the file system at any time.
+ */
+class CAssetPack final : public std::enable_shared_from_this<CAssetPack>
+{
+public:
+	struct SEntry final
+	{
+		std::string_view		name;
+		AssetPack::EEntryKind	kind;
+		const std::byte			*data;
+		u64						size;
+		s64						modTime;
+	};
+
+	// nullptr if the file is no valid pack of the current version
+	[[nodiscard]] static std::shared_ptr<const CAssetPack> Open( const fs::path &nativePath );
+
+	// ordered by the hash of their names
+	const std::vector<SEntry> &Entries() const;
+
+	// looks the name up in the hashed table of contents, nullptr if it isn't in the pack
+	const SEntry *Find( const std::string_view name ) const;
+
+	CFileView View( const SEntry &entry ) const;
+
+	const fs::path &NativePath() const;
+
+private:
+	CAssetPack( const fs::path &nativePath, CFileView file );
+
+	const fs::path	m_nativePath;
+	const CFileView	m_file;
+
+	std::vector<SEntry>	m_entries;
+	std::vector<u64>	m_hashes;
+};
@@ -0,0 +1,210 @@
+#include "CAsyncFileReader.hpp"
+
+#include <algorithm>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/system/CFileSystem.hpp"
+
+CAsyncFileReader::CRequest::CRequest( const fs::path &path, const EPriority priority, TCallback callback ) :
+	m_path { path },
+	m_priority { priority },
+	m_callback { std::move( callback ) }
+{
+}
+
+const fs::path &CAsyncFileReader::CRequest::Path() const
+{
+	return( m_path );
+}
+
+CAsyncFileReader::EPriority CAsyncFileReader::CRequest::Priority() const
+{
+	return( m_priority );
+}
+
+CAsyncFileReader::CRequest::EState CAsyncFileReader::CRequest::State() const
+{
+	return( m_state );
+}
+
+CAsyncFileReader::CAsyncFileReader( const CFileSystem &p_filesystem, const u8 threadCount ) :
+	m_filesystem { p_filesystem }
+{
+	for( u8 i = 0; i < threadCount; i++ )
+	{
+		m_threads.emplace_back( &CAsyncFileReader::Work, this );
+	}
+
+	logINFO( "async file reader was initialized with {0} threads", m_threads.size() );
+}
+
+CAsyncFileReader::~CAsyncFileReader()
+{
+	{
+		const std::lock_guard<std::mutex> lock( m_mutex );
+
+		if( m_pendingCount > 0 )
+		{
+			logWARNING( "async file reader drops {0} reads", m_pendingCount.load() );
+		}
+
+		m_stopping = true;
+	}
+
+	m_condition.notify_all();
+
+	for( auto &thread : m_threads )
+	{
+		thread.join();
+	}
+
+	logINFO( "async file reader is shutting down" );
+}
+
+CAsyncFileReader::THandle CAsyncFileReader::Read( const fs::path &path, const EPriority priority, TCallback callback )
+{
+	auto request = std::make_shared<CRequest>( path, priority, std::move( callback ) );
+
+	{
+		const std::lock_guard<std::mutex> lock( m_mutex );
+
+		m_queues[ static_cast<size_t>( priority ) ].push_back( request );
+
+		m_pendingCount++;
+	}
+
+	m_condition.notify_one();
+
+	return( request );
+}
+
+void CAsyncFileReader::Cancel( const THandle &request )
+{
+	auto state = request->m_state.load();
+
+	// a delivered request is already done, every other state can still be cancelled
+	while(	( CRequest::EState::DELIVERED != state )
+			&&
+			( CRequest::EState::CANCELLED != state ) )
+	{
+		if( request->m_state.compare_exchange_weak( state, CRequest::EState::CANCELLED ) )
+		{
+			// queued and running requests are removed from the count by the I/O thread
+			if( CRequest::EState::COMPLETED == state )
+			{
+				request->m_file = CFileView();
+			}
+
+			return;
+		}
+	}
+}
+
+void CAsyncFileReader::Deliver()
+{
+	std::vector<THandle> completed;
+
+	{
+		const std::lock_guard<std::mutex> lock( m_mutex );
+
+		std::swap( completed, m_completed );
+	}
+
+	for( const auto &request : completed )
+	{
+		auto expected = CRequest::EState::COMPLETED;
+
+		// requests which got cancelled after they were read are dropped here
+		if( request->m_state.compare_exchange_strong( expected, CRequest::EState::DELIVERED ) )
+		{
+			request->m_callback( std::move( request->m_file ) );
+		}
+
+		request->m_callback = nullptr;
+	}
+}
+
+size_t CAsyncFileReader::PendingCount() const
+{
+	return( m_pendingCount );
+}
+
+std::string CAsyncFileReader::PriorityName( const EPriority priority )
+{
+	switch( priority )
+	{
+		case EPriority::AUDIO_STREAMING:
+			return( "audio streaming" );
+
+		case EPriority::TEXTURE:
+			return( "texture" );
+
+		case EPriority::PREFETCH:
+			return( "prefetch" );
+
+		default:
+			return( "unknown" );
+	}
+}
+
+void CAsyncFileReader::Work()
+{
+	while( true )
+	{
+		THandle request;
+
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+
+			const auto nextQueue = [ this ] { return( std::find_if( std::begin( m_queues ), std::end( m_queues ), []( const auto &queue ) { return( !queue.empty() ); } ) ); };
+
+			m_condition.wait( lock, [ this, &nextQueue ] { return( m_stopping || ( std::end( m_queues ) != nextQueue() ) ); } );
+
+			if( m_stopping )
+			{
+				return;
+			}
+
+			auto &queue = *nextQueue();
+
+			request = std::move( queue.front() );
+			queue.pop_front();
+		}
+
+		auto expected = CRequest::EState::QUEUED;
+
+		if( request->m_state.compare_exchange_strong( expected, CRequest::EState::READING ) )
+		{
+			// read into memory instead of mapping it, otherwise the pages would be faulted in later on the main thread
+			CFileView file;
+
+			try
+			{
+				file = CFileView( m_filesystem.LoadFileToBuffer( request->m_path ) );
+			}
+			catch( std::exception &e )
+			{
+				logERROR( "async read of '{0}' failed: {1}", request->m_path.generic_string(), e.what() );
+			}
+
+			request->m_file = std::move( file );
+
+			expected = CRequest::EState::READING;
+
+			if( request->m_state.compare_exchange_strong( expected, CRequest::EState::COMPLETED ) )
+			{
+				const std::lock_guard<std::mutex> lock( m_mutex );
+
+				m_completed.push_back( request );
+			}
+			else
+			{
+				// cancelled while it was read
+				request->m_file = CFileView();
+			}
+		}
+
+		m_pendingCount--;
+	}
+}
\ No newline at end of file
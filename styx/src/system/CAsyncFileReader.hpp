@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+#include "src/core/Types.hpp"
+
+#include "src/system/CFileView.hpp"
+
+class CFileSystem;
+
+/**
+ * Reads files on a few I/O threads, so the main thread never blocks on the disk.
+ * Every read opens its own PhysicsFS handle on the I/O thread and closes it there, because a handle must not be shared between threads.
+ * The callbacks are only called from Deliver, which the engine calls once per frame on the main thread.
+ */
+class CAsyncFileReader final
+{
+public:
+	// requests of a higher priority are always read first
+	enum class EPriority : u8
+	{
+		AUDIO_STREAMING,
+		TEXTURE,
+		PREFETCH,
+		COUNT
+	};
+
+	// an empty view means the file couldn't be read
+	using TCallback = std::function<void( CFileView file )>;
+
+	class CRequest final
+	{
+		friend class CAsyncFileReader;
+
+	public:
+		enum class EState : u8
+		{
+			QUEUED,
+			READING,
+			COMPLETED,
+			DELIVERED,
+			CANCELLED
+		};
+
+		CRequest( const fs::path &path, const EPriority priority, TCallback callback );
+
+		const fs::path &Path() const;
+		EPriority Priority() const;
+		EState State() const;
+
+	private:
+		const fs::path	m_path;
+		const EPriority	m_priority;
+
+		TCallback m_callback;
+
+		std::atomic<EState> m_state { EState::QUEUED };
+
+		// only touched by the I/O thread until the request is completed
+		CFileView m_file;
+	};
+
+	using THandle = std::shared_ptr<CRequest>;
+
+	CAsyncFileReader( const CFileSystem &p_filesystem, const u8 threadCount );
+	~CAsyncFileReader();
+
+	THandle Read( const fs::path &path, const EPriority priority, TCallback callback );
+
+	// the callback won't be called anymore, a read which is already running finishes but its result is dropped
+	void Cancel( const THandle &request );
+
+	// calls the callbacks of all completed requests on the calling thread
+	void Deliver();
+
+	// queued and running requests
+	size_t PendingCount() const;
+
+	static std::string PriorityName( const EPriority priority );
+
+private:
+	CAsyncFileReader( const CAsyncFileReader &rhs ) = delete;
+	CAsyncFileReader& operator = ( const CAsyncFileReader &rhs ) = delete;
+
+	void Work();
+
+	const CFileSystem &m_filesystem;
+
+	mutable std::mutex		m_mutex;
+	std::condition_variable	m_condition;
+
+	std::array<std::deque<THandle>, static_cast<size_t>( EPriority::COUNT )> m_queues;
+
+	std::vector<THandle> m_completed;
+
+	std::atomic<size_t> m_pendingCount { 0 };
+
+	bool m_stopping { false };
+
+	std::vector<std::thread> m_threads;
+};
\ No newline at end of file
@@ -3,11 +3,18 @@
 #include "CTimer.hpp"
 
 #include "external/minitrace/minitrace.h"
+#include "external/fmt/chrono.h"
 
 #include "src/logger/CLogger.hpp"
 
+#include "src/helper/Date.hpp"
+
+#include "src/renderer/CGLState.hpp"
+
 #include "src/states/CStateIntro.hpp"
 
+#include "src/system/MemoryReport.hpp"
+
 const std::string	CEngine::m_name				{ "Styx Engine" };
 const u16			CEngine::m_version_major	{ 20 };
 const u16			CEngine::m_version_minor	{ 04 };
@@ -26,9 +33,22 @@ CEngine::CEngine( const char *argv0, const std::string &gameDirectory, const std
 	m_samplerManager( m_renderer.OpenGlAdapter ),
 	m_fontBuilder( m_filesystem ),
 	m_textBuilder( m_samplerManager, m_renderer.ShaderCompiler, m_renderer.ShaderProgramCompiler ),
-	m_engineInterface( m_resources, m_input, m_audio, m_samplerManager, m_fontBuilder, m_textBuilder, m_stats )
+	m_impostorBuilder( m_renderer, m_samplerManager ),
+	m_textureAtlasBuilder( m_filesystem, m_renderer.OpenGlAdapter ),
+	m_engineInterface( m_resources, m_input, m_audio, m_samplerManager, m_fontBuilder, m_textBuilder, m_impostorBuilder, m_textureAtlasBuilder, m_stats )
 {
-	logINFO( "engine was initialized" );
+	m_filesystem.SetArchiveCacheBudget( static_cast<u64>( m_settings.filesystem.archive_cache ) * 1024 * 1024 );
+
+	m_resources.SetCacheBudget( static_cast<u64>( m_settings.resources.cache_budget ) * 1024 * 1024 );
+
+	#ifdef STYX_DEBUG
+		// resources are reloaded as soon as their files are saved
+		m_filesystem.WatchAssets();
+	#endif
+
+	m_renderer.ShaderProgramCompiler.BinaryCache().LogStatistics();
+
+	logINFO( "engine was initialized in {0:.0f} ms", m_startupTimer.Time() / 1000.0 );
 }
 
 CEngine::~CEngine()
@@ -42,6 +62,12 @@ void CEngine::Run()
 
 	logINFO( "" );
 
+	// everything the engine loaded while starting up
+	m_filesystem.LogIndexStatistics();
+	m_filesystem.LogArchiveCacheStatistics();
+
+	logINFO( "" );
+
 	logINFO( "--------------------------------------------------------------------------------" );
 	logINFO( "START of main loop" );
 	logINFO( "--------------------------------------------------------------------------------" );
@@ -62,6 +88,27 @@ void CEngine::Run()
 
 		m_window.Update();
 
+		// everything which got read since the last frame is handed to its requester before anything gets updated
+		m_filesystem.DeliverAsyncReads();
+
+		m_resources.Update();
+
+		#ifdef STYX_DEBUG
+			if( const auto changedFiles = m_filesystem.ChangedFiles(); !changedFiles.empty() )
+			{
+				// programs must not be reset while they are still being linked
+				m_renderer.ShaderProgramCompiler.Finish();
+
+				m_resources.Reload( changedFiles );
+
+				m_renderer.ShaderProgramCompiler.Finish();
+			}
+		#endif
+
+		m_renderer.ShaderProgramCompiler.Update();
+
+		m_renderer.TextureStreamer.Update();
+
 		m_renderer.RenderPackageToFramebuffer( currentState->CreateRenderPackage(), currentState->FrameBuffer() );
 
 		m_renderer.DisplayFramebuffer( currentState->FrameBuffer() );
@@ -77,20 +124,47 @@ void CEngine::Run()
 			#ifdef STYX_DEBUG
 				if( m_input.KeyDown( SDL_SCANCODE_F12 ) )
 				{
+					// programs must not be reset while they are still being linked
+					m_renderer.ShaderProgramCompiler.Finish();
+
+					// the modification times are taken from the index, which doesn't know about files edited outside of the engine
+					m_filesystem.RebuildIndex();
+
 					m_resources.Reload();
+
+					m_renderer.ShaderProgramCompiler.Finish();
+				}
+
+				if( m_input.KeyDown( SDL_SCANCODE_F11 ) )
+				{
+					m_renderer.TextureStreamer.LogResidency();
+				}
+
+				if( m_input.KeyDown( SDL_SCANCODE_F10 ) )
+				{
+					MemoryReport::Dump( m_filesystem, m_resources, m_fontBuilder, fmt::format( "memory/{0:%Y-%m-%d_%H-%M-%S}.json", fmt::localtime( Date::GetCurrentDateTime() ) ) );
 				}
 			#endif
 
 			lastUpdatedTime += m_settings.engine.tick;
 		}
 
-		// TODO maybe only collect garbage when changing states?
-		m_resources.CollectGarbage();
+		// unused resources are kept until their cache exceeds its budget, so they survive state changes
+		m_resources.SweepGarbage();
 
 		const u64 frameEndtime = frameTimer.Time();
 		
 		m_stats.frameTime = ( frameEndtime - frameStartTime );
 
+		m_stats.glCallsIssued = CGLState::Statistics().issuedCalls;
+		m_stats.glCallsAvoided = CGLState::Statistics().avoidedCalls;
+		CGLState::ResetStatistics();
+
+		const auto &textureStatistics = m_renderer.TextureStreamer.Statistics();
+		m_stats.textureMemoryResident	= textureStatistics.residentSize;
+		m_stats.textureMemoryBudget		= textureStatistics.budget;
+		m_stats.texturesReduced			= textureStatistics.reducedTextures;
+
 		#ifdef STYX_DEBUG
 			if( m_stats.frameTime > m_settings.engine.tick )
 			{
@@ -100,6 +174,10 @@ void CEngine::Run()
 		#endif // STYX_DEBUG
 	}
 
+	// nothing is used anymore, so the preloaded and retained resources are released before their caches are removed
+	m_resources.ReleasePreloads();
+	m_resources.CollectGarbage();
+
 	MTR_END( "main loop", "outer" );
 
 
@@ -10,6 +10,8 @@
 #include "src/renderer/sampler/CSamplerManager.hpp"
 #include "src/renderer/font/CFontBuilder.hpp"
 #include "src/renderer/text/CTextBuilder.hpp"
+#include "src/renderer/impostor/CImpostorBuilder.hpp"
+#include "src/renderer/texture/CTextureAtlasBuilder.hpp"
 
 class CEngineInterface final
 {
@@ -20,6 +22,8 @@ public:
 						const CSamplerManager 	&samplerManager,
 						const CFontBuilder		&fontBuilder,
 						const CTextBuilder		&textBuilder,
+						const CImpostorBuilder	&impostorBuilder,
+						const CTextureAtlasBuilder	&textureAtlasBuilder,
 						const CEngineStats		&stats ) :
 		Resources { resources },
 		Input { input },
@@ -27,6 +31,8 @@ public:
 		SamplerManager { samplerManager },
 		FontBuilder { fontBuilder },
 		TextBuilder { textBuilder },
+		ImpostorBuilder { impostorBuilder },
+		TextureAtlasBuilder { textureAtlasBuilder },
 		Stats { stats }
 	{}
 
@@ -42,6 +48,10 @@ public:
 	
 	const CTextBuilder		&TextBuilder;
 	
+	const CImpostorBuilder	&ImpostorBuilder;
+
+	const CTextureAtlasBuilder	&TextureAtlasBuilder;
+	
 	const CEngineStats		&Stats;
 
 private:
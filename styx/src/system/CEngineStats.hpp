@@ -6,4 +6,13 @@ class CEngineStats final
 {
 public:
 	u64 frameTime;
+
+	/** GL calls which reached the driver or were filtered out by CGLState during the last frame */
+	u64 glCallsIssued;
+	u64 glCallsAvoided;
+
+	/** bytes of the streamed textures in video memory and the budget for them, which is 0 when unlimited */
+	u64 textureMemoryResident;
+	u64 textureMemoryBudget;
+	u32 texturesReduced;
 };
@@ -0,0 +1,146 @@
+#include "CFileCache.hpp"
+
+void CFileCache::SetBudget( const u64 budget )
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	m_statistics.budget = budget;
+
+	Evict( 0 );
+}
+
+bool CFileCache::Enabled() const
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	return( m_statistics.budget > 0 );
+}
+
+std::shared_ptr<const CFileCache::FileBuffer> CFileCache::Find( const std::string &key )
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	const auto lookup = m_lookup.find( key );
+
+	if( std::end( m_lookup ) == lookup )
+	{
+		m_statistics.misses++;
+
+		return( nullptr );
+	}
+
+	m_statistics.hits++;
+
+	m_entries.splice( std::begin( m_entries ), m_entries, lookup->second );
+
+	return( lookup->second->content );
+}
+
+void CFileCache::Insert( const std::string &key, const std::shared_ptr<const FileBuffer> &content )
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	const u64 size = content->size();
+
+	if( size > m_statistics.budget )
+	{
+		return;
+	}
+
+	// another thread may have read the same file in the meantime
+	if( const auto lookup = m_lookup.find( key ); std::end( m_lookup ) != lookup )
+	{
+		m_statistics.size -= lookup->second->content->size();
+
+		m_entries.erase( lookup->second );
+		m_lookup.erase( lookup );
+	}
+
+	Evict( size );
+
+	if( m_statistics.size + size > m_statistics.budget )
+	{
+		// everything left is pinned
+		return;
+	}
+
+	m_entries.push_front( { key, content } );
+	m_lookup[ key ] = std::begin( m_entries );
+
+	m_statistics.size += size;
+}
+
+void CFileCache::Erase( const std::string &key )
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	if( const auto lookup = m_lookup.find( key ); std::end( m_lookup ) != lookup )
+	{
+		m_statistics.size -= lookup->second->content->size();
+
+		m_entries.erase( lookup->second );
+		m_lookup.erase( lookup );
+	}
+}
+
+void CFileCache::Clear()
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	m_entries.clear();
+	m_lookup.clear();
+
+	m_statistics.size = 0;
+}
+
+void CFileCache::Pin( const std::string &key )
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	m_pins[ key ]++;
+}
+
+void CFileCache::Unpin( const std::string &key )
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	const auto pin = m_pins.find( key );
+
+	if( ( std::end( m_pins ) != pin ) && ( 0 == --pin->second ) )
+	{
+		m_pins.erase( pin );
+	}
+}
+
+CFileCache::SStatistics CFileCache::Statistics() const
+{
+	const std::lock_guard<std::mutex> lock( m_mutex );
+
+	SStatistics statistics = m_statistics;
+
+	statistics.entries = m_entries.size();
+
+	return( statistics );
+}
+
+void CFileCache::Evict( const u64 neededSize )
+{
+	auto entry = std::end( m_entries );
+
+	while( ( m_statistics.size + neededSize > m_statistics.budget ) && ( std::begin( m_entries ) != entry ) )
+	{
+		--entry;
+
+		if( m_pins.count( entry->key ) > 0 )
+		{
+			continue;
+		}
+
+		m_statistics.size -= entry->content->size();
+		m_statistics.evictions++;
+
+		m_lookup.erase( entry->key );
+
+		entry = m_entries.erase( entry );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/core/Types.hpp"
+
+/**
+ * Least recently used cache of file contents, limited by a byte budget.
+ * Pinned files are never evicted, pins may be set before the file is cached.
+ * All functions are thread safe.
+ */
+class CFileCache final
+{
+public:
+	using FileBuffer = std::vector<std::byte>;
+
+	struct SStatistics final
+	{
+		// in bytes, 0 disables the cache
+		u64 budget		{ 0 };
+		u64 size		{ 0 };
+		u64 entries		{ 0 };
+		u64 hits		{ 0 };
+		u64 misses		{ 0 };
+		u64 evictions	{ 0 };
+	};
+
+	// evicts right away if the new budget is smaller
+	void SetBudget( const u64 budget );
+
+	bool Enabled() const;
+
+	// nullptr if the file isn't cached
+	std::shared_ptr<const FileBuffer> Find( const std::string &key );
+
+	// files bigger than the budget aren't cached
+	void Insert( const std::string &key, const std::shared_ptr<const FileBuffer> &content );
+
+	void Erase( const std::string &key );
+	void Clear();
+
+	void Pin( const std::string &key );
+	void Unpin( const std::string &key );
+
+	SStatistics Statistics() const;
+
+private:
+	struct SEntry final
+	{
+		std::string							key;
+		std::shared_ptr<const FileBuffer>	content;
+	};
+
+	// only call with the mutex locked
+	void Evict( const u64 neededSize );
+
+	mutable std::mutex m_mutex;
+
+	// the most recently used entry is at the front
+	std::list<SEntry> m_entries;
+
+	std::unordered_map<std::string, std::list<SEntry>::iterator> m_lookup;
+
+	std::unordered_map<std::string, u32> m_pins;
+
+	SStatistics m_statistics;
+};
\ No newline at end of file
@@ -1,5 +1,10 @@
 #include "CFileSystem.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
 #include "external/physfs/physfs.h"
 
 #include "src/core/Types.hpp"
@@ -8,6 +13,7 @@
 #include "src/logger/CLogTargetFile.hpp"
 
 #include "src/core/StyxException.hpp"
+#include "src/core/FileExtension.hpp"
 
 CFileSystem::CFileSystem( const char *argv0, const std::string &organisation, const std::string &gamename, const fs::path &gameDirectory, const std::vector<std::string> &assets )
 {
@@ -72,8 +78,31 @@ CFileSystem::CFileSystem( const char *argv0, const std::string &organisation, co
 	{
 		const fs::path asset_path = gameDirectory / asset;
 
+		if( asset_path.extension().generic_string() == FileExtension::AssetPack::pack )
+		{
+			std::error_code error;
+
+			// the game may list its pack before it was cooked
+			if( !fs::exists( asset_path, error ) )
+			{
+				logINFO( "asset pack '{0}' does not exist, the assets are loaded from the other asset-paths", asset_path.generic_string() );
+				continue;
+			}
+
+			logINFO( "adding asset pack '{0}'", asset_path.generic_string() );
+
+			if( const auto pack = CAssetPack::Open( asset_path ) )
+			{
+				m_packs.push_back( pack );
+			}
+
+			continue;
+		}
+
 		logINFO( "adding asset-path '{0}'", asset_path.generic_string() );
 
+		m_assetPaths.push_back( asset_path.generic_string() );
+
 		if( !PHYSFS_mount( asset_path.generic_string().c_str(), nullptr, 1 ) )
 		{
 			THROW_STYX_EXCEPTION( "adding asset-path '{0}' to search path failed because of: {1}", asset_path.generic_string(), PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) )
@@ -86,6 +115,10 @@ CFileSystem::CFileSystem( const char *argv0, const std::string &organisation, co
 		THROW_STYX_EXCEPTION( "adding '{0}' to search path failed because of: {1}", PHYSFS_getBaseDir(), PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) )
 	}
 
+	RebuildIndex();
+
+	m_asyncFileReader = std::make_unique<CAsyncFileReader>( *this, AsyncReadThreadCount );
+
 	logINFO( "file system was initialized" );
 }
 
@@ -93,6 +126,11 @@ CFileSystem::~CFileSystem()
 {
 	logINFO( "file system is shutting down" );
 
+	m_asyncFileReader.reset();
+
+	LogIndexStatistics();
+	LogArchiveCacheStatistics();
+
 	if( !PHYSFS_deinit() )
 	{
 		logWARNING( "deinitializing PhysicsFS failed because of: {0}", PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) );
@@ -101,7 +139,9 @@ CFileSystem::~CFileSystem()
 
 bool CFileSystem::Exists( const fs::path &path ) const
 {
-	return( PHYSFS_exists( path.generic_string().c_str() ) );
+	SIndexEntry entry;
+
+	return( Lookup( path, entry ) );
 }
 
 bool CFileSystem::IsDirectory( const fs::path &path ) const
@@ -112,10 +152,9 @@ bool CFileSystem::IsDirectory( const fs::path &path ) const
 		return( false );
 	}
 
-	PHYSFS_Stat stat;
-	PHYSFS_stat( path.generic_string().c_str(), &stat );
+	SIndexEntry entry;
 
-	return( stat.filetype == PHYSFS_FILETYPE_DIRECTORY );
+	return( Lookup( path, entry ) && entry.isDirectory );
 }
 
 s64 CFileSystem::GetLastModTime( const fs::path &path ) const
@@ -126,15 +165,97 @@ s64 CFileSystem::GetLastModTime( const fs::path &path ) const
 		return( false );
 	}
 
-	PHYSFS_Stat stat;
-	PHYSFS_stat( path.generic_string().c_str(), &stat );
+	SIndexEntry entry;
 
-	return( stat.modtime );
+	if( !Lookup( path, entry ) )
+	{
+		return( -1 );
+	}
+
+	return( entry.modTime );
 }
 
 bool CFileSystem::MakeDir( const fs::path &path ) const
 {
-	return( PHYSFS_mkdir( path.generic_string().c_str() ) );
+	if( !PHYSFS_mkdir( path.generic_string().c_str() ) )
+	{
+		return( false );
+	}
+
+	const std::unique_lock<std::shared_mutex> lock( m_indexMutex );
+
+	// PhysicsFS creates all the missing parents too
+	for( fs::path directory = IndexKey( path ); !directory.empty(); directory = directory.parent_path() )
+	{
+		IndexPath( directory.generic_string() );
+	}
+
+	return( true );
+}
+
+std::vector<fs::path> CFileSystem::ListFiles( const fs::path &directory ) const
+{
+	std::vector<fs::path> files;
+
+	const std::string key = IndexKey( directory );
+
+	// the index also knows the files in asset packs, which PhysicsFS can't list
+	const std::string prefix = key.empty() ? key : ( key + "/" );
+
+	{
+		const std::shared_lock<std::shared_mutex> lock( m_indexMutex );
+
+		if( !key.empty() && ( std::cend( m_index ) == m_index.find( key ) ) )
+		{
+			logWARNING( "couldn't list the files in '{0}' because it doesn't exist", directory.generic_string() );
+			return( files );
+		}
+
+		for( const auto &[ path, entry ] : m_index )
+		{
+			if( !entry.isDirectory && ( 0 == path.compare( 0, prefix.size(), prefix ) ) )
+			{
+				files.emplace_back( path );
+			}
+		}
+	}
+
+	std::sort( std::begin( files ), std::end( files ) );
+
+	return( files );
+}
+
+std::vector<fs::path> CFileSystem::ListAssetFiles() const
+{
+	std::vector<fs::path> files;
+
+	{
+		const std::shared_lock<std::shared_mutex> lock( m_indexMutex );
+
+		for( const auto &[ path, entry ] : m_index )
+		{
+			if( !entry.isDirectory && m_mounts[ entry.mount ].isAsset )
+			{
+				files.emplace_back( path );
+			}
+		}
+	}
+
+	std::sort( std::begin( files ), std::end( files ) );
+
+	return( files );
+}
+
+AssetPack::EEntryKind CFileSystem::EntryKind( const fs::path &path ) const
+{
+	SIndexEntry entry;
+
+	if( !Lookup( path, entry ) )
+	{
+		return( AssetPack::EEntryKind::RAW );
+	}
+
+	return( entry.kind );
 }
 
 const char* CFileSystem::GetLastError() const
@@ -150,28 +271,46 @@ CFileSystem::FileBuffer CFileSystem::LoadFileToBuffer( const fs::path &path ) co
 		return {};
 	}
 
-	PHYSFS_file* f = PHYSFS_openRead( path.generic_string().c_str() );
-	if( nullptr == f )
+	SIndexEntry entry;
+	SMount mount;
+
+	if( !Lookup( path, entry, &mount ) || entry.isDirectory )
 	{
 		logWARNING( "file '{0}' couldn't be opened", path.generic_string() );
 		return {};
 	}
 
-	const auto length = PHYSFS_fileLength( f );
+	if( mount.pack )
+	{
+		const std::byte *data = entry.packEntry->data;
 
-	FileBuffer buffer( static_cast<size_t>( length ) );
+		return( FileBuffer( data, data + entry.packEntry->size ) );
+	}
 
-	const auto lengthRead = PHYSFS_readBytes( f, &buffer[ 0 ], length );
+	// files in plain directories are opened right where the index says they are
+	if( mount.isDirectory && NativePathPermitted( mount.realDir, path ) )
+	{
+		std::ifstream file( fs::path( mount.realDir ) / path, std::ios::binary | std::ios::ate );
 
-	if( lengthRead != length )
+		if( file )
+		{
+			FileBuffer buffer( static_cast<size_t>( file.tellg() ) );
+
+			file.seekg( 0 );
+
+			if( file.read( reinterpret_cast<char*>( buffer.data() ), static_cast<std::streamsize>( buffer.size() ) ) )
+			{
+				return( buffer );
+			}
+		}
+	}
+	else if( !mount.isDirectory && m_archiveCache.Enabled() )
 	{
-		logERROR( "couldn't read all of file '{0}' because of: {1}", path.generic_string(), PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) );
-		return {};
+		// copying the cached content is still a lot cheaper than inflating it again
+		return( *LoadArchiveFile( path ) );
 	}
 
-	PHYSFS_close( f );
-
-	return( buffer );
+	return( ReadThroughPhysFS( path ) );
 }
 
 bool CFileSystem::SaveBufferToFile( const FileBuffer &buffer, const fs::path &path ) const
@@ -194,6 +333,15 @@ bool CFileSystem::SaveBufferToFile( const FileBuffer &buffer, const fs::path &pa
 
 	PHYSFS_close( f );
 
+	{
+		const std::unique_lock<std::shared_mutex> lock( m_indexMutex );
+
+		// the write-dir comes first in the search path, so the written file always wins
+		IndexPath( IndexKey( path ) );
+	}
+
+	m_archiveCache.Erase( IndexKey( path ) );
+
 	if( lengthWrite != buffer.size() )
 	{
 		logERROR( "couldn't write all of file '{0}' because of: {1}", path.generic_string(), PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) );
@@ -203,6 +351,397 @@ bool CFileSystem::SaveBufferToFile( const FileBuffer &buffer, const fs::path &pa
 	return( true );
 }
 
+CFileView CFileSystem::MapFile( const fs::path &path ) const
+{
+	if( !path.has_filename() )
+	{
+		logWARNING( "path '{0}' contains no filename", path.generic_string() );
+		return {};
+	}
+
+	SIndexEntry entry;
+	SMount mount;
+
+	if( !Lookup( path, entry, &mount ) || entry.isDirectory )
+	{
+		logWARNING( "file '{0}' couldn't be found", path.generic_string() );
+		return {};
+	}
+
+	if( mount.pack )
+	{
+		return( mount.pack->View( *entry.packEntry ) );
+	}
+
+	// files inside of archives have to be read
+	if( mount.isDirectory && NativePathPermitted( mount.realDir, path ) )
+	{
+		CFileView view = CFileView::Map( fs::path( mount.realDir ) / path );
+
+		if( !view.Empty() )
+		{
+			return( view );
+		}
+	}
+	else if( !mount.isDirectory && m_archiveCache.Enabled() )
+	{
+		return( CFileView( LoadArchiveFile( path ) ) );
+	}
+
+	return( CFileView( LoadFileToBuffer( path ) ) );
+}
+
+CAsyncFileReader::THandle CFileSystem::AsyncRead( const fs::path &path, const CAsyncFileReader::EPriority priority, CAsyncFileReader::TCallback callback ) const
+{
+	return( m_asyncFileReader->Read( path, priority, std::move( callback ) ) );
+}
+
+void CFileSystem::CancelAsyncRead( const CAsyncFileReader::THandle &request ) const
+{
+	m_asyncFileReader->Cancel( request );
+}
+
+void CFileSystem::DeliverAsyncReads() const
+{
+	m_asyncFileReader->Deliver();
+}
+
+size_t CFileSystem::PendingAsyncReads() const
+{
+	return( m_asyncFileReader->PendingCount() );
+}
+
+void CFileSystem::RebuildIndex() const
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	const std::unique_lock<std::shared_mutex> lock( m_indexMutex );
+
+	m_mounts.clear();
+	m_index.clear();
+
+	// the archives may have changed as well
+	m_archiveCache.Clear();
+
+	char **searchPath = PHYSFS_getSearchPath();
+
+	for( char **mount = searchPath; nullptr != *mount; mount++ )
+	{
+		std::error_code error;
+
+		const bool isAsset = ( std::cend( m_assetPaths ) != std::find( std::cbegin( m_assetPaths ), std::cend( m_assetPaths ), *mount ) );
+
+		m_mounts.push_back( { *mount, fs::is_directory( *mount, error ), isAsset } );
+	}
+
+	PHYSFS_freeList( searchPath );
+
+	IndexDirectory( "" );
+
+	for( const auto &pack : m_packs )
+	{
+		IndexPack( pack );
+	}
+
+	logINFO( "indexed {0} paths in {1} mounts in {2:.2f} ms", m_index.size(), m_mounts.size(), std::chrono::duration<f32, std::milli>( std::chrono::steady_clock::now() - start ).count() );
+}
+
+void CFileSystem::WatchAssets() const
+{
+	std::vector<fs::path> directories;
+
+	for( const auto &assetPath : m_assetPaths )
+	{
+		std::error_code error;
+
+		// archives are not watched, their content can only change as a whole
+		if( fs::is_directory( assetPath, error ) )
+		{
+			directories.emplace_back( assetPath );
+		}
+	}
+
+	m_fileWatcher = std::make_unique<CFileWatcher>( directories );
+}
+
+std::vector<fs::path> CFileSystem::ChangedFiles() const
+{
+	if( !m_fileWatcher )
+	{
+		return {};
+	}
+
+	const auto changedFiles = m_fileWatcher->Changes();
+
+	if( !changedFiles.empty() )
+	{
+		const std::unique_lock<std::shared_mutex> lock( m_indexMutex );
+
+		for( const auto &changedFile : changedFiles )
+		{
+			// a new file may be in a new directory
+			for( fs::path path = IndexKey( changedFile ); !path.empty(); path = path.parent_path() )
+			{
+				IndexPath( path.generic_string() );
+			}
+		}
+	}
+
+	return( changedFiles );
+}
+
+void CFileSystem::SetArchiveCacheBudget( const u64 budget ) const
+{
+	m_archiveCache.SetBudget( budget );
+}
+
+void CFileSystem::PinCachedFile( const fs::path &path ) const
+{
+	m_archiveCache.Pin( IndexKey( path ) );
+}
+
+void CFileSystem::UnpinCachedFile( const fs::path &path ) const
+{
+	m_archiveCache.Unpin( IndexKey( path ) );
+}
+
+CFileCache::SStatistics CFileSystem::ArchiveCacheStatistics() const
+{
+	return( m_archiveCache.Statistics() );
+}
+
+void CFileSystem::LogArchiveCacheStatistics() const
+{
+	const auto statistics = m_archiveCache.Statistics();
+
+	if( 0 == statistics.budget )
+	{
+		logINFO( "archive cache : disabled" );
+		return;
+	}
+
+	logINFO( "archive cache : {0} files with {1:.1f} of {2:.1f} MiB / {3} hits / {4} misses / {5} evictions", statistics.entries, statistics.size / 1048576.0, statistics.budget / 1048576.0, statistics.hits, statistics.misses, statistics.evictions );
+}
+
+void CFileSystem::LogIndexStatistics() const
+{
+	const u64 lookups = m_indexLookups;
+
+	logINFO( "file index : {0} lookups in {1:.2f} ms ( {2:.0f} ns per lookup )", lookups, m_indexLookupNanoseconds / 1.0e6, ( lookups > 0 ) ? static_cast<f32>( m_indexLookupNanoseconds ) / lookups : 0.0 );
+}
+
+void CFileSystem::IndexPath( const std::string &path ) const
+{
+	PHYSFS_Stat stat;
+
+	const char *realDir = PHYSFS_getRealDir( path.c_str() );
+
+	if( ( nullptr == realDir ) || !PHYSFS_stat( path.c_str(), &stat ) )
+	{
+		m_index.erase( path );
+		return;
+	}
+
+	const auto mount = std::find_if( std::cbegin( m_mounts ), std::cend( m_mounts ), [ realDir ]( const SMount &mount ) { return( mount.realDir == realDir ); } );
+
+	if( std::cend( m_mounts ) == mount )
+	{
+		m_index.erase( path );
+		return;
+	}
+
+	m_index[ path ] = { static_cast<u16>( std::distance( std::cbegin( m_mounts ), mount ) ), ( stat.filetype == PHYSFS_FILETYPE_DIRECTORY ), static_cast<u64>( std::max( stat.filesize, static_cast<PHYSFS_sint64>( 0 ) ) ), stat.modtime };
+}
+
+void CFileSystem::IndexPack( const std::shared_ptr<const CAssetPack> &pack ) const
+{
+	const u16 mount = static_cast<u16>( m_mounts.size() );
+
+	m_mounts.push_back( { pack->NativePath().generic_string(), false, false, pack } );
+
+	u32 staleEntries { 0 };
+
+	for( const auto &packEntry : pack->Entries() )
+	{
+		const std::string key( packEntry.name );
+
+		if( const auto indexEntry = m_index.find( key ); std::cend( m_index ) != indexEntry )
+		{
+			// the write-dir is always the first mount, files written there win
+			if( 0 == indexEntry->second.mount )
+			{
+				continue;
+			}
+
+			// a file which was edited after the pack was cooked wins as well, otherwise a stale pack would hide every change
+			if( !indexEntry->second.isDirectory && ( nullptr == indexEntry->second.packEntry ) && ( indexEntry->second.modTime > packEntry.modTime ) )
+			{
+				logDEBUG( "'{0}' is newer than its entry in pack '{1}'", key, pack->NativePath().generic_string() );
+
+				staleEntries++;
+
+				continue;
+			}
+		}
+
+		m_index[ key ] = { mount, false, packEntry.size, packEntry.modTime, packEntry.kind, &packEntry };
+
+		// packs only contain files, so their directories have to be added
+		for( fs::path directory = fs::path( key ).parent_path(); !directory.empty(); directory = directory.parent_path() )
+		{
+			if( !m_index.try_emplace( directory.generic_string(), SIndexEntry { mount, true, 0, packEntry.modTime } ).second )
+			{
+				break;
+			}
+		}
+	}
+
+	if( staleEntries > 0 )
+	{
+		logWARNING( "{0} files are newer than their entries in pack '{1}', which should be cooked again", staleEntries, pack->NativePath().generic_string() );
+	}
+}
+
+void CFileSystem::IndexDirectory( const std::string &directory ) const
+{
+	char **entries = PHYSFS_enumerateFiles( directory.c_str() );
+
+	if( nullptr == entries )
+	{
+		logWARNING( "couldn't index the files in '{0}' because of: {1}", directory, PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) );
+		return;
+	}
+
+	for( char **entry = entries; nullptr != *entry; entry++ )
+	{
+		const std::string entryPath = directory.empty() ? std::string( *entry ) : ( directory + "/" + *entry );
+
+		IndexPath( entryPath );
+
+		const auto indexEntry = m_index.find( entryPath );
+
+		if( ( std::cend( m_index ) != indexEntry ) && indexEntry->second.isDirectory )
+		{
+			IndexDirectory( entryPath );
+		}
+	}
+
+	PHYSFS_freeList( entries );
+}
+
+CFileSystem::FileBuffer CFileSystem::ReadThroughPhysFS( const fs::path &path ) const
+{
+	PHYSFS_file* f = PHYSFS_openRead( path.generic_string().c_str() );
+	if( nullptr == f )
+	{
+		logWARNING( "file '{0}' couldn't be opened", path.generic_string() );
+		return {};
+	}
+
+	const auto length = PHYSFS_fileLength( f );
+
+	FileBuffer buffer( static_cast<size_t>( length ) );
+
+	const auto lengthRead = PHYSFS_readBytes( f, &buffer[ 0 ], length );
+
+	PHYSFS_close( f );
+
+	if( lengthRead != length )
+	{
+		logERROR( "couldn't read all of file '{0}' because of: {1}", path.generic_string(), PHYSFS_getErrorByCode( PHYSFS_getLastErrorCode() ) );
+		return {};
+	}
+
+	return( buffer );
+}
+
+std::shared_ptr<const CFileSystem::FileBuffer> CFileSystem::LoadArchiveFile( const fs::path &path ) const
+{
+	const std::string key = IndexKey( path );
+
+	if( auto content = m_archiveCache.Find( key ) )
+	{
+		return( content );
+	}
+
+	auto content = std::make_shared<const FileBuffer>( ReadThroughPhysFS( path ) );
+
+	if( !content->empty() )
+	{
+		m_archiveCache.Insert( key, content );
+	}
+
+	return( content );
+}
+
+bool CFileSystem::NativePathPermitted( const std::string &realDir, const fs::path &path )
+{
+	fs::path nativePath( realDir );
+
+	std::error_code error;
+
+	for( const auto &part : fs::path( IndexKey( path ) ) )
+	{
+		nativePath /= part;
+
+		if( fs::is_symlink( nativePath, error ) || error )
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+std::string CFileSystem::IndexKey( const fs::path &path )
+{
+	std::string key = path.generic_string();
+
+	const auto first = key.find_first_not_of( '/' );
+
+	if( std::string::npos == first )
+	{
+		return {};
+	}
+
+	key.erase( 0, first );
+	key.erase( key.find_last_not_of( '/' ) + 1 );
+
+	return( key );
+}
+
+bool CFileSystem::Lookup( const fs::path &path, SIndexEntry &entry, SMount *mount ) const
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	const std::string key = IndexKey( path );
+
+	bool found = false;
+
+	{
+		const std::shared_lock<std::shared_mutex> lock( m_indexMutex );
+
+		const auto indexEntry = m_index.find( key );
+
+		if( std::cend( m_index ) != indexEntry )
+		{
+			entry = indexEntry->second;
+
+			if( nullptr != mount )
+			{
+				*mount = m_mounts[ entry.mount ];
+			}
+
+			found = true;
+		}
+	}
+
+	m_indexLookups++;
+	m_indexLookupNanoseconds += static_cast<u64>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count() );
+
+	return( found );
+}
+
 std::string CFileSystem::LoadFileToString( const fs::path &path ) const
 {
 	if( !path.has_filename() )
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <filesystem>
 
@@ -8,6 +12,12 @@ namespace fs = std::filesystem;
 
 #include "src/core/Types.hpp"
 
+#include "src/system/CFileView.hpp"
+#include "src/system/CAsyncFileReader.hpp"
+#include "src/system/CFileCache.hpp"
+#include "src/system/CAssetPack.hpp"
+#include "src/system/CFileWatcher.hpp"
+
 class CFileSystem final
 {
 public :
@@ -28,16 +38,130 @@ public :
 
 	bool	MakeDir( const fs::path &path ) const;
 
+	// lists all files below the directory, including the ones in subdirectories
+	std::vector<fs::path>	ListFiles( const fs::path &directory ) const;
+
+	// all files in the asset directories and archives of the game, without the ones from packs or the write-dir
+	std::vector<fs::path>	ListAssetFiles() const;
+
+	// what the content of the file is, only files from asset packs are not RAW
+	AssetPack::EEntryKind	EntryKind( const fs::path &path ) const;
+
 	const char*	GetLastError() const;
 
 	using FileBuffer = std::vector<std::byte>;
 
 	[[nodiscard]] FileBuffer	LoadFileToBuffer( const fs::path &path ) const;
+
+	// maps files which are in plain directories and falls back to reading the others, the view is empty on failure
+	[[nodiscard]] CFileView		MapFile( const fs::path &path ) const;
+
 	[[nodiscard]] bool			SaveBufferToFile( const FileBuffer &buffer, const fs::path &path ) const;
 
 	[[nodiscard]] std::string	LoadFileToString( const fs::path &path ) const;
 
+	// reads the file on an I/O thread, the callback gets called on the main thread from DeliverAsyncReads
+	CAsyncFileReader::THandle	AsyncRead( const fs::path &path, const CAsyncFileReader::EPriority priority, CAsyncFileReader::TCallback callback ) const;
+	void						CancelAsyncRead( const CAsyncFileReader::THandle &request ) const;
+
+	// has to be called by the main thread
+	void						DeliverAsyncReads() const;
+
+	size_t						PendingAsyncReads() const;
+
+	// has to be called after files were changed outside of the file system
+	void	RebuildIndex() const;
+
+	// watches the asset directories for files which are changed outside of the file system
+	void	WatchAssets() const;
+
+	// the files which changed since the last call, they are already updated in the index, always empty without WatchAssets
+	[[nodiscard]] std::vector<fs::path>	ChangedFiles() const;
+
+	void	LogIndexStatistics() const;
+
+	// caches the inflated content of files in archives, 0 disables it
+	void	SetArchiveCacheBudget( const u64 budget ) const;
+
+	// pinned files stay in the archive cache regardless of the budget
+	void	PinCachedFile( const fs::path &path ) const;
+	void	UnpinCachedFile( const fs::path &path ) const;
+
+	CFileCache::SStatistics	ArchiveCacheStatistics() const;
+
+	void	LogArchiveCacheStatistics() const;
+
 private:
 	CFileSystem( const CFileSystem &rhs ) = delete;
 	CFileSystem& operator = ( const CFileSystem &rhs ) = delete;
+
+	// a directory or archive in the search path, or an asset pack
+	struct SMount final
+	{
+		std::string	realDir;
+		bool		isDirectory { false };
+		bool		isAsset { false };
+
+		std::shared_ptr<const CAssetPack> pack { nullptr };
+	};
+
+	// the file or directory which wins in the search path
+	struct SIndexEntry final
+	{
+		u16		mount;
+		bool	isDirectory;
+		u64		size;
+		s64		modTime;
+
+		AssetPack::EEntryKind kind { AssetPack::EEntryKind::RAW };
+
+		// stays valid as long as the pack is mounted
+		const CAssetPack::SEntry *packEntry { nullptr };
+	};
+
+	// the paths as they were mounted, to tell the asset mounts apart from the write-dir and the base dir
+	std::vector<std::string> m_assetPaths;
+
+	// packs are not handled by PhysicsFS, their entries win over everything but the write-dir
+	std::vector<std::shared_ptr<const CAssetPack>> m_packs;
+
+	/**
+	 * Every path of the search path, so lookups don't have to walk all the mounts through PhysicsFS.
+	 * It is built after mounting and updated by every write through the file system.
+	 */
+	mutable std::shared_mutex							m_indexMutex;
+	mutable std::vector<SMount>							m_mounts;
+	mutable std::unordered_map<std::string, SIndexEntry>	m_index;
+
+	mutable std::atomic<u64> m_indexLookups			{ 0 };
+	mutable std::atomic<u64> m_indexLookupNanoseconds	{ 0 };
+
+	// only call with the index locked exclusively
+	void IndexPath( const std::string &path ) const;
+	void IndexDirectory( const std::string &directory ) const;
+	void IndexPack( const std::shared_ptr<const CAssetPack> &pack ) const;
+
+	// the key of the path in the index, without leading or trailing slashes
+	static std::string IndexKey( const fs::path &path );
+
+	mutable CFileCache m_archiveCache;
+
+	mutable std::unique_ptr<CFileWatcher> m_fileWatcher;
+
+	FileBuffer ReadThroughPhysFS( const fs::path &path ) const;
+
+	// symbolic links are forbidden like in PhysicsFS, so no part of the path below the directory may be one
+	static bool NativePathPermitted( const std::string &realDir, const fs::path &path );
+
+	// from the archive cache or inflated and put into it
+	std::shared_ptr<const FileBuffer> LoadArchiveFile( const fs::path &path ) const;
+
+	// the mount is only copied if it is asked for
+	bool Lookup( const fs::path &path, SIndexEntry &entry, SMount *mount = nullptr ) const;
+
+	// reads are only a small part of loading, so a few threads keep the disk busy
+	static constexpr u8 AsyncReadThreadCount { 2 };
+
+	// created last and destroyed first, because its threads use PhysicsFS
+	std::unique_ptr<CAsyncFileReader> m_asyncFileReader;
 };
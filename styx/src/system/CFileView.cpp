@@ -0,0 +1,187 @@
+#include "CFileView.hpp"
+
+#include <utility>
+
+#ifdef WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <cerrno>
+#endif
+
+#include "src/logger/CLogger.hpp"
+
+CFileView::CFileView( FileBuffer buffer ) :
+	m_buffer { std::move( buffer ) }
+{
+	m_data = m_buffer.data();
+	m_size = m_buffer.size();
+}
+
+CFileView::CFileView( std::shared_ptr<const FileBuffer> sharedBuffer ) :
+	m_data { sharedBuffer->data() },
+	m_size { sharedBuffer->size() }
+{
+	m_owner = std::move( sharedBuffer );
+}
+
+CFileView::CFileView( std::shared_ptr<const void> owner, const std::byte *data, const size_t size ) :
+	m_owner { std::move( owner ) },
+	m_data { data },
+	m_size { size }
+{
+}
+
+CFileView::CFileView( CFileView &&rhs ) noexcept :
+	m_buffer { std::move( rhs.m_buffer ) },
+	m_owner { std::move( rhs.m_owner ) },
+	m_data { std::exchange( rhs.m_data, nullptr ) },
+	m_size { std::exchange( rhs.m_size, 0 ) },
+	m_mapped { std::exchange( rhs.m_mapped, false ) }
+{
+}
+
+CFileView& CFileView::operator = ( CFileView &&rhs ) noexcept
+{
+	if( this != &rhs )
+	{
+		Unmap();
+
+		m_buffer		= std::move( rhs.m_buffer );
+		m_owner			= std::move( rhs.m_owner );
+		m_data		= std::exchange( rhs.m_data, nullptr );
+		m_size		= std::exchange( rhs.m_size, 0 );
+		m_mapped	= std::exchange( rhs.m_mapped, false );
+	}
+
+	return( *this );
+}
+
+CFileView::~CFileView()
+{
+	Unmap();
+}
+
+CFileView CFileView::Map( const fs::path &nativePath )
+{
+	CFileView view;
+
+	#ifdef WIN32
+		const HANDLE file = CreateFileW( nativePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+		if( INVALID_HANDLE_VALUE == file )
+		{
+			logDEBUG( "'{0}' couldn't be opened for mapping: error code {1}", nativePath.generic_string(), GetLastError() );
+			return( view );
+		}
+
+		LARGE_INTEGER fileSize;
+
+		// empty files can't be mapped
+		if( !GetFileSizeEx( file, &fileSize ) || ( 0 == fileSize.QuadPart ) )
+		{
+			CloseHandle( file );
+			return( view );
+		}
+
+		const HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+		// the view keeps the mapping and the file alive on its own
+		CloseHandle( file );
+
+		if( nullptr == mapping )
+		{
+			logDEBUG( "'{0}' couldn't be mapped: error code {1}", nativePath.generic_string(), GetLastError() );
+			return( view );
+		}
+
+		const void *data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+
+		CloseHandle( mapping );
+
+		if( nullptr == data )
+		{
+			logDEBUG( "'{0}' couldn't be mapped: error code {1}", nativePath.generic_string(), GetLastError() );
+			return( view );
+		}
+
+		view.m_size = static_cast<size_t>( fileSize.QuadPart );
+	#else
+		const int file = open( nativePath.c_str(), O_RDONLY | O_CLOEXEC );
+
+		if( -1 == file )
+		{
+			logDEBUG( "'{0}' couldn't be opened for mapping: error code {1}", nativePath.generic_string(), errno );
+			return( view );
+		}
+
+		struct stat fileStat;
+
+		// empty files can't be mapped
+		if( ( -1 == fstat( file, &fileStat ) ) || ( 0 == fileStat.st_size ) )
+		{
+			close( file );
+			return( view );
+		}
+
+		void *data = mmap( nullptr, static_cast<size_t>( fileStat.st_size ), PROT_READ, MAP_PRIVATE, file, 0 );
+
+		// the mapping keeps the file alive on its own
+		close( file );
+
+		if( MAP_FAILED == data )
+		{
+			logDEBUG( "'{0}' couldn't be mapped: error code {1}", nativePath.generic_string(), errno );
+			return( view );
+		}
+
+		view.m_size = static_cast<size_t>( fileStat.st_size );
+	#endif
+
+	view.m_data		= static_cast<const std::byte*>( data );
+	view.m_mapped	= true;
+
+	return( view );
+}
+
+const std::byte *CFileView::Data() const
+{
+	return( m_data );
+}
+
+size_t CFileView::Size() const
+{
+	return( m_size );
+}
+
+bool CFileView::Empty() const
+{
+	return( 0 == m_size );
+}
+
+bool CFileView::IsMapped() const
+{
+	return( m_mapped );
+}
+
+void CFileView::Unmap()
+{
+	if( m_mapped )
+	{
+		#ifdef WIN32
+			UnmapViewOfFile( m_data );
+		#else
+			munmap( const_cast<std::byte*>( m_data ), m_size );
+		#endif
+
+		m_data		= nullptr;
+		m_size		= 0;
+		m_mapped	= false;
+	}
+}
\ No newline at end of file
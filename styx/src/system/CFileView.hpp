@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/**	Read only view of the whole content of a file.
+	Files in plain directories are mapped into memory, so decoders read straight from the page cache.
+	Everything else gets read into a buffer owned by the view.
+*/
+class CFileView final
+{
+public:
+	using FileBuffer = std::vector<std::byte>;
+
+	CFileView() = default;
+
+	explicit CFileView( FileBuffer buffer );
+
+	// shares a buffer which is owned by a cache
+	explicit CFileView( std::shared_ptr<const FileBuffer> sharedBuffer );
+
+	// memory which stays valid as long as the owner is alive
+	CFileView( std::shared_ptr<const void> owner, const std::byte *data, const size_t size );
+
+	CFileView( CFileView &&rhs ) noexcept;
+	CFileView& operator = ( CFileView &&rhs ) noexcept;
+
+	~CFileView();
+
+	// maps the file at the native path, the view is empty if that fails
+	[[nodiscard]] static CFileView Map( const fs::path &nativePath );
+
+	const std::byte *Data() const;
+	size_t Size() const;
+	bool Empty() const;
+
+	bool IsMapped() const;
+
+private:
+	CFileView( const CFileView &rhs ) = delete;
+	CFileView& operator = ( const CFileView &rhs ) = delete;
+
+	void Unmap();
+
+	FileBuffer					m_buffer;
+	std::shared_ptr<const void>	m_owner;
+
+	const std::byte	*m_data { nullptr };
+	size_t			m_size	{ 0 };
+
+	bool m_mapped { false };
+};
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "CFileWatcher.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+	#include <sys/inotify.h>
+	#include <unistd.h>
+	#include <cerrno>
+	#include <cstring>
+#endif
+
+#include "src/logger/CLogger.hpp"
+
+CFileWatcher::CFileWatcher( const std::vector<fs::path> &directories ) :
+	m_directories { directories }
+{
+	#ifdef __linux__
+		m_inotify = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+		if( -1 == m_inotify )
+		{
+			logWARNING( "inotify is not available because of: {0}, changes are polled instead", std::strerror( errno ) );
+		}
+		else
+		{
+			for( const auto &directory : m_directories )
+			{
+				Watch( directory, {} );
+			}
+
+			logINFO( "watching {0} directories for changes", m_watches.size() );
+
+			return;
+		}
+	#endif
+
+	m_modificationTimes = Scan();
+	m_lastPoll = std::chrono::steady_clock::now();
+
+	logINFO( "polling {0} files for changes", m_modificationTimes.size() );
+}
+
+CFileWatcher::~CFileWatcher()
+{
+	#ifdef __linux__
+		if( -1 != m_inotify )
+		{
+			close( m_inotify );
+		}
+	#endif
+}
+
+std::vector<fs::path> CFileWatcher::Changes()
+{
+	std::vector<fs::path> changes;
+
+	#ifdef __linux__
+		if( -1 != m_inotify )
+		{
+			changes = ReadEvents();
+		}
+		else
+	#endif
+	{
+		changes = Poll();
+	}
+
+	std::sort( std::begin( changes ), std::end( changes ) );
+	changes.erase( std::unique( std::begin( changes ), std::end( changes ) ), std::end( changes ) );
+
+	return( changes );
+}
+
+#ifdef __linux__
+void CFileWatcher::Watch( const fs::path &root, const fs::path &directory )
+{
+	const fs::path path = root / directory;
+
+	const int watch = inotify_add_watch( m_inotify, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CREATE | IN_ONLYDIR );
+
+	if( -1 == watch )
+	{
+		logWARNING( "couldn't watch '{0}' because of: {1}", path.generic_string(), std::strerror( errno ) );
+		return;
+	}
+
+	// a directory which is in more than one watched directory is reported relative to the first one
+	m_watches.emplace( watch, SWatch { root, directory } );
+
+	std::error_code error;
+
+	for( const auto &entry : fs::directory_iterator( path, error ) )
+	{
+		if( entry.is_directory( error ) )
+		{
+			Watch( root, directory / entry.path().filename() );
+		}
+	}
+}
+
+std::vector<fs::path> CFileWatcher::ReadEvents()
+{
+	std::vector<fs::path> changes;
+
+	alignas( inotify_event ) char buffer[ 4096 ];
+
+	for( ;; )
+	{
+		const ssize_t length = read( m_inotify, buffer, sizeof( buffer ) );
+
+		// EAGAIN, there are no more events queued
+		if( length <= 0 )
+		{
+			break;
+		}
+
+		for( ssize_t offset = 0; offset < length; )
+		{
+			const auto event = reinterpret_cast<const inotify_event*>( buffer + offset );
+
+			offset += sizeof( inotify_event ) + event->len;
+
+			if( event->mask & IN_IGNORED )
+			{
+				m_watches.erase( event->wd );
+				continue;
+			}
+
+			const auto watch = m_watches.find( event->wd );
+
+			if( ( std::end( m_watches ) == watch ) || ( 0 == event->len ) )
+			{
+				continue;
+			}
+
+			const fs::path path = watch->second.directory / event->name;
+
+			if( event->mask & IN_ISDIR )
+			{
+				if( event->mask & ( IN_CREATE | IN_MOVED_TO ) )
+				{
+					// watching it may rehash the watches, so the root is copied first
+					const fs::path root = watch->second.root;
+
+					Watch( root, path );
+
+					// files may have been written into it before it was watched
+					std::error_code error;
+
+					for( auto it = fs::recursive_directory_iterator( root / path, error ); !error && ( it != fs::recursive_directory_iterator() ); it.increment( error ) )
+					{
+						if( it->is_regular_file( error ) )
+						{
+							changes.push_back( fs::relative( it->path(), root, error ) );
+						}
+					}
+				}
+			}
+			// a file which was only created is reported once it was written
+			else if( !( event->mask & IN_CREATE ) )
+			{
+				changes.push_back( path );
+			}
+		}
+	}
+
+	return( changes );
+}
+#endif
+
+std::unordered_map<std::string, fs::file_time_type> CFileWatcher::Scan() const
+{
+	std::unordered_map<std::string, fs::file_time_type> modificationTimes;
+
+	for( const auto &directory : m_directories )
+	{
+		std::error_code error;
+
+		for( auto it = fs::recursive_directory_iterator( directory, error ); !error && ( it != fs::recursive_directory_iterator() ); it.increment( error ) )
+		{
+			if( it->is_regular_file( error ) )
+			{
+				// the first directory wins like in the search path
+				modificationTimes.emplace( fs::relative( it->path(), directory, error ).generic_string(), it->last_write_time( error ) );
+			}
+		}
+	}
+
+	return( modificationTimes );
+}
+
+std::vector<fs::path> CFileWatcher::Poll()
+{
+	std::vector<fs::path> changes;
+
+	if( ( std::chrono::steady_clock::now() - m_lastPoll ) < PollInterval )
+	{
+		return( changes );
+	}
+
+	auto modificationTimes = Scan();
+
+	for( const auto & [ path, modificationTime ] : modificationTimes )
+	{
+		const auto previous = m_modificationTimes.find( path );
+
+		if( ( std::end( m_modificationTimes ) == previous ) || ( previous->second != modificationTime ) )
+		{
+			changes.emplace_back( path );
+		}
+	}
+
+	for( const auto & [ path, modificationTime ] : m_modificationTimes )
+	{
+		if( std::end( modificationTimes ) == modificationTimes.find( path ) )
+		{
+			changes.emplace_back( path );
+		}
+	}
+
+	m_modificationTimes = std::move( modificationTimes );
+	m_lastPoll = std::chrono::steady_clock::now();
+
+	return( changes );
+}
\ No newline at end of file
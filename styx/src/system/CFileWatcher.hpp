@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+#include "src/core/Types.hpp"
+
+/**
+ * Tells which files below a few directories were changed on disk.
+ * On Linux inotify queues the changes, so nothing is looked at as long as nothing changes.
+ * Everywhere else, or if inotify is not available, the modification times are polled every PollInterval.
+ */
+class CFileWatcher final
+{
+public:
+	explicit CFileWatcher( const std::vector<fs::path> &directories );
+	~CFileWatcher();
+
+	// the files which were written, moved in or deleted since the last call, relative to their watched directory and without duplicates
+	[[nodiscard]] std::vector<fs::path> Changes();
+
+	static constexpr std::chrono::seconds PollInterval { 1 };
+
+private:
+	CFileWatcher( const CFileWatcher &rhs ) = delete;
+	CFileWatcher& operator = ( const CFileWatcher &rhs ) = delete;
+
+	const std::vector<fs::path> m_directories;
+
+	#ifdef __linux__
+		int m_inotify { -1 };
+
+		struct SWatch final
+		{
+			fs::path	root;
+			fs::path	directory;
+		};
+
+		// the directories by their watch descriptors, relative to the watched directory they are in
+		std::unordered_map<int, SWatch> m_watches;
+
+		void Watch( const fs::path &root, const fs::path &directory );
+
+		std::vector<fs::path> ReadEvents();
+	#endif
+
+	// the modification times of every file for the polling, keyed by the path relative to its watched directory
+	std::unordered_map<std::string, fs::file_time_type> m_modificationTimes;
+
+	std::chrono::steady_clock::time_point m_lastPoll;
+
+	std::unordered_map<std::string, fs::file_time_type> Scan() const;
+
+	std::vector<fs::path> Poll();
+};
\ No newline at end of file
@@ -136,6 +136,26 @@ CSettings::CSettings( const CFileSystem &p_filesystem, const std::string &settin
 				{
 					renderer.textures.anisotropic = anisotropic->get<u8>();
 				}
+
+				const auto upload_budget = textures_root->find( "upload_budget" );
+				if( textures_root->end() == upload_budget )
+				{
+					logWARNING( "'settings.renderer.textures.upload_budget' not found" );
+				}
+				else
+				{
+					renderer.textures.upload_budget = upload_budget->get<u32>();
+				}
+
+				const auto memory_budget = textures_root->find( "memory_budget" );
+				if( textures_root->end() == memory_budget )
+				{
+					logWARNING( "'settings.renderer.textures.memory_budget' not found" );
+				}
+				else
+				{
+					renderer.textures.memory_budget = memory_budget->get<u32>();
+				}
 			}
 
 			const auto screenshot_root = renderer_root->find( "screenshot" );
@@ -202,5 +222,41 @@ CSettings::CSettings( const CFileSystem &p_filesystem, const std::string &settin
 				input.controller_file = controller_file->get<std::string>();
 			}
 		}
+
+		const auto filesystem_root = settings_root.find( "filesystem" );
+		if( std::end( settings_root ) == filesystem_root )
+		{
+			logWARNING( "'settings.filesystem' not found" );
+		}
+		else
+		{
+			const auto archive_cache = filesystem_root->find( "archive_cache" );
+			if( filesystem_root->end() == archive_cache )
+			{
+				logWARNING( "'settings.filesystem.archive_cache' not found" );
+			}
+			else
+			{
+				filesystem.archive_cache = archive_cache->get<u32>();
+			}
+		}
+
+		const auto resources_root = settings_root.find( "resources" );
+		if( std::end( settings_root ) == resources_root )
+		{
+			logWARNING( "'settings.resources' not found" );
+		}
+		else
+		{
+			const auto cache_budget = resources_root->find( "cache_budget" );
+			if( resources_root->end() == cache_budget )
+			{
+				logWARNING( "'settings.resources.cache_budget' not found" );
+			}
+			else
+			{
+				resources.cache_budget = cache_budget->get<u32>();
+			}
+		}
 	}
 }
@@ -33,7 +33,11 @@ public:
 
 		struct s_Textures final
 		{
-			u8	anisotropic	{ 1 };
+			u8	anisotropic		{ 1 };
+			// in KiB which get uploaded per frame at most, while textures are streamed in
+			u32	upload_budget	{ 4096 };
+			// in MiB which streamed textures may occupy in video memory, 0 means unlimited
+			u32	memory_budget	{ 0 };
 		} textures;
 
 		struct s_Screenshot final
@@ -54,6 +58,18 @@ public:
 		std::string controller_file;
 	} input;
 
+	struct s_FileSystem final
+	{
+		// in MiB, 0 disables it
+		u32	archive_cache	{ 0 };
+	} filesystem;
+
+	struct s_Resources final
+	{
+		// in MiB of unused resources which every resource cache keeps, the least recently used ones are dropped first
+		u32	cache_budget	{ 64 };
+	} resources;
+
 private:
 	CSettings( const CSettings &rhs ) = delete;
 	CSettings& operator = ( const CSettings &rhs ) = delete;
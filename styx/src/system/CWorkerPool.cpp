@@ -0,0 +1,166 @@
+#include "CWorkerPool.hpp"
+
+#include <algorithm>
+
+#include "src/logger/CLogger.hpp"
+
+#include "src/system/ComputerInfo.hpp"
+
+CWorkerPool::CWorkerPool( const std::string &name, const u8 workerCount ) :
+	m_name { name }
+{
+	for( u8 i = 0; i < workerCount; i++ )
+	{
+		m_workers.emplace_back( &CWorkerPool::Work, this );
+	}
+
+	logINFO( "worker pool '{0}' was initialized with {1} workers", m_name, m_workers.size() );
+}
+
+CWorkerPool::~CWorkerPool()
+{
+	{
+		const std::lock_guard<std::mutex> lock( m_mutex );
+
+		if( !m_jobs.empty() )
+		{
+			logWARNING( "worker pool '{0}' drops {1} jobs", m_name, m_jobs.size() );
+			m_jobs.clear();
+		}
+
+		m_stopping = true;
+	}
+
+	m_condition.notify_all();
+
+	for( auto &worker : m_workers )
+	{
+		worker.join();
+	}
+
+	logINFO( "worker pool '{0}' is shutting down", m_name );
+}
+
+void CWorkerPool::Submit( TJob job )
+{
+	if( m_workers.empty() )
+	{
+		job();
+		return;
+	}
+
+	{
+		const std::lock_guard<std::mutex> lock( m_mutex );
+
+		m_jobs.push_back( std::move( job ) );
+	}
+
+	m_condition.notify_one();
+}
+
+void CWorkerPool::ParallelFor( const size_t count, const std::function<void( const size_t index )> &function )
+{
+	struct SState final
+	{
+		std::atomic<size_t> nextIndex { 0 };
+		std::atomic<size_t> doneCount { 0 };
+
+		std::mutex				mutex;
+		std::condition_variable	condition;
+
+		std::exception_ptr exception;
+	};
+
+	// helpers which only start after everything is done must still find their state
+	const auto state = std::make_shared<SState>();
+
+	// the function is only touched for claimed indices, which are all done before this returns
+	const auto work = [ state, count, &function ]
+	{
+		for( size_t index = state->nextIndex++; index < count; index = state->nextIndex++ )
+		{
+			try
+			{
+				function( index );
+			}
+			catch( ... )
+			{
+				const std::lock_guard<std::mutex> lock( state->mutex );
+
+				if( !state->exception )
+				{
+					state->exception = std::current_exception();
+				}
+			}
+
+			if( ++state->doneCount == count )
+			{
+				const std::lock_guard<std::mutex> lock( state->mutex );
+
+				state->condition.notify_all();
+			}
+		}
+	};
+
+	if( count > 1 )
+	{
+		const size_t helperCount = std::min( count - 1, m_workers.size() );
+
+		for( size_t i = 0; i < helperCount; i++ )
+		{
+			Submit( work );
+		}
+	}
+
+	work();
+
+	std::unique_lock<std::mutex> lock( state->mutex );
+
+	state->condition.wait( lock, [ &state, count ] { return( state->doneCount == count ); } );
+
+	if( state->exception )
+	{
+		std::rethrow_exception( state->exception );
+	}
+}
+
+u8 CWorkerPool::WorkerCount() const
+{
+	return( static_cast<u8>( m_workers.size() ) );
+}
+
+u8 CWorkerPool::DefaultWorkerCount()
+{
+	return( static_cast<u8>( std::clamp( ComputerInfo::ProcessorCount() - 1, 1, 8 ) ) );
+}
+
+void CWorkerPool::Work()
+{
+	while( true )
+	{
+		TJob job;
+
+		{
+			std::unique_lock<std::mutex> lock( m_mutex );
+
+			m_condition.wait( lock, [ this ] { return( m_stopping || !m_jobs.empty() ); } );
+
+			if( m_stopping )
+			{
+				return;
+			}
+
+			job = std::move( m_jobs.front() );
+			m_jobs.pop_front();
+		}
+
+		try
+		{
+			job();
+		}
+		catch( std::exception &e )
+		{
+			logERROR( "job in worker pool '{0}' failed: {1}", m_name, e.what() );
+		}
+	}
+}
\ No newline at end of file
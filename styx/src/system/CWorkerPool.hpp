@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/core/Types.hpp"
+
+/**
+ * Runs jobs on a fixed number of worker threads.
+ * Jobs must not touch the GL context, which is only current on the main thread.
+ */
+class CWorkerPool final
+{
+public:
+	using TJob = std::function<void()>;
+
+	CWorkerPool( const std::string &name, const u8 workerCount );
+	~CWorkerPool();
+
+	// without any workers the job runs right away on the calling thread
+	void Submit( TJob job );
+
+	/**
+	 * Calls the function for every index in [0, count) and returns when all of them are done.
+	 * The calling thread works on the indices too, so this can also be used from within a job.
+	 * The first exception thrown by the function gets rethrown.
+	 */
+	void ParallelFor( const size_t count, const std::function<void( const size_t index )> &function );
+
+	u8 WorkerCount() const;
+
+	// leaves one processor for the main thread
+	static u8 DefaultWorkerCount();
+
+private:
+	CWorkerPool( const CWorkerPool &rhs ) = delete;
+	CWorkerPool& operator = ( const CWorkerPool &rhs ) = delete;
+
+	void Work();
+
+	const std::string m_name;
+
+	std::mutex				m_mutex;
+	std::condition_variable	m_condition;
+
+	std::deque<TJob> m_jobs;
+
+	bool m_stopping { false };
+
+	std::vector<std::thread> m_workers;
+};
\ No newline at end of file
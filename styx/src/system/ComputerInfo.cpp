@@ -530,4 +530,9 @@ namespace ComputerInfo
 
 		return( String::trim( cpuFeatures ) );
 	}
+
+	bool HasSSE41()
+	{
+		return( SDL_HasSSE41() );
+	}
 }
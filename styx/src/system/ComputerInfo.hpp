@@ -11,4 +11,7 @@ namespace ComputerInfo
 	s32			ProcessorCount();
 	std::string	ProcessorInfo();
 	std::string	CPUFeatures();
+
+	// the image kernels pick their implementation with it
+	bool		HasSSE41();
 }
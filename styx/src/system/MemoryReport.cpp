@@ -0,0 +1,118 @@
+#include "MemoryReport.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "src/helper/Json.hpp"
+
+#include "src/logger/CLogger.hpp"
+
+namespace MemoryReport
+{
+	using json = nlohmann::json;
+
+	static json ToJson( const SMemoryUsage &memoryUsage )
+	{
+		return( json { { "cpu", memoryUsage.cpu }, { "gpu", memoryUsage.gpu }, { "total", memoryUsage.Total() } } );
+	}
+
+	bool Dump( const CFileSystem &filesystem, const CResources &resources, const CFontBuilder &fontBuilder, const fs::path &path )
+	{
+		if( !filesystem.Exists( path.parent_path() ) && !filesystem.MakeDir( path.parent_path() ) )
+		{
+			logWARNING( "couldn't create directory '{0}'", path.parent_path().generic_string() );
+			return( false );
+		}
+
+		struct SEntry final
+		{
+			const std::string	*cacheName;
+			CResourceCacheBase::SResourceMemoryUsage resource;
+		};
+
+		std::vector<SEntry> entries;
+
+		SMemoryUsage totalMemoryUsage;
+
+		json caches = json::array();
+
+		for( const auto &resourceCache : resources.Caches() )
+		{
+			SMemoryUsage cacheMemoryUsage;
+			SMemoryUsage unusedMemoryUsage;
+
+			auto resourceMemoryUsage = resourceCache->ResourceMemoryUsage();
+
+			for( auto &resource : resourceMemoryUsage )
+			{
+				cacheMemoryUsage += resource.memoryUsage;
+
+				if( resource.unused )
+				{
+					unusedMemoryUsage += resource.memoryUsage;
+				}
+
+				entries.push_back( { &resourceCache->Name(), std::move( resource ) } );
+			}
+
+			json cache = ToJson( cacheMemoryUsage );
+			cache[ "name" ]			= resourceCache->Name();
+			cache[ "resources" ]	= resourceMemoryUsage.size();
+			cache[ "unused" ]		= ToJson( unusedMemoryUsage );
+			cache[ "budget" ]		= resourceCache->Budget();
+
+			caches.push_back( std::move( cache ) );
+
+			totalMemoryUsage += cacheMemoryUsage;
+		}
+
+		json fonts = json::array();
+
+		for( const auto &font : fontBuilder.Fonts() )
+		{
+			const auto fontMemoryUsage = font->MemoryUsage();
+
+			json fontEntry = ToJson( fontMemoryUsage );
+			fontEntry[ "name" ] = font->Name;
+			fontEntry[ "size" ] = font->Size;
+
+			fonts.push_back( std::move( fontEntry ) );
+
+			totalMemoryUsage += fontMemoryUsage;
+		}
+
+		std::sort( std::begin( entries ), std::end( entries ), []( const SEntry &a, const SEntry &b ) { return( a.resource.memoryUsage.Total() > b.resource.memoryUsage.Total() ); } );
+
+		json resourceEntries = json::array();
+
+		for( const auto &entry : entries )
+		{
+			json resourceEntry = ToJson( entry.resource.memoryUsage );
+			resourceEntry[ "cache" ]	= *entry.cacheName;
+			resourceEntry[ "path" ]		= entry.resource.path;
+			resourceEntry[ "unused" ]	= entry.resource.unused;
+
+			resourceEntries.push_back( std::move( resourceEntry ) );
+		}
+
+		json root = json::object();
+		root[ "total" ]		= ToJson( totalMemoryUsage );
+		root[ "caches" ]	= std::move( caches );
+		root[ "fonts" ]		= std::move( fonts );
+		root[ "resources" ]	= std::move( resourceEntries );
+
+		const std::string text = root.dump( 4 );
+
+		const auto begin = reinterpret_cast<const std::byte*>( text.data() );
+
+		if( !filesystem.SaveBufferToFile( CFileSystem::FileBuffer( begin, begin + text.size() ), path ) )
+		{
+			logWARNING( "couldn't write memory report '{0}'", path.generic_string() );
+			return( false );
+		}
+
+		logINFO( "memory report '{0}': {1} KiB in main memory, {2} KiB in video and audio memory", path.generic_string(), totalMemoryUsage.cpu / 1024, totalMemoryUsage.gpu / 1024 );
+
+		return( true );
+	}
+}
\ No newline at end of file
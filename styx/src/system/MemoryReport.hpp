@@ -0,0 +1,13 @@
+#pragma once
+
+#include "src/system/CFileSystem.hpp"
+
+#include "src/resource/CResources.hpp"
+
+#include "src/renderer/font/CFontBuilder.hpp"
+
+namespace MemoryReport
+{
+	// writes the memory usage of every cache, font and resource as JSON, the resources sorted from the largest down, false if it couldn't be written
+	bool Dump( const CFileSystem &filesystem, const CResources &resources, const CFontBuilder &fontBuilder, const fs::path &path );
+}
\ No newline at end of file